@@ -1011,6 +1011,20 @@ struct PSI_statement_locker_state_v1
   uint m_schema_name_length;
   /** Statement character set number. */
   uint m_cs_number;
+  /** Metric, number of keys skipped by the storage engine. */
+  ulonglong m_keys_skipped;
+  /** Metric, number of deletes skipped by the storage engine. */
+  ulonglong m_deletes_skipped;
+  /** Metric, number of storage engine block cache hits. */
+  ulonglong m_block_cache_hits;
+  /** Metric, number of blocks read by the storage engine. */
+  ulonglong m_block_reads;
+  /** Metric, number of reads a bloom filter avoided. */
+  ulonglong m_bloom_filter_useful;
+  /** Metric, number of key comparisons by the storage engine. */
+  ulonglong m_key_comparisons;
+  /** Metric, number of bytes read by the storage engine. */
+  ulonglong m_bytes_read;
 };
 
 /**
@@ -1807,6 +1821,62 @@ typedef void (*set_statement_no_index_used_t)
 typedef void (*set_statement_no_good_index_used_t)
   (struct PSI_statement_locker *locker);
 
+/**
+  Increment a statement event "keys skipped" metric.
+  @param locker the statement locker
+  @param count the metric increment value
+*/
+typedef void (*inc_statement_keys_skipped_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+
+/**
+  Increment a statement event "deletes skipped" metric.
+  @param locker the statement locker
+  @param count the metric increment value
+*/
+typedef void (*inc_statement_deletes_skipped_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+
+/**
+  Increment a statement event "block cache hits" metric.
+  @param locker the statement locker
+  @param count the metric increment value
+*/
+typedef void (*inc_statement_block_cache_hits_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+
+/**
+  Increment a statement event "block reads" metric.
+  @param locker the statement locker
+  @param count the metric increment value
+*/
+typedef void (*inc_statement_block_reads_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+
+/**
+  Increment a statement event "bloom filter useful" metric.
+  @param locker the statement locker
+  @param count the metric increment value
+*/
+typedef void (*inc_statement_bloom_filter_useful_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+
+/**
+  Increment a statement event "key comparisons" metric.
+  @param locker the statement locker
+  @param count the metric increment value
+*/
+typedef void (*inc_statement_key_comparisons_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+
+/**
+  Increment a statement event "bytes read" metric.
+  @param locker the statement locker
+  @param count the metric increment value
+*/
+typedef void (*inc_statement_bytes_read_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+
 /**
   End a statement event.
   @param locker the statement locker
@@ -2095,6 +2165,20 @@ struct PSI_v1
   digest_end_v1_t digest_end;
   /** @sa set_thread_connect_attrs_v1_t. */
   set_thread_connect_attrs_v1_t set_thread_connect_attrs;
+  /** @sa inc_statement_keys_skipped. */
+  inc_statement_keys_skipped_t inc_statement_keys_skipped;
+  /** @sa inc_statement_deletes_skipped. */
+  inc_statement_deletes_skipped_t inc_statement_deletes_skipped;
+  /** @sa inc_statement_block_cache_hits. */
+  inc_statement_block_cache_hits_t inc_statement_block_cache_hits;
+  /** @sa inc_statement_block_reads. */
+  inc_statement_block_reads_t inc_statement_block_reads;
+  /** @sa inc_statement_bloom_filter_useful. */
+  inc_statement_bloom_filter_useful_t inc_statement_bloom_filter_useful;
+  /** @sa inc_statement_key_comparisons. */
+  inc_statement_key_comparisons_t inc_statement_key_comparisons;
+  /** @sa inc_statement_bytes_read. */
+  inc_statement_bytes_read_t inc_statement_bytes_read;
 };
 
 /** @} (end of group Group_PSI_v1) */
@@ -270,6 +270,13 @@ struct PSI_statement_locker_state_v1
   char m_schema_name[(64 * 3)];
   uint m_schema_name_length;
   uint m_cs_number;
+  ulonglong m_keys_skipped;
+  ulonglong m_deletes_skipped;
+  ulonglong m_block_cache_hits;
+  ulonglong m_block_reads;
+  ulonglong m_bloom_filter_useful;
+  ulonglong m_key_comparisons;
+  ulonglong m_bytes_read;
 };
 struct PSI_socket_locker_state_v1
 {
@@ -476,6 +483,20 @@ typedef void (*set_statement_no_index_used_t)
   (struct PSI_statement_locker *locker);
 typedef void (*set_statement_no_good_index_used_t)
   (struct PSI_statement_locker *locker);
+typedef void (*inc_statement_keys_skipped_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+typedef void (*inc_statement_deletes_skipped_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+typedef void (*inc_statement_block_cache_hits_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+typedef void (*inc_statement_block_reads_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+typedef void (*inc_statement_bloom_filter_useful_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+typedef void (*inc_statement_key_comparisons_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
+typedef void (*inc_statement_bytes_read_t)
+  (struct PSI_statement_locker *locker, ulonglong count);
 typedef void (*end_statement_v1_t)
   (struct PSI_statement_locker *locker, void *stmt_da);
 typedef struct PSI_socket_locker* (*start_socket_wait_v1_t)
@@ -599,6 +620,13 @@ struct PSI_v1
   digest_start_v1_t digest_start;
   digest_end_v1_t digest_end;
   set_thread_connect_attrs_v1_t set_thread_connect_attrs;
+  inc_statement_keys_skipped_t inc_statement_keys_skipped;
+  inc_statement_deletes_skipped_t inc_statement_deletes_skipped;
+  inc_statement_block_cache_hits_t inc_statement_block_cache_hits;
+  inc_statement_block_reads_t inc_statement_block_reads;
+  inc_statement_bloom_filter_useful_t inc_statement_bloom_filter_useful;
+  inc_statement_key_comparisons_t inc_statement_key_comparisons;
+  inc_statement_bytes_read_t inc_statement_bytes_read;
 };
 typedef struct PSI_v1 PSI;
 typedef struct PSI_mutex_info_v1 PSI_mutex_info;
@@ -4,6 +4,10 @@
   results["Rows_examined:"] = "uninit";
   results["RocksDB_key_skipped:"] = "uninit";
   results["RocksDB_del_skipped:"] = "uninit";
+  results["RocksDB_block_cache_hit:"] = "uninit";
+  results["RocksDB_bloom_filter_useful:"] = "uninit";
+  results["RocksDB_key_compared:"] = "uninit";
+  results["RocksDB_bytes_read:"] = "uninit";
 
   for (i = 2; i <= NF; i = i+2) {
     results[$i] = $(i+1);
@@ -13,7 +17,11 @@
   # error out.
   if (results["Rows_examined:"] == "uninit" ||
       results["RocksDB_key_skipped:"] == "uninit" ||
-      results["RocksDB_del_skipped:"] == "uninit") {
+      results["RocksDB_del_skipped:"] == "uninit" ||
+      results["RocksDB_block_cache_hit:"] == "uninit" ||
+      results["RocksDB_bloom_filter_useful:"] == "uninit" ||
+      results["RocksDB_key_compared:"] == "uninit" ||
+      results["RocksDB_bytes_read:"] == "uninit") {
     exit(-2);
   }
 
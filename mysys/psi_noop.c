@@ -581,6 +581,48 @@ static void set_statement_no_good_index_used_noop(PSI_statement_locker *locker N
   return;
 }
 
+static void inc_statement_keys_skipped_noop(PSI_statement_locker *locker NNN,
+                                            ulonglong count NNN)
+{
+  return;
+}
+
+static void inc_statement_deletes_skipped_noop(PSI_statement_locker *locker NNN,
+                                               ulonglong count NNN)
+{
+  return;
+}
+
+static void inc_statement_block_cache_hits_noop(PSI_statement_locker *locker NNN,
+                                                ulonglong count NNN)
+{
+  return;
+}
+
+static void inc_statement_block_reads_noop(PSI_statement_locker *locker NNN,
+                                           ulonglong count NNN)
+{
+  return;
+}
+
+static void inc_statement_bloom_filter_useful_noop(PSI_statement_locker *locker NNN,
+                                                   ulonglong count NNN)
+{
+  return;
+}
+
+static void inc_statement_key_comparisons_noop(PSI_statement_locker *locker NNN,
+                                               ulonglong count NNN)
+{
+  return;
+}
+
+static void inc_statement_bytes_read_noop(PSI_statement_locker *locker NNN,
+                                          ulonglong count NNN)
+{
+  return;
+}
+
 static void end_statement_noop(PSI_statement_locker *locker NNN,
                                void *stmt_da NNN)
 {
@@ -742,7 +784,14 @@ static PSI PSI_noop=
   set_socket_thread_owner_noop,
   digest_start_noop,
   digest_end_noop,
-  set_thread_connect_attrs_noop
+  set_thread_connect_attrs_noop,
+  inc_statement_keys_skipped_noop,
+  inc_statement_deletes_skipped_noop,
+  inc_statement_block_cache_hits_noop,
+  inc_statement_block_reads_noop,
+  inc_statement_bloom_filter_useful_noop,
+  inc_statement_key_comparisons_noop,
+  inc_statement_bytes_read_noop
 };
 
 /**
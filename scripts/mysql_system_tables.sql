@@ -1287,7 +1287,14 @@ SET @cmd="CREATE TABLE performance_schema.events_statements_current("
   "NO_INDEX_USED BIGINT unsigned not null,"
   "NO_GOOD_INDEX_USED BIGINT unsigned not null,"
   "NESTING_EVENT_ID BIGINT unsigned,"
-  "NESTING_EVENT_TYPE ENUM('STATEMENT', 'STAGE', 'WAIT')"
+  "NESTING_EVENT_TYPE ENUM('STATEMENT', 'STAGE', 'WAIT'),"
+  "KEYS_SKIPPED BIGINT unsigned not null,"
+  "DELETES_SKIPPED BIGINT unsigned not null,"
+  "BLOCK_CACHE_HITS BIGINT unsigned not null,"
+  "BLOCK_READS BIGINT unsigned not null,"
+  "BLOOM_FILTER_USEFUL BIGINT unsigned not null,"
+  "KEY_COMPARISONS BIGINT unsigned not null,"
+  "BYTES_READ BIGINT unsigned not null"
   ")ENGINE=PERFORMANCE_SCHEMA;";
 
 SET @str = IF(@have_pfs = 1, @cmd, 'SET @dummy = 0');
@@ -1339,7 +1346,14 @@ SET @cmd="CREATE TABLE performance_schema.events_statements_history("
   "NO_INDEX_USED BIGINT unsigned not null,"
   "NO_GOOD_INDEX_USED BIGINT unsigned not null,"
   "NESTING_EVENT_ID BIGINT unsigned,"
-  "NESTING_EVENT_TYPE ENUM('STATEMENT', 'STAGE', 'WAIT')"
+  "NESTING_EVENT_TYPE ENUM('STATEMENT', 'STAGE', 'WAIT'),"
+  "KEYS_SKIPPED BIGINT unsigned not null,"
+  "DELETES_SKIPPED BIGINT unsigned not null,"
+  "BLOCK_CACHE_HITS BIGINT unsigned not null,"
+  "BLOCK_READS BIGINT unsigned not null,"
+  "BLOOM_FILTER_USEFUL BIGINT unsigned not null,"
+  "KEY_COMPARISONS BIGINT unsigned not null,"
+  "BYTES_READ BIGINT unsigned not null"
   ")ENGINE=PERFORMANCE_SCHEMA;";
 
 SET @str = IF(@have_pfs = 1, @cmd, 'SET @dummy = 0');
@@ -1391,7 +1405,14 @@ SET @cmd="CREATE TABLE performance_schema.events_statements_history_long("
   "NO_INDEX_USED BIGINT unsigned not null,"
   "NO_GOOD_INDEX_USED BIGINT unsigned not null,"
   "NESTING_EVENT_ID BIGINT unsigned,"
-  "NESTING_EVENT_TYPE ENUM('STATEMENT', 'STAGE', 'WAIT')"
+  "NESTING_EVENT_TYPE ENUM('STATEMENT', 'STAGE', 'WAIT'),"
+  "KEYS_SKIPPED BIGINT unsigned not null,"
+  "DELETES_SKIPPED BIGINT unsigned not null,"
+  "BLOCK_CACHE_HITS BIGINT unsigned not null,"
+  "BLOCK_READS BIGINT unsigned not null,"
+  "BLOOM_FILTER_USEFUL BIGINT unsigned not null,"
+  "KEY_COMPARISONS BIGINT unsigned not null,"
+  "BYTES_READ BIGINT unsigned not null"
   ")ENGINE=PERFORMANCE_SCHEMA;";
 
 SET @str = IF(@have_pfs = 1, @cmd, 'SET @dummy = 0');
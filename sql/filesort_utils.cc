@@ -17,11 +17,17 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include "mysql/psi/mysql_thread.h"
+#include "my_atomic.h"
 
 #include <algorithm>
 #include <functional>
 #include <vector>
 
+#ifdef HAVE_PSI_INTERFACE
+PSI_thread_key key_thread_filesort;
+#endif
+
 namespace {
 /**
   A local helper function. See comments for get_merge_buffers_cost().
@@ -183,24 +189,107 @@ size_t try_reserve(std::pair<type*, ptrdiff_t> *buf, ptrdiff_t size)
   return buf->second;
 }
 
-} // namespace
-
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/// Like Mem_compare, for keys known to be equal up to byte 'from'.
+class Mem_compare_from :
+  public std::binary_function<const uchar*, const uchar*, bool>
 {
-  if (count <= 1)
-    return;
-  if (param->sort_length == 0)
-    return;
+public:
+  Mem_compare_from(size_t from, size_t n) : m_from(from), m_size(n - from) {}
+  bool operator()(const uchar *s1, const uchar *s2) const
+  {
+    return my_mem_compare(s1 + m_from, s2 + m_from, m_size);
+  }
+private:
+  size_t m_from;
+  size_t m_size;
+};
 
-  uchar **keys= get_sort_keys();
-  std::pair<uchar**, ptrdiff_t> buffer;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      try_reserve(&buffer, count))
+/// Buckets smaller than this are sorted by comparing their keys.
+const uint MSD_RADIX_MIN_KEYS= 64;
+/// Deepest recursion of msd_radix_sort(), to bound the stack it uses.
+const uint MSD_RADIX_MAX_LEVELS= 16;
+/**
+  Shortest keys that msd_radix_sort() is used for. Shorter keys cost
+  little to memcmp(), and are left to std::stable_sort.
+*/
+const size_t MSD_RADIX_MIN_SORT_LENGTH= 64;
+
+/**
+  Most significant byte first radix sort, stable.
+  The keys are distributed into 256 buckets on the byte at 'depth', and
+  each bucket is sorted on the following bytes. Bytes that all the keys
+  share are skipped in one pass, so long keys with a common prefix, or
+  padded with spaces, cost no more than short ones.
+
+  @param keys     Keys that are equal up to byte 'depth'.
+  @param scratch  Space for count key pointers.
+  @param level    Recursion depth.
+*/
+void msd_radix_sort(uchar **keys, uchar **scratch, uint count, size_t depth,
+                    size_t sort_length, uint level)
+{
+  for (; depth < sort_length; depth++)
   {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer.first);
-    std::return_temporary_buffer(buffer.first);
+    if (count < MSD_RADIX_MIN_KEYS || level == MSD_RADIX_MAX_LEVELS)
+    {
+      std::stable_sort(keys, keys + count,
+                       Mem_compare_from(depth, sort_length));
+      return;
+    }
+
+    uint bucket[256];
+    memset(bucket, 0, sizeof(bucket));
+    for (uint ix= 0; ix < count; ++ix)
+      bucket[keys[ix][depth]]++;
+
+    if (bucket[keys[0][depth]] == count)
+    {
+      // All keys have this byte: skip their whole common prefix.
+      size_t prefix= sort_length;
+      for (uint ix= 1; ix < count && prefix > depth + 1; ++ix)
+      {
+        size_t same= depth + 1;
+        while (same < prefix && keys[ix][same] == keys[0][same])
+          same++;
+        prefix= same;
+      }
+      depth= prefix - 1;
+      continue;
+    }
+
+    uint start= 0;
+    for (uint ix= 0; ix < 256; ++ix)
+    {
+      const uint size= bucket[ix];
+      bucket[ix]= start;
+      start+= size;
+    }
+    for (uint ix= 0; ix < count; ++ix)
+      scratch[bucket[keys[ix][depth]]++]= keys[ix];
+    memcpy(keys, scratch, count * sizeof(uchar*));
+
+    // bucket[ix] is now the end of bucket ix.
+    start= 0;
+    for (uint ix= 0; ix < 256; ++ix)
+    {
+      const uint size= bucket[ix] - start;
+      if (size > 1)
+        msd_radix_sort(keys + start, scratch + start, size, depth + 1,
+                       sort_length, level + 1);
+      start= bucket[ix];
+    }
     return;
   }
+}
+
+/**
+  Sorts the keys in the calling thread.
+
+  @param scratch  Space for count key pointers for the radix sorts, or NULL
+                  to allocate it when needed.
+*/
+void sort_keys(uchar **keys, uint count, size_t sort_length, uchar **scratch)
+{
   /*
     std::stable_sort has some extra overhead in allocating the temp buffer,
     which takes some time. The cutover point where it starts to get faster
@@ -209,9 +298,214 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   */
   if (count < 100)
   {
-    size_t size= param->sort_length;
+    size_t size= sort_length;
     my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
     return;
   }
-  std::stable_sort(keys, keys + count, Mem_compare(param->sort_length));
+
+  const bool lsd_radix= radixsort_is_appliccable(count, sort_length);
+  if (!lsd_radix && sort_length < MSD_RADIX_MIN_SORT_LENGTH)
+  {
+    std::stable_sort(keys, keys + count, Mem_compare(sort_length));
+    return;
+  }
+
+  std::pair<uchar**, ptrdiff_t> buffer(NULL, 0);
+  if (scratch == NULL && try_reserve(&buffer, count))
+    scratch= buffer.first;
+
+  if (scratch == NULL)
+    std::stable_sort(keys, keys + count, Mem_compare(sort_length));
+  else if (lsd_radix)
+    radixsort_for_str_ptr(keys, count, sort_length, scratch);
+  else
+    msd_radix_sort(keys, scratch, count, 0, sort_length, 0);
+
+  if (buffer.first != NULL)
+    std::return_temporary_buffer(buffer.first);
+}
+
+
+/**
+  Fewest keys worth giving a thread of their own: below this, starting the
+  thread costs about as much as sorting the keys.
+*/
+const uint MIN_KEYS_PER_SORT_THREAD= 10000;
+
+/**
+  Worker threads reserved by the parallel sorts of the whole server.
+  filesort_threads is a session variable, so this keeps concurrent sorts
+  from starting more than MAX_FILESORT_THREADS threads between them.
+*/
+volatile int32 sort_worker_threads= 0;
+
+
+/**
+  Reserves worker threads for a parallel sort.
+
+  @return Number of threads reserved, at most wanted. 0 if the server
+          already runs MAX_FILESORT_THREADS workers.
+*/
+uint reserve_sort_threads(uint wanted)
+{
+  int32 running= my_atomic_load32(&sort_worker_threads);
+  for (;;)
+  {
+    const int32 granted=
+      std::min<int32>(wanted, MAX_FILESORT_THREADS - running);
+    if (granted <= 0)
+      return 0;
+    if (my_atomic_cas32(&sort_worker_threads, &running, running + granted))
+      return granted;
+  }
+}
+
+
+void release_sort_threads(uint count)
+{
+  my_atomic_add32(&sort_worker_threads, -static_cast<int32>(count));
+}
+
+
+/**
+  One step of a parallel sort: sorts one chunk of the buffer, or merges
+  two adjacent sorted runs.
+*/
+struct Sort_task
+{
+  uchar **from;        ///< Keys to sort, or the first of the runs to merge.
+  uchar **to;          ///< Where merged runs go, or scratch for sorting.
+  uint count;          ///< Number of keys in total.
+  uint first_count;    ///< Keys in the first run, 0 to sort from[].
+  size_t sort_length;
+  pthread_t thread;
+  bool in_thread;
+};
+
+
+void run_sort_task(Sort_task *task)
+{
+  if (task->first_count == 0)
+  {
+    sort_keys(task->from, task->count, task->sort_length, task->to);
+    return;
+  }
+  uchar **const second= task->from + task->first_count;
+  std::merge(task->from, second, second, task->from + task->count,
+             task->to, Mem_compare(task->sort_length));
+}
+
+
+extern "C" void *sort_task_thread(void *arg)
+{
+  my_thread_init();
+  run_sort_task(static_cast<Sort_task*>(arg));
+  my_thread_end();
+  return NULL;
+}
+
+
+/**
+  Runs the tasks, all but the first one in threads of their own.
+  A task whose thread can't be created is run by the calling thread.
+*/
+void run_sort_tasks(Sort_task *tasks, uint n_tasks)
+{
+  for (uint ix= 1; ix < n_tasks; ++ix)
+    tasks[ix].in_thread=
+      mysql_thread_create(key_thread_filesort, &tasks[ix].thread, NULL,
+                          sort_task_thread, &tasks[ix]) == 0;
+  run_sort_task(&tasks[0]);
+  for (uint ix= 1; ix < n_tasks; ++ix)
+  {
+    if (tasks[ix].in_thread)
+      pthread_join(tasks[ix].thread, NULL);
+    else
+      run_sort_task(&tasks[ix]);
+  }
+}
+
+
+/**
+  Sorts n_chunks chunks of the keys in parallel, and then merges the
+  sorted runs pairwise, each merge of a round in a thread of its own.
+  The runs move between keys[] and buffer[] every round.
+
+  @param buffer  Space for count key pointers.
+*/
+void parallel_sort(uchar **keys, uint count, size_t sort_length,
+                   uint n_chunks, uchar **buffer)
+{
+  DBUG_ASSERT(n_chunks > 1 && n_chunks <= MAX_FILESORT_THREADS);
+  Sort_task tasks[MAX_FILESORT_THREADS];
+  uint run_start[MAX_FILESORT_THREADS];
+  uint run_count[MAX_FILESORT_THREADS];
+
+  const uint chunk_size= count / n_chunks;
+  for (uint ix= 0; ix < n_chunks; ++ix)
+  {
+    run_start[ix]= ix * chunk_size;
+    run_count[ix]= ix + 1 < n_chunks ? chunk_size : count - run_start[ix];
+    tasks[ix].from= keys + run_start[ix];
+    tasks[ix].to= buffer + run_start[ix];
+    tasks[ix].count= run_count[ix];
+    tasks[ix].first_count= 0;
+    tasks[ix].sort_length= sort_length;
+  }
+  run_sort_tasks(tasks, n_chunks);
+
+  uchar **from= keys;
+  uchar **to= buffer;
+  uint n_runs= n_chunks;
+  while (n_runs > 1)
+  {
+    uint n_tasks= 0;
+    for (uint ix= 0; ix < n_runs; ix+= 2)
+    {
+      // An odd run out is "merged" with an empty one, i.e. copied.
+      const uint first_count= run_count[ix];
+      const uint second_count= ix + 1 < n_runs ? run_count[ix + 1] : 0;
+      Sort_task *const task= &tasks[n_tasks];
+      task->from= from + run_start[ix];
+      task->to= to + run_start[ix];
+      task->count= first_count + second_count;
+      task->first_count= first_count;
+      run_start[n_tasks]= run_start[ix];
+      run_count[n_tasks]= task->count;
+      n_tasks++;
+    }
+    run_sort_tasks(tasks, n_tasks);
+    n_runs= n_tasks;
+    std::swap(from, to);
+  }
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+}
+
+} // namespace
+
+void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+{
+  if (count <= 1)
+    return;
+  if (param->sort_length == 0)
+    return;
+
+  uchar **keys= get_sort_keys();
+  const uint n_chunks=
+    std::min<uint>(param->sort_threads, count / MIN_KEYS_PER_SORT_THREAD);
+  // The calling thread sorts one chunk, the workers the others.
+  const uint n_workers= n_chunks > 1 ? reserve_sort_threads(n_chunks - 1) : 0;
+  std::pair<uchar**, ptrdiff_t> buffer;
+  if (n_workers > 0 && try_reserve(&buffer, count))
+  {
+    parallel_sort(keys, count, param->sort_length, n_workers + 1,
+                  buffer.first);
+    std::return_temporary_buffer(buffer.first);
+    release_sort_threads(n_workers);
+    return;
+  }
+  if (n_workers > 0)
+    release_sort_threads(n_workers);
+  sort_keys(keys, count, param->sort_length, NULL);
 }
@@ -19,10 +19,15 @@
 #include "my_global.h"
 #include "my_base.h"
 #include "sql_array.h"
+#include "mysql/psi/psi.h"
 
 #include <utility>
 
 class Sort_param;
+
+#ifdef HAVE_PSI_INTERFACE
+extern PSI_thread_key key_thread_filesort;
+#endif
 /*
   Calculate cost of merge sort
 
@@ -66,7 +71,13 @@ public:
     m_idx_array(), m_record_length(0), m_start_of_data(NULL)
   {}
 
-  /** Sort me... */
+  /**
+    Sort me...
+    With param->sort_threads > 1, large buffers are cut into that many
+    chunks, which are sorted by worker threads and then merged. The
+    workers of all sorts in the server are limited to
+    MAX_FILESORT_THREADS; a sort that gets none is done serially.
+  */
   void sort_buffer(const Sort_param *param, uint count);
 
   /// Initializes a record pointer.
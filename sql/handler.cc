@@ -2759,6 +2759,7 @@ void ha_statistics::reset_table_stats()
   rows_read = rows_requested = index_inserts = 0;
   rows_index_first = rows_index_next = 0;
   key_skipped = delete_skipped = 0;
+  block_cache_hit = bloom_filter_useful = key_compared = bytes_read = 0;
   table_io_perf_read.init();
   table_io_perf_write.init();
   table_io_perf_read_blob.init();
@@ -2772,6 +2773,8 @@ bool ha_statistics::has_table_stats()
   return (rows_read || rows_requested || index_inserts ||
           rows_inserted || rows_updated || rows_deleted ||
           key_skipped || delete_skipped ||
+          block_cache_hit || bloom_filter_useful ||
+          key_compared || bytes_read ||
           table_io_perf_read.requests ||
           table_io_perf_write.requests ||
           table_io_perf_read_blob.requests ||
@@ -6597,6 +6600,7 @@ int DsMrr_impl::dsmrr_fill_buffer()
             (void*)h);
   rowids_buf_last= rowids_buf_cur;
   rowids_buf_cur=  rowids_buf;
+  h->multi_range_read_rowids(rowids_buf, n_rowids, elem_size);
   DBUG_RETURN(0);
 }
 
@@ -7420,8 +7424,7 @@ void handler::update_global_table_stats(THD *thd)
     thd->rows_index_first += stats.rows_index_first;
     thd->rows_index_next += stats.rows_index_next;
 
-    thd->status_var.ha_key_skipped_count += stats.key_skipped;
-    thd->status_var.ha_delete_skipped_count += stats.delete_skipped;
+    thd->inc_status_engine_stats(stats);
   }
 
   stats.reset_table_stats();
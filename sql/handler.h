@@ -1813,13 +1813,18 @@ public:
 
   ulonglong key_skipped;            /* keys skipped during scan */
   ulonglong delete_skipped;         /* tombstones skipped during scan */
+  ulonglong block_cache_hit;        /* blocks found in the block cache */
+  ulonglong bloom_filter_useful;    /* reads avoided by a bloom filter */
+  ulonglong key_compared;           /* keys compared during reads */
+  ulonglong bytes_read;             /* bytes of keys and values read */
 
   ha_statistics():
     data_file_length(0), max_data_file_length(0),
     index_file_length(0), delete_length(0), auto_increment_value(0),
     records(0), deleted(0), mean_rec_length(0), create_time(0),
     check_time(0), update_time(0), block_size(0), key_skipped(0),
-    delete_skipped(0)
+    delete_skipped(0), block_cache_hit(0), bloom_filter_useful(0),
+    key_compared(0), bytes_read(0)
   {
     reset_table_stats();
   }
@@ -2301,6 +2306,18 @@ public:
                                     uint n_ranges, uint mode,
                                     HANDLER_BUFFER *buf);
   virtual int multi_range_read_next(char **range_info);
+  /**
+    Called by DS-MRR each time it has collected and sorted a buffer of
+    rowids, before it reads the rows with rnd_pos() in buffer order. The
+    rowids passed to rnd_pos() point into this buffer, which lets an engine
+    read the rows in batches instead of one at a time.
+
+    @param rowids     First rowid in the buffer
+    @param n_rowids   Number of rowids in the buffer
+    @param elem_size  Distance in bytes between two rowids in the buffer
+  */
+  virtual void multi_range_read_rowids(uchar *rowids, uint n_rowids,
+                                       uint elem_size) {}
 
 
   virtual const key_map *keys_to_use_for_scanning() { return &key_map_empty; }
@@ -965,6 +965,33 @@ public:
       If value is not null null_value flag will be reset to FALSE.
   */
   virtual longlong val_int()=0;
+  /**
+    Prepare the evaluation of this item as a condition on batches of rows
+    of a table with val_int_batch(). The constant arguments of the item
+    are evaluated here, once for all the rows of the batches.
+
+    @param table  table the rows of the batches are read from
+
+    @return true if the item can be evaluated with val_int_batch()
+  */
+  virtual bool prepare_batch(TABLE *table) { return false; }
+  /**
+    Evaluate this item as a condition on some rows of a batch. Only called
+    after prepare_batch() returned true for the table of the rows.
+
+    @param rows        images of the rows of the table in record[0] format
+    @param row_length  length of one row image
+    @param selection   indexes of the rows to evaluate the item on, in
+                       increasing order. The indexes of the rows for which
+                       the item is true, not false or NULL, are moved to
+                       the front, in the same order.
+    @param count       number of indexes in selection, at most MAX_ROW_BATCH
+
+    @return number of rows for which the item is true
+  */
+  virtual uint val_int_batch(const uchar *rows, size_t row_length,
+                             uint *selection, uint count)
+  { DBUG_ASSERT(0); return count; }
   /**
     Return date value of item in packed longlong format.
   */
@@ -1605,6 +1605,48 @@ int Arg_comparator::compare_datetime()
 }
 
 
+/**
+  Get the value of the constant argument of an integer or DATE/DATETIME
+  comparison, for the evaluation of the comparison on batches of rows.
+
+  @param const_is_a        true if 'a' is the constant argument, false if 'b'
+  @param[out] value        the value compare() compares with
+  @param[out] is_null      true if the constant argument is NULL
+  @param[out] is_temporal  true if the arguments are compared as packed
+                           DATETIME values, false if as signed integers
+
+  @return false if the arguments are not compared as either
+*/
+
+bool Arg_comparator::get_batch_value(bool const_is_a, longlong *value,
+                                     bool *is_null, bool *is_temporal)
+{
+  if (func == &Arg_comparator::compare_datetime)
+  {
+    /* The other argument has to be read as a DATE/DATETIME value as well */
+    if ((const_is_a ? get_value_b_func : get_value_a_func) !=
+        &get_datetime_value)
+      return false;
+    *is_temporal= true;
+    *value= const_is_a ?
+            (*get_value_a_func)(thd, &a, &a_cache, *b, is_null) :
+            (*get_value_b_func)(thd, &b, &b_cache, *a, is_null);
+    return true;
+  }
+  if (func != &Arg_comparator::compare_int_signed &&
+      func != &Arg_comparator::compare_int_signed_unsigned &&
+      func != &Arg_comparator::compare_int_unsigned_signed &&
+      func != &Arg_comparator::compare_int_unsigned)
+    return false;
+  Item *const item= const_is_a ? *a : *b;
+  *is_temporal= false;
+  *value= item->val_int();
+  *is_null= item->null_value;
+  /* An unsigned value above LONGLONG_MAX can't be compared as signed */
+  return *is_null || !item->unsigned_flag || *value >= 0;
+}
+
+
 int Arg_comparator::compare_string()
 {
   String *res1,*res2;
@@ -3074,6 +3116,42 @@ longlong Item_func_between::val_int()
 }
 
 
+bool Item_func_between::prepare_batch(TABLE *table)
+{
+  if (cmp_type != INT_RESULT || compare_as_temporal_times ||
+      !args[1]->const_item() || args[1]->is_expensive() ||
+      !args[2]->const_item() || args[2]->is_expensive() ||
+      !batch_filter.set_column(table, args[0], compare_as_temporal_dates))
+    return false;
+
+  longlong low, high;
+  if (compare_as_temporal_dates)
+  {
+    low= args[1]->val_date_temporal();
+    high= args[2]->val_date_temporal();
+  }
+  else
+  {
+    low= args[1]->val_int();
+    high= args[2]->val_int();
+    /* An unsigned value above LONGLONG_MAX can't be compared as signed */
+    if ((args[1]->unsigned_flag && low < 0) ||
+        (args[2]->unsigned_flag && high < 0))
+      return false;
+  }
+  if (args[1]->null_value || args[2]->null_value)
+  {
+    /* NOT BETWEEN is true for the values outside of the non-NULL bound */
+    if (negated)
+      return false;
+    low= 1;                                     // Never true
+    high= 0;
+  }
+  batch_filter.set_range(low, high, negated);
+  return true;
+}
+
+
 void Item_func_between::print(String *str, enum_query_type query_type)
 {
   str->append('(');
@@ -4319,6 +4397,227 @@ uchar *in_longlong::get_value(Item *item)
   return (uchar*) &tmp;
 }
 
+bool in_longlong::has_big_unsigned_value() const
+{
+  const packed_longlong *const values= (packed_longlong *) base;
+  for (uint i= 0; i < used_count; i++)
+    if (values[i].unsigned_flag && values[i].val < 0)
+      return true;
+  return false;
+}
+
+
+bool in_longlong::find_signed(longlong value) const
+{
+  const packed_longlong *const values= (packed_longlong *) base;
+  uint start= 0, end= used_count;
+  while (start < end)
+  {
+    const uint mid= (start + end) / 2;
+    if (values[mid].val < value)
+      start= mid + 1;
+    else
+      end= mid;
+  }
+  return start < used_count && values[start].val == value;
+}
+
+
+/*
+  Readers of the column types supported by Batch_filter from the row
+  images of a batch
+*/
+
+struct Batch_tiny
+{ static longlong get(const uchar *ptr) { return (signed char) *ptr; } };
+struct Batch_utiny
+{ static longlong get(const uchar *ptr) { return *ptr; } };
+struct Batch_short
+{ static longlong get(const uchar *ptr) { return sint2korr(ptr); } };
+struct Batch_ushort
+{ static longlong get(const uchar *ptr) { return uint2korr(ptr); } };
+struct Batch_int24
+{ static longlong get(const uchar *ptr) { return sint3korr(ptr); } };
+struct Batch_uint24
+{ static longlong get(const uchar *ptr) { return uint3korr(ptr); } };
+struct Batch_long
+{ static longlong get(const uchar *ptr) { return sint4korr(ptr); } };
+struct Batch_ulong
+{ static longlong get(const uchar *ptr) { return uint4korr(ptr); } };
+struct Batch_longlong
+{ static longlong get(const uchar *ptr) { return sint8korr(ptr); } };
+
+/** A DATE as the packed DATETIME value of Field_newdate::val_date_temporal */
+struct Batch_date
+{
+  static longlong get(const uchar *ptr)
+  {
+    const uint32 tmp= uint3korr(ptr);
+    const longlong year= tmp >> 9, month= (tmp >> 5) & 15, day= tmp & 31;
+    return MY_PACKED_TIME_MAKE_INT((((year * 13 + month) << 5) | day) << 17);
+  }
+};
+
+
+/**
+  Gather the values of a column of the selected rows, and drop the rows
+  where the column is NULL. There are no branches on the values in the
+  loop, so that it can be vectorized.
+*/
+
+template <class Reader>
+static uint gather_values(const uchar *rows, size_t row_length, uint offset,
+                          uint null_offset, uchar null_bit,
+                          uint *selection, uint count, longlong *values)
+{
+  uint n= 0;
+  for (uint i= 0; i < count; i++)
+  {
+    const uchar *const row= rows + selection[i] * row_length;
+    selection[n]= selection[i];
+    values[n]= Reader::get(row + offset);
+    n+= !(row[null_offset] & null_bit);
+  }
+  return n;
+}
+
+
+bool Batch_filter::set_column(TABLE *table, Item *item, bool is_temporal)
+{
+  Item *const real_item= item->real_item();
+  if (real_item->type() != Item::FIELD_ITEM)
+    return false;
+  Field *const field= ((Item_field *) real_item)->field;
+  if (field->table != table)
+    return false;
+#ifdef WORDS_BIGENDIAN
+  if (!table->s->db_low_byte_first)
+    return false;
+#endif
+  const bool is_unsigned= field->flags & UNSIGNED_FLAG;
+  switch (field->real_type()) {
+  case MYSQL_TYPE_TINY:
+    m_type= is_unsigned ? BATCH_UTINY : BATCH_TINY;
+    break;
+  case MYSQL_TYPE_SHORT:
+    m_type= is_unsigned ? BATCH_USHORT : BATCH_SHORT;
+    break;
+  case MYSQL_TYPE_INT24:
+    m_type= is_unsigned ? BATCH_UINT24 : BATCH_INT24;
+    break;
+  case MYSQL_TYPE_LONG:
+    m_type= is_unsigned ? BATCH_ULONG : BATCH_LONG;
+    break;
+  case MYSQL_TYPE_LONGLONG:
+    if (is_unsigned)
+      return false;
+    m_type= BATCH_LONGLONG;
+    break;
+  case MYSQL_TYPE_NEWDATE:
+    m_type= BATCH_DATE;
+    break;
+  default:
+    return false;
+  }
+  if (is_temporal != (m_type == BATCH_DATE))
+    return false;
+
+  m_offset= field->offset(table->record[0]);
+  if (field->real_maybe_null())
+  {
+    m_null_offset= field->null_offset();
+    m_null_bit= field->null_bit;
+  }
+  else
+  {
+    m_null_offset= 0;
+    m_null_bit= 0;
+  }
+  return true;
+}
+
+
+uint Batch_filter::get_values(const uchar *rows, size_t row_length,
+                              uint *selection, uint count,
+                              longlong *values) const
+{
+  switch (m_type) {
+  case BATCH_TINY:
+    return gather_values<Batch_tiny>(rows, row_length, m_offset,
+                                     m_null_offset, m_null_bit,
+                                     selection, count, values);
+  case BATCH_UTINY:
+    return gather_values<Batch_utiny>(rows, row_length, m_offset,
+                                      m_null_offset, m_null_bit,
+                                      selection, count, values);
+  case BATCH_SHORT:
+    return gather_values<Batch_short>(rows, row_length, m_offset,
+                                      m_null_offset, m_null_bit,
+                                      selection, count, values);
+  case BATCH_USHORT:
+    return gather_values<Batch_ushort>(rows, row_length, m_offset,
+                                       m_null_offset, m_null_bit,
+                                       selection, count, values);
+  case BATCH_INT24:
+    return gather_values<Batch_int24>(rows, row_length, m_offset,
+                                      m_null_offset, m_null_bit,
+                                      selection, count, values);
+  case BATCH_UINT24:
+    return gather_values<Batch_uint24>(rows, row_length, m_offset,
+                                       m_null_offset, m_null_bit,
+                                       selection, count, values);
+  case BATCH_LONG:
+    return gather_values<Batch_long>(rows, row_length, m_offset,
+                                     m_null_offset, m_null_bit,
+                                     selection, count, values);
+  case BATCH_ULONG:
+    return gather_values<Batch_ulong>(rows, row_length, m_offset,
+                                      m_null_offset, m_null_bit,
+                                      selection, count, values);
+  case BATCH_LONGLONG:
+    return gather_values<Batch_longlong>(rows, row_length, m_offset,
+                                         m_null_offset, m_null_bit,
+                                         selection, count, values);
+  case BATCH_DATE:
+    return gather_values<Batch_date>(rows, row_length, m_offset,
+                                     m_null_offset, m_null_bit,
+                                     selection, count, values);
+  }
+  DBUG_ASSERT(0);
+  return 0;
+}
+
+
+uint Batch_filter::select(const uchar *rows, size_t row_length,
+                          uint *selection, uint count) const
+{
+  longlong values[MAX_ROW_BATCH];
+  DBUG_ASSERT(count <= MAX_ROW_BATCH);
+  count= get_values(rows, row_length, selection, count, values);
+
+  uint selected= 0;
+  if (m_array)
+  {
+    for (uint i= 0; i < count; i++)
+    {
+      selection[selected]= selection[i];
+      selected+= m_array->find_signed(values[i]) != m_negated;
+    }
+    return selected;
+  }
+  if (m_low > m_high)
+    return m_negated ? count : 0;
+  /* low <= value <= high with one unsigned comparison */
+  const ulonglong width= (ulonglong) m_high - (ulonglong) m_low;
+  for (uint i= 0; i < count; i++)
+  {
+    selection[selected]= selection[i];
+    selected+= (((ulonglong) values[i] - (ulonglong) m_low) <= width) !=
+               m_negated;
+  }
+  return selected;
+}
+
 
 void in_time_as_longlong::set(uint pos,Item *item)
 {
@@ -5053,6 +5352,33 @@ longlong Item_func_in::val_int()
 }
 
 
+/**
+  IN is evaluated on batches with a binary search of the sorted vector of
+  constant values, which are compared as signed integers for an integer
+  column and as packed DATETIME values for a DATE column.
+*/
+
+bool Item_func_in::prepare_batch(TABLE *table)
+{
+  if (!array || have_null || array->result_type() != INT_RESULT)
+    return false;
+  const bool is_temporal= args[0]->is_temporal();
+  if (!is_temporal)
+  {
+    /* DATE/DATETIME values make the vector hold packed DATETIME values */
+    for (uint i= 1; i < arg_count; i++)
+      if (args[i]->is_temporal() || args[i]->result_type() != INT_RESULT)
+        return false;
+  }
+  const in_longlong *const values= static_cast<in_longlong *>(array);
+  if (values->has_big_unsigned_value() ||
+      !batch_filter.set_column(table, args[0], is_temporal))
+    return false;
+  batch_filter.set_array(values, negated);
+  return true;
+}
+
+
 longlong Item_func_bit_or::val_int()
 {
   DBUG_ASSERT(fixed == 1);
@@ -6467,6 +6793,75 @@ Item *Item_bool_rowready_func2::neg_transformer(THD *thd)
   return item;
 }
 
+
+/**
+  A comparison of a column with a constant is evaluated on batches as a
+  range of the values of the column, or as the values outside of it
+  for <>.
+*/
+
+bool Item_bool_rowready_func2::prepare_batch(TABLE *table)
+{
+  Functype type= functype();
+  /* <=> is true for NULL values */
+  if (type == EQUAL_FUNC)
+    return false;
+  uint column;
+  if (args[1]->const_item())
+    column= 0;
+  else if (args[0]->const_item())
+  {
+    column= 1;
+    if (type != NE_FUNC)
+      type= rev_functype();
+  }
+  else
+    return false;
+  if (args[1 - column]->is_expensive())
+    return false;
+
+  longlong value;
+  bool is_null, is_temporal;
+  if (!cmp.get_batch_value(column == 1, &value, &is_null, &is_temporal) ||
+      !batch_filter.set_column(table, args[column], is_temporal))
+    return false;
+
+  if (is_null)
+  {
+    batch_filter.set_range(1, 0, false);          // Never true
+    return true;
+  }
+  switch (type) {
+  case EQ_FUNC:
+    batch_filter.set_range(value, value, false);
+    break;
+  case NE_FUNC:
+    batch_filter.set_range(value, value, true);
+    break;
+  case LT_FUNC:
+    if (value == LONGLONG_MIN)
+      batch_filter.set_range(1, 0, false);
+    else
+      batch_filter.set_range(LONGLONG_MIN, value - 1, false);
+    break;
+  case LE_FUNC:
+    batch_filter.set_range(LONGLONG_MIN, value, false);
+    break;
+  case GT_FUNC:
+    if (value == LONGLONG_MAX)
+      batch_filter.set_range(1, 0, false);
+    else
+      batch_filter.set_range(value + 1, LONGLONG_MAX, false);
+    break;
+  case GE_FUNC:
+    batch_filter.set_range(value, LONGLONG_MAX, false);
+    break;
+  default:
+    return false;
+  }
+  return true;
+}
+
 /**
   XOR can be negated by negating one of the operands:
 
@@ -107,6 +107,8 @@ public:
   int compare_datetime();        // compare args[0] & args[1] as DATETIMEs
 
   static bool can_compare_as_dates(Item *a, Item *b, ulonglong *const_val_arg);
+  bool get_batch_value(bool const_is_a, longlong *value, bool *is_null,
+                       bool *is_temporal);
 
   Item** cache_converted_constant(THD *thd, Item **value, Item **cache,
                                   Item_result type);
@@ -136,6 +138,68 @@ public:
   friend class Item_func;
 };
 
+
+class in_longlong;
+
+/**
+  A condition on an integer or DATE column of a table that is evaluated
+  on batches of rows, see Item::val_int_batch(). The values of the column
+  are compared as signed integers, DATE values as packed DATETIME values.
+  The condition is never true for the rows where the column is NULL.
+*/
+
+class Batch_filter
+{
+public:
+  Batch_filter() : m_array(NULL) {}
+  /**
+    Read the values from a column of a table.
+
+    @param table        table the rows are read from
+    @param item         argument of the condition, a column of table
+    @param is_temporal  true for a DATE column, false for an integer column
+
+    @return false if item is not a column of table of a supported type
+  */
+  bool set_column(TABLE *table, Item *item, bool is_temporal);
+  /** The rows with a value in [low, high] are selected, or the others */
+  void set_range(longlong low, longlong high, bool negated)
+  {
+    m_low= low;
+    m_high= high;
+    m_array= NULL;
+    m_negated= negated;
+  }
+  /** The rows with a value in the vector are selected, or the others */
+  void set_array(const in_longlong *array, bool negated)
+  {
+    m_array= array;
+    m_negated= negated;
+  }
+  /** Select the rows of a batch, see Item::val_int_batch() */
+  uint select(const uchar *rows, size_t row_length,
+              uint *selection, uint count) const;
+
+private:
+  enum Column_type
+  {
+    BATCH_TINY, BATCH_UTINY, BATCH_SHORT, BATCH_USHORT, BATCH_INT24,
+    BATCH_UINT24, BATCH_LONG, BATCH_ULONG, BATCH_LONGLONG, BATCH_DATE
+  };
+
+  uint get_values(const uchar *rows, size_t row_length,
+                  uint *selection, uint count, longlong *values) const;
+
+  Column_type m_type;
+  uint m_offset;           // of the value in the row image
+  uint m_null_offset;      // of the null bit in the row image
+  uchar m_null_bit;        // 0 if the column is NOT NULL
+  bool m_negated;
+  longlong m_low, m_high;
+  const in_longlong *m_array;
+};
+
+
 class Item_bool_func :public Item_int_func
 {
 public:
@@ -426,6 +490,12 @@ public:
   Item *neg_transformer(THD *thd);
   virtual Item *negated_item();
   bool subst_argument_checker(uchar **arg) { return TRUE; }
+  bool prepare_batch(TABLE *table);
+  uint val_int_batch(const uchar *rows, size_t row_length,
+                     uint *selection, uint count)
+  { return batch_filter.select(rows, row_length, selection, count); }
+private:
+  Batch_filter batch_filter;
 };
 
 /**
@@ -763,6 +833,12 @@ public:
   bool is_bool_func() { return 1; }
   const CHARSET_INFO *compare_collation() { return cmp_collation.collation; }
   uint decimal_precision() const { return 1; }
+  bool prepare_batch(TABLE *table);
+  uint val_int_batch(const uchar *rows, size_t row_length,
+                     uint *selection, uint count)
+  { return batch_filter.select(rows, row_length, selection, count); }
+private:
+  Batch_filter batch_filter;
 };
 
 
@@ -1017,6 +1093,13 @@ public:
       ((packed_longlong*) base)[pos].unsigned_flag;
   }
   Item_result result_type() { return INT_RESULT; }
+  /**
+    @return true if a value of the vector does not fit into a signed
+    longlong. Otherwise the values are sorted as signed values.
+  */
+  bool has_big_unsigned_value() const;
+  /** Binary search of a signed value, see has_big_unsigned_value() */
+  bool find_signed(longlong value) const;
 
   friend int cmp_longlong(void *cmp_arg, packed_longlong *a,packed_longlong *b);
 };
@@ -1443,6 +1526,12 @@ public:
   bool nulls_in_row();
   bool is_bool_func() { return 1; }
   const CHARSET_INFO *compare_collation() { return cmp_collation.collation; }
+  bool prepare_batch(TABLE *table);
+  uint val_int_batch(const uchar *rows, size_t row_length,
+                     uint *selection, uint count)
+  { return batch_filter.select(rows, row_length, selection, count); }
+private:
+  Batch_filter batch_filter;
 };
 
 class cmp_item_row :public cmp_item
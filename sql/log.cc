@@ -2136,6 +2136,10 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
       thd->status_var.ha_read_rnd_next_count >= query_start->ha_read_rnd_next_count &&
       thd->status_var.ha_key_skipped_count >= query_start->ha_key_skipped_count &&
       thd->status_var.ha_delete_skipped_count >= query_start->ha_delete_skipped_count &&
+      thd->status_var.ha_block_cache_hit_count >= query_start->ha_block_cache_hit_count &&
+      thd->status_var.ha_bloom_filter_useful_count >= query_start->ha_bloom_filter_useful_count &&
+      thd->status_var.ha_key_compared_count >= query_start->ha_key_compared_count &&
+      thd->status_var.ha_bytes_read >= query_start->ha_bytes_read &&
       thd->status_var.filesort_merge_passes >= query_start->filesort_merge_passes &&
       thd->status_var.filesort_range_count >= query_start->filesort_range_count &&
       thd->status_var.filesort_rows >= query_start->filesort_rows &&
@@ -2238,6 +2242,9 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
                       " Read_next: %lu Read_prev: %lu"
                       " Read_rnd: %lu Read_rnd_next: %lu"
                       " RocksDB_key_skipped: %lu RocksDB_del_skipped: %lu"
+                      " RocksDB_block_cache_hit: %lu"
+                      " RocksDB_bloom_filter_useful: %lu"
+                      " RocksDB_key_compared: %lu RocksDB_bytes_read: %lu"
                       " Sort_merge_passes: %lu Sort_range_count: %lu"
                       " Sort_rows: %lu Sort_scan_count: %lu"
                       " Created_tmp_disk_tables: %lu"
@@ -2274,6 +2281,14 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
                           query_start->ha_key_skipped_count),
                       (ulong) (thd->status_var.ha_delete_skipped_count -
                           query_start->ha_delete_skipped_count),
+                      (ulong) (thd->status_var.ha_block_cache_hit_count -
+                          query_start->ha_block_cache_hit_count),
+                      (ulong) (thd->status_var.ha_bloom_filter_useful_count -
+                          query_start->ha_bloom_filter_useful_count),
+                      (ulong) (thd->status_var.ha_key_compared_count -
+                          query_start->ha_key_compared_count),
+                      (ulong) (thd->status_var.ha_bytes_read -
+                          query_start->ha_bytes_read),
                       (ulong) (thd->status_var.filesort_merge_passes -
                           query_start->filesort_merge_passes),
                       (ulong) (thd->status_var.filesort_range_count -
@@ -2307,6 +2322,9 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
                       " Read_next: %lu Read_prev: %lu"
                       " Read_rnd: %lu Read_rnd_next: %lu"
                       " RocksDB_key_skipped: %lu RocksDB_del_skipped: %lu"
+                      " RocksDB_block_cache_hit: %lu"
+                      " RocksDB_bloom_filter_useful: %lu"
+                      " RocksDB_key_compared: %lu RocksDB_bytes_read: %lu"
                       " Sort_merge_passes: %lu Sort_range_count: %lu"
                       " Sort_rows: %lu Sort_scan_count: %lu"
                       " Created_tmp_disk_tables: %lu"
@@ -2332,6 +2350,10 @@ bool MYSQL_QUERY_LOG::write(THD *thd, time_t current_time,
                       (ulong) thd->status_var.ha_read_rnd_next_count,
                       (ulong) thd->status_var.ha_key_skipped_count,
                       (ulong) thd->status_var.ha_delete_skipped_count,
+                      (ulong) thd->status_var.ha_block_cache_hit_count,
+                      (ulong) thd->status_var.ha_bloom_filter_useful_count,
+                      (ulong) thd->status_var.ha_key_compared_count,
+                      (ulong) thd->status_var.ha_bytes_read,
                       (ulong) thd->status_var.filesort_merge_passes,
                       (ulong) thd->status_var.filesort_range_count,
                       (ulong) thd->status_var.filesort_rows,
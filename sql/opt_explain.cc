@@ -1594,6 +1594,8 @@ bool Explain_join::explain_extra()
       StringBuffer<64> buff(cs);
       if ((tab->use_join_cache & JOIN_CACHE::ALG_BNL))
         buff.append("Block Nested Loop");
+      else if ((tab->use_join_cache & JOIN_CACHE::ALG_HASH))
+        buff.append("Hash Join");
       else if ((tab->use_join_cache & JOIN_CACHE::ALG_BKA))
         buff.append("Batched Key Access");
       else if ((tab->use_join_cache & JOIN_CACHE::ALG_BKA_UNIQUE))
@@ -5037,6 +5037,36 @@ void THD::inc_status_sort_scan()
 #endif
 }
 
+/**
+  Add the read statistics that a storage engine reported for one table to
+  the status of the session and to the metrics of the current statement.
+*/
+void THD::inc_status_engine_stats(const ha_statistics &stats)
+{
+  status_var.ha_key_skipped_count+= stats.key_skipped;
+  status_var.ha_delete_skipped_count+= stats.delete_skipped;
+  status_var.ha_block_cache_hit_count+= stats.block_cache_hit;
+  status_var.ha_bloom_filter_useful_count+= stats.bloom_filter_useful;
+  status_var.ha_key_compared_count+= stats.key_compared;
+  status_var.ha_bytes_read+= stats.bytes_read;
+#ifdef HAVE_PSI_STATEMENT_INTERFACE
+  PSI_STATEMENT_CALL(inc_statement_keys_skipped)(m_statement_psi,
+                                                 stats.key_skipped);
+  PSI_STATEMENT_CALL(inc_statement_deletes_skipped)(m_statement_psi,
+                                                    stats.delete_skipped);
+  PSI_STATEMENT_CALL(inc_statement_block_cache_hits)(m_statement_psi,
+                                                     stats.block_cache_hit);
+  PSI_STATEMENT_CALL(inc_statement_block_reads)(
+    m_statement_psi, stats.table_io_perf_read.requests);
+  PSI_STATEMENT_CALL(inc_statement_bloom_filter_useful)(
+    m_statement_psi, stats.bloom_filter_useful);
+  PSI_STATEMENT_CALL(inc_statement_key_comparisons)(m_statement_psi,
+                                                    stats.key_compared);
+  PSI_STATEMENT_CALL(inc_statement_bytes_read)(m_statement_psi,
+                                               stats.bytes_read);
+#endif
+}
+
 void THD::set_status_no_index_used()
 {
   server_status|= SERVER_QUERY_NO_INDEX_USED;
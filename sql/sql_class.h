@@ -107,6 +107,7 @@ class Rows_log_event;
 class Sroutine_hash_entry;
 class User_level_lock;
 class user_var_entry;
+class ha_statistics;
 class ExecutionContextImpl;
 
 class Srv_session;
@@ -663,6 +664,7 @@ typedef struct system_variables
   ulong slow_log_if_rows_examined_exceed;
   ulong div_precincrement;
   ulong sortbuff_size;
+  ulong filesort_threads;
   ulong max_sp_recursion_depth;
   ulong default_week_format;
   ulong max_seeks_for_key;
@@ -802,6 +804,10 @@ typedef struct system_status_var
   ulonglong ha_read_rnd_next_count;
   ulonglong ha_key_skipped_count;
   ulonglong ha_delete_skipped_count;
+  ulonglong ha_block_cache_hit_count;
+  ulonglong ha_bloom_filter_useful_count;
+  ulonglong ha_key_compared_count;
+  ulonglong ha_bytes_read;
   /*
     This number doesn't include calls to the default implementation and
     calls made by range access. The intent is to count only calls made by
@@ -3231,6 +3237,7 @@ public:
   void inc_status_sort_scan();
   void set_status_no_index_used();
   void set_status_no_good_index_used();
+  void inc_status_engine_stats(const ha_statistics &stats);
 
   void capture_system_thread_id();
 
@@ -77,9 +77,11 @@
 #define MAX_PARTITIONS  8192
 
 #define MAX_SELECT_NESTING (sizeof(nesting_map)*8-1)
+#define MAX_ROW_BATCH	128		/* Rows filtered by Item::val_int_batch */
 
 #define DEFAULT_SORT_MEMORY (256UL* 1024UL)
 #define MIN_SORT_MEMORY     (32UL * 1024UL)
+#define MAX_FILESORT_THREADS 64
 
 /* Some portable defines */
 
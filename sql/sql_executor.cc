@@ -85,6 +85,7 @@ static int join_read_linked_first(JOIN_TAB *tab);
 static int join_read_linked_next(READ_RECORD *info);
 static int do_sj_reset(SJ_TMP_TABLE *sj_tbl);
 static bool cmp_buffer_with_ref(THD *thd, TABLE *table, TABLE_REF *tab_ref);
+static Row_batch *start_row_batch(JOIN *join, JOIN_TAB *join_tab);
 
 /**
   Execute select, executor entry point.
@@ -1286,12 +1287,18 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
 
   join->thd->get_stmt_da()->reset_current_row_for_warning();
 
+  Row_batch *const batch= start_row_batch(join, join_tab);
+  if (join->thd->is_error())
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+
   enum_nested_loop_state rc= NESTED_LOOP_OK;
   bool in_first_read= true;
   while (rc == NESTED_LOOP_OK && join->return_tab >= join_tab)
   {
     int error;
-    if (in_first_read)
+    if (batch)
+      error= batch->read_record(join, join_tab);
+    else if (in_first_read)
     {
       in_first_read= false;
       error= (*join_tab->read_first_record)(join_tab);
@@ -1325,6 +1332,175 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
 }
 
 
+/**
+  Read the rows of a scan of a table in batches if the optimizer_switch
+  flag batched_condition is on and the scan allows it, see Row_batch.
+
+  @return the batch to read the rows of the scan from, or NULL if the rows
+  are read one at a time
+*/
+
+static Row_batch *start_row_batch(JOIN *join, JOIN_TAB *join_tab)
+{
+  TABLE *const table= join_tab->table;
+  const enum_sql_command command= join->thd->lex->sql_command;
+  if (!join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_BATCHED_CONDITION) ||
+      join_tab->type != JT_ALL || !join_tab->condition() ||
+      join_tab->keep_current_rowid || table->s->blob_fields ||
+      table->reginfo.lock_type != TL_READ)
+    return NULL;
+  /*
+    Multi-table UPDATE and DELETE take the positions of the rows from the
+    handlers, also of tables they only read for the CHECK OPTION of a view.
+  */
+  if (command == SQLCOM_UPDATE_MULTI || command == SQLCOM_DELETE_MULTI)
+    return NULL;
+  if (!join_tab->row_batch &&
+      !(join_tab->row_batch= Row_batch::create(join->thd, join_tab)))
+    return NULL;
+  return join_tab->row_batch->start(join_tab) ? join_tab->row_batch : NULL;
+}
+
+
+static bool is_and_condition(Item *cond)
+{
+  return cond->type() == Item::COND_ITEM &&
+         ((Item_cond *) cond)->functype() == Item_func::COND_AND_FUNC;
+}
+
+
+Row_batch *Row_batch::create(THD *thd, JOIN_TAB *tab)
+{
+  const size_t row_length= tab->table->s->reclength;
+  const uint max_rows=
+    (uint) min<ulonglong>(MAX_ROW_BATCH,
+                          thd->variables.join_buff_size / row_length);
+  if (max_rows < 2)
+    return NULL;
+  Item *const cond= tab->condition();
+  const uint max_filters= is_and_condition(cond) ?
+    ((Item_cond *) cond)->argument_list()->elements : 1;
+
+  uchar *rows;
+  Item **filters;
+  if (!(rows= (uchar *) thd->alloc(max_rows * row_length)) ||
+      !(filters= (Item **) thd->alloc(max_filters * sizeof(Item *))))
+    return NULL;
+  return new (thd->mem_root) Row_batch(rows, row_length, max_rows,
+                                       filters, max_filters);
+}
+
+
+bool Row_batch::start(JOIN_TAB *tab)
+{
+  TABLE *const table= tab->table;
+  Item *const cond= tab->condition();
+  m_filter_count= 0;
+  if (is_and_condition(cond))
+  {
+    List_iterator<Item> it(*((Item_cond *) cond)->argument_list());
+    Item *item;
+    while ((item= it++) && m_filter_count < m_max_filters)
+    {
+      if (item->prepare_batch(table))
+        m_filters[m_filter_count++]= item;
+    }
+  }
+  else if (cond->prepare_batch(table))
+    m_filters[m_filter_count++]= cond;
+
+  m_first_read= true;
+  m_end_error= 0;
+  m_count= m_selected= m_next_selected= m_next_row= 0;
+  return m_filter_count > 0;
+}
+
+
+/**
+  Read the next batch of rows of the scan, and select the rows that are
+  not rejected by the batched conjuncts.
+
+  @return 0, or the error of a read that failed
+*/
+
+int Row_batch::fill(JOIN *join, JOIN_TAB *tab)
+{
+  THD *const thd= join->thd;
+  TABLE *const table= tab->table;
+  m_count= m_selected= m_next_selected= m_next_row= 0;
+  while (m_count < m_max_rows)
+  {
+    int error;
+    if (m_first_read)
+    {
+      m_first_read= false;
+      error= (*tab->read_first_record)(tab);
+    }
+    else
+      error= tab->read_record.read_record(&tab->read_record);
+
+    if (error > 0 || thd->is_error())
+      return error > 0 ? error : 1;
+    if (error < 0)
+    {
+      m_end_error= error;
+      break;
+    }
+    memcpy(m_rows + m_count++ * m_row_length, table->record[0],
+           m_row_length);
+    if (thd->killed)
+      break;
+  }
+
+  for (uint i= 0; i < m_count; i++)
+    m_selection[i]= i;
+  m_selected= m_count;
+  for (uint i= 0; i < m_filter_count && m_selected; i++)
+    m_selected= m_filters[i]->val_int_batch(m_rows, m_row_length,
+                                            m_selection, m_selected);
+  return 0;
+}
+
+
+/**
+  Account for the rejected rows of the batch before row 'end', as
+  evaluate_join_record() does for a row its condition is false for. No row
+  lock has to be released, as the rows are read without locks.
+*/
+
+void Row_batch::reject_rows(JOIN *join, uint end)
+{
+  for (; m_next_row < end; m_next_row++)
+  {
+    join->examined_rows++;
+    join->thd->get_stmt_da()->inc_current_row_for_warning();
+  }
+}
+
+
+int Row_batch::read_record(JOIN *join, JOIN_TAB *tab)
+{
+  while (m_next_selected == m_selected)
+  {
+    reject_rows(join, m_count);
+    if (m_end_error)
+      return m_end_error;
+    if (join->thd->killed)
+      return 0;
+    int error;
+    if ((error= fill(join, tab)))
+      return error;
+  }
+  const uint row= m_selection[m_next_selected++];
+  reject_rows(join, row);
+  m_next_row= row + 1;
+  TABLE *const table= tab->table;
+  memcpy(table->record[0], m_rows + row * m_row_length, m_row_length);
+  table->status= 0;
+  return 0;
+}
+
+
 /**
   @brief Prepare table to be scanned.
 
@@ -3064,6 +3240,48 @@ end:
   DBUG_RETURN(NESTED_LOOP_OK);
 }
 
+/**
+  Write the groups aggregated in memory by end_update() into the tmp table
+  and stop aggregating in memory.
+
+  The rows are written in the order in which the groups were created. If
+  the heap table gets full it is converted to MyISAM, and the following
+  rows are grouped by end_unique_update() as when end_update() converts it.
+
+  @return true if error
+*/
+
+static bool write_group_table(JOIN_TAB *join_tab)
+{
+  TABLE *const table= join_tab->table;
+  QEP_tmp_table *const op= (QEP_tmp_table *) join_tab->op;
+  Group_hash_table *const groups= op->get_group_table();
+  int error;
+  DBUG_ENTER("write_group_table");
+
+  for (uchar *row= groups->first_row(); row; row= groups->next_row(row))
+  {
+    memcpy(table->record[0], row, table->s->reclength);
+    if ((error= table->file->ha_write_row(table->record[0])))
+    {
+      if (create_myisam_from_heap(join_tab->join->thd, table,
+                                  join_tab->tmp_table_param->start_recinfo,
+                                  &join_tab->tmp_table_param->recinfo,
+                                  error, FALSE, NULL))
+        DBUG_RETURN(true);
+      if ((error= table->file->ha_index_init(0, 0)))
+      {
+        table->file->print_error(error, MYF(0));
+        DBUG_RETURN(true);
+      }
+      op->set_write_func(end_unique_update);
+    }
+  }
+  groups->stop();
+  DBUG_RETURN(false);
+}
+
+
 /* ARGSUSED */
 /** Group by searching after group record and updating it if possible. */
 
@@ -3071,12 +3289,19 @@ static enum_nested_loop_state
 end_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
 {
   TABLE *const table= join_tab->table;
+  Group_hash_table *const groups=
+    ((QEP_tmp_table *) join_tab->op)->get_group_table();
   ORDER   *group;
   int	  error;
+  uint32  hash= 0;
   DBUG_ENTER("end_update");
 
   if (end_of_records)
+  {
+    if (groups->is_active() && write_group_table(join_tab))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
     DBUG_RETURN(NESTED_LOOP_OK);
+  }
   if (join->thd->killed)			// Aborted by user
   {
     join->thd->send_kill_message();
@@ -3094,7 +3319,19 @@ end_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
     if (item->maybe_null)
       group->buff[-1]= (char) group->field->is_null();
   }
-  if (!table->file->ha_index_read_map(table->record[1],
+  if (groups->is_active())
+  {
+    hash= groups->hash_key();
+    uchar *const row= groups->find(hash);
+    if (row)
+    {						/* Update group in memory */
+      memcpy(table->record[0], row, table->s->reclength);
+      update_tmptable_sum_func(join->sum_funcs, table);
+      memcpy(row, table->record[0], table->s->reclength);
+      DBUG_RETURN(NESTED_LOOP_OK);
+    }
+  }
+  else if (!table->file->ha_index_read_map(table->record[1],
                                       join_tab->tmp_table_param->group_buff,
                                       HA_WHOLE_KEY,
                                       HA_READ_KEY_EXACT))
@@ -3126,6 +3363,17 @@ end_update(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
   init_tmptable_sum_functions(join->sum_funcs);
   if (copy_funcs(join_tab->tmp_table_param->items_to_copy, join->thd))
     DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
+  if (groups->is_active())
+  {
+    bool is_full;
+    if (!groups->insert(hash, &is_full))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    join_tab->send_records++;
+    /* Group the following rows in the tmp table when memory runs out */
+    if (is_full && write_group_table(join_tab))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    DBUG_RETURN(NESTED_LOOP_OK);
+  }
   if ((error=table->file->ha_write_row(table->record[0])))
   {
     if (create_myisam_from_heap(join->thd, table,
@@ -4334,6 +4582,18 @@ QEP_tmp_table::prepare_tmp_table()
     table->file->print_error(rc, MYF(0));
     return true;
   }
+  /*
+    Aggregate the groups in memory until they don't fit in it. This is
+    chosen by the hash_group_by switch alone: the optimizer doesn't cost it
+    against the tmp table or the sort, so the switch is off by default.
+  */
+  group_table.stop();
+  if (write_func == end_update &&
+      join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_GROUP_BY))
+    (void) group_table.start(table, join_tab->tmp_table_param->group_buff,
+                             join_tab->tmp_table_param->group_length,
+                             min(join->thd->variables.tmp_table_size,
+                                 join->thd->variables.max_heap_table_size));
   return false;
 }
 
@@ -4432,6 +4692,178 @@ QEP_tmp_table::end_send()
 }
 
 
+/****************************************************************************
+  Group_hash_table implementation
+****************************************************************************/
+
+Group_hash_table::Group_hash_table()
+  : m_table(NULL), m_key(NULL), m_key_length(0), m_slots(NULL),
+    m_capacity(0), m_count(0), m_size(0), m_max_size(0), m_first(NULL),
+    m_last(NULL)
+{
+  init_sql_alloc(&m_mem_root, 8192, 0);
+}
+
+
+bool Group_hash_table::start(TABLE *table, uchar *key, uint key_length,
+                             ulonglong max_size)
+{
+  DBUG_ASSERT(!is_active());
+
+  /* Blob data is not in the row, and bits may be stored apart from it */
+  if (table->s->blob_fields)
+    return false;
+  for (ORDER *group= table->group; group; group= group->next)
+  {
+    if (group->field->type() == MYSQL_TYPE_BIT)
+      return false;
+  }
+
+  if (!m_slots)
+  {
+    m_capacity= 256;
+    if (!(m_slots= (Entry **) my_malloc(m_capacity * sizeof(Entry *),
+                                        MYF(MY_ZEROFILL))))
+      return false;
+  }
+  m_table= table;
+  m_key= key;
+  m_key_length= key_length;
+  m_max_size= max_size;
+  m_size= m_capacity * sizeof(Entry *);
+  return true;
+}
+
+
+void Group_hash_table::stop()
+{
+  if (m_count)
+  {
+    memset(m_slots, 0, m_capacity * sizeof(Entry *));
+    free_root(&m_mem_root, MYF(MY_MARK_BLOCKS_FREE));
+  }
+  m_table= NULL;
+  m_count= 0;
+  m_first= m_last= NULL;
+}
+
+
+void Group_hash_table::free()
+{
+  stop();
+  free_root(&m_mem_root, MYF(0));
+  my_free(m_slots);
+  m_slots= NULL;
+  m_capacity= 0;
+}
+
+
+uint32 Group_hash_table::hash_key() const
+{
+  ulong nr1= 1, nr2= 4;
+  /* The fields of the key are NULL when the NULL flags in the key are set */
+  for (ORDER *group= m_table->group; group; group= group->next)
+    group->field->hash(&nr1, &nr2);
+  return (uint32) nr1;
+}
+
+
+/**
+  Compare a group key with the current one as the index of the tmp table
+  does, that is with the collations of the fields.
+*/
+
+bool Group_hash_table::keys_equal(const uchar *key) const
+{
+  for (ORDER *group= m_table->group; group; group= group->next)
+  {
+    const size_t offset= (uchar *) group->buff - m_key;
+    if ((*group->item)->maybe_null)
+    {
+      if (key[offset - 1] != m_key[offset - 1])
+        return false;
+      if (key[offset - 1])
+        continue;
+    }
+    if (group->field->cmp(key + offset, m_key + offset))
+      return false;
+  }
+  return true;
+}
+
+
+uchar *Group_hash_table::find(uint32 hash) const
+{
+  const size_t mask= m_capacity - 1;
+  for (size_t i= hash & mask; m_slots[i]; i= (i + 1) & mask)
+  {
+    const Entry *const entry= m_slots[i];
+    if (entry->hash == hash && keys_equal(entry_key(entry)))
+      return entry_row(entry);
+  }
+  return NULL;
+}
+
+
+/** Double the number of slots, so that at most half of them are used */
+
+bool Group_hash_table::grow()
+{
+  const size_t capacity= m_capacity * 2;
+  const size_t mask= capacity - 1;
+  Entry **const slots= (Entry **) my_malloc(capacity * sizeof(Entry *),
+                                            MYF(MY_WME | MY_ZEROFILL));
+  if (!slots)
+    return true;
+  for (Entry *entry= m_first; entry; entry= entry->next)
+  {
+    size_t i= entry->hash & mask;
+    while (slots[i])
+      i= (i + 1) & mask;
+    slots[i]= entry;
+  }
+  my_free(m_slots);
+  m_slots= slots;
+  m_size+= (capacity - m_capacity) * sizeof(Entry *);
+  m_capacity= capacity;
+  return false;
+}
+
+
+uchar *Group_hash_table::insert(uint32 hash, bool *is_full)
+{
+  if ((m_count + 1) * 2 > m_capacity && grow())
+    return NULL;
+
+  const size_t entry_size= sizeof(Entry) + m_key_length +
+                           m_table->s->reclength;
+  Entry *const entry= (Entry *) alloc_root(&m_mem_root, entry_size);
+  if (!entry)
+    return NULL;
+  entry->next= NULL;
+  entry->hash= hash;
+  memcpy(entry_key(entry), m_key, m_key_length);
+  memcpy(entry_row(entry), m_table->record[0], m_table->s->reclength);
+
+  const size_t mask= m_capacity - 1;
+  size_t i= hash & mask;
+  while (m_slots[i])
+    i= (i + 1) & mask;
+  m_slots[i]= entry;
+
+  if (m_last)
+    m_last->next= entry;
+  else
+    m_first= entry;
+  m_last= entry;
+  m_count++;
+  m_size+= entry_size;
+
+  *is_full= m_size > m_max_size;
+  return entry_row(entry);
+}
+
+
 /**
   @} (end of group Query_Executor)
 */
@@ -155,6 +155,71 @@ public:
 };
 
 
+/**
+  Rows of a table scan read ahead into a buffer, so that the conjuncts of
+  the condition of the table that support Item::val_int_batch() reject the
+  rows a batch at a time (optimizer_switch flag batched_condition). The rows
+  that pass them are copied back into record[0] one at a time and are
+  evaluated with the whole condition as before.
+
+  Only scans of tables without blobs that are read without locks, and
+  whose row positions are not needed, are read ahead: the rows have to be
+  self-contained in record[0], as the handler is positioned after the row
+  that is evaluated.
+*/
+
+class Row_batch : public Sql_alloc
+{
+public:
+  /**
+    Create the buffer for the scans of a table.
+
+    @return NULL if the rows of the table are too long to be buffered
+  */
+  static Row_batch *create(THD *thd, JOIN_TAB *tab);
+  /**
+    Start a scan of the table, and prepare the conjuncts of the condition
+    of the table for the rows of the scan.
+
+    @return false if no conjunct can be evaluated on batches
+  */
+  bool start(JOIN_TAB *tab);
+  /**
+    Read the next row that is not rejected by the batched conjuncts into
+    record[0]. The rows that are rejected are accounted for the way
+    evaluate_join_record() does.
+
+    @return as READ_RECORD::read_record. 0 is also returned without a row
+    when the query is killed.
+  */
+  int read_record(JOIN *join, JOIN_TAB *tab);
+
+private:
+  Row_batch(uchar *rows, size_t row_length, uint max_rows,
+            Item **filters, uint max_filters)
+    :m_rows(rows), m_row_length(row_length), m_max_rows(max_rows),
+    m_filters(filters), m_max_filters(max_filters), m_filter_count(0)
+  {}
+
+  int fill(JOIN *join, JOIN_TAB *tab);
+  void reject_rows(JOIN *join, uint end);
+
+  uchar *const m_rows;
+  const size_t m_row_length;
+  const uint m_max_rows;
+  Item **const m_filters;       ///< Conjuncts prepared for the scan
+  const uint m_max_filters;
+  uint m_filter_count;
+  bool m_first_read;
+  int m_end_error;              ///< Result of the read that ended the batch
+  uint m_count;                 ///< Rows in the batch
+  uint m_selection[MAX_ROW_BATCH]; ///< Rows not rejected, in order
+  uint m_selected;              ///< Rows in m_selection
+  uint m_next_selected;         ///< Next row of m_selection to return
+  uint m_next_row;              ///< Rows before it are accounted for
+};
+
+
 
 /**
   QEP_operation is an interface class for operations in query execution plan.
@@ -211,6 +276,100 @@ public:
 };
 
 
+/**
+  In-memory hash table of the groups that end_update() aggregates into a
+  tmp table.
+
+  Each group is kept as a copy of its group key and of its row of the tmp
+  table, allocated from a MEM_ROOT, so the aggregate functions of a group
+  are updated without a lookup and an update of the row in the tmp table.
+  The groups are found with open addressing on the hash of the group key,
+  and are chained in the order in which they were created so that their
+  rows are written into the tmp table in the same order as end_update()
+  writes them.
+*/
+
+class Group_hash_table
+{
+public:
+  Group_hash_table();
+
+  /**
+    Start aggregating the groups of 'table' in memory.
+
+    @param table       tmp table grouped by end_update()
+    @param key         buffer the group key is built in
+    @param key_length  length of the group key
+    @param max_size    memory the groups may take before they are written
+                       into the tmp table
+
+    @return false if the groups of the table can't be kept in memory
+  */
+  bool start(TABLE *table, uchar *key, uint key_length, ulonglong max_size);
+  /** Stop aggregating in memory and forget all the groups */
+  void stop();
+  bool is_active() const { return m_table != NULL; }
+
+  /** Hash of the group key of the current row */
+  uint32 hash_key() const;
+  /** @return the row of the group with the current group key, or NULL */
+  uchar *find(uint32 hash) const;
+  /**
+    Add a group with the current group key and the current row of the tmp
+    table.
+
+    @param hash          hash of the group key
+    @param[out] is_full  set when the groups take more than the memory
+                         they may take
+
+    @return the row of the new group, or NULL when out of memory
+  */
+  uchar *insert(uint32 hash, bool *is_full);
+
+  /** The rows of the groups in the order in which the groups were created */
+  uchar *first_row() const
+  { return m_first ? entry_row(m_first) : NULL; }
+  uchar *next_row(uchar *row) const
+  {
+    const Entry *const next= row_entry(row)->next;
+    return next ? entry_row(next) : NULL;
+  }
+
+  /** Free all the memory */
+  void free();
+
+private:
+  struct Entry
+  {
+    Entry *next;
+    uint32 hash;
+  };
+
+  /* An entry is followed by the group key and then by the row */
+  uchar *entry_key(const Entry *entry) const
+  { return (uchar *) (entry + 1); }
+  uchar *entry_row(const Entry *entry) const
+  { return entry_key(entry) + m_key_length; }
+  Entry *row_entry(uchar *row) const
+  { return ((Entry *) (row - m_key_length)) - 1; }
+
+  bool keys_equal(const uchar *key) const;
+  bool grow();
+
+  TABLE *m_table;
+  uchar *m_key;
+  uint m_key_length;
+  MEM_ROOT m_mem_root;
+  Entry **m_slots;
+  size_t m_capacity;
+  size_t m_count;
+  ulonglong m_size;
+  ulonglong m_max_size;
+  Entry *m_first;
+  Entry *m_last;
+};
+
+
 /**
   @brief
     Class for accumulating join result in a tmp table, grouping them if
@@ -226,6 +385,8 @@ public:
                          table. Input records aren't expected to be sorted.
                          Tmp table uses the heap engine
       end_update_unique  Same as above, but the engine is myisam.
+    When the optimizer_switch flag hash_group_by is on, end_update keeps
+    the groups in a Group_hash_table until they don't fit in memory.
 
     Lazy table initialization is used - the table will be instantiated and
     rnd/index scan started on the first put_record() call.
@@ -253,10 +414,14 @@ public:
   {
     write_func= new_write_func;
   }
+  Group_hash_table *get_group_table() { return &group_table; }
+  void free() { group_table.free(); }
 
 private:
   /** Write function that would be used for saving records in tmp table. */
   Next_select_func write_func;
+  /** Groups aggregated in memory by end_update() */
+  Group_hash_table group_table;
   enum_nested_loop_state put_record(bool end_of_records);
   MY_ATTRIBUTE((warn_unused_result))
   bool prepare_tmp_table();
@@ -526,6 +526,62 @@ int JOIN_CACHE_BNL::init()
 }
 
 
+/*
+  Initialize a hash join cache
+
+  SYNOPSIS
+    init()
+
+  DESCRIPTION
+    The function initializes the cache structure as JOIN_CACHE_BNL::init
+    does. Besides it finds the equalities the records put into the join
+    buffer are hashed on, and places the hash entries at the end of the
+    join buffer. The size of the buffer is limited to what the 32 bit
+    offsets of the hash entries can address.
+
+  RETURN
+    0   initialization with buffer allocations has been succeeded
+    1   otherwise
+*/
+
+int JOIN_CACHE_HASH::init()
+{
+  DBUG_ENTER("JOIN_CACHE_HASH::init");
+
+  key_parts= find_key_fields(join_tab, NULL, NULL);
+  if (!key_parts)
+    DBUG_RETURN(1);
+  if (!(outer_key_fields= (Field **) sql_alloc(2 * key_parts *
+                                               sizeof(Field *))))
+    DBUG_RETURN(1);
+  inner_key_fields= outer_key_fields + key_parts;
+  find_key_fields(join_tab, outer_key_fields, inner_key_fields);
+
+  calc_record_fields();
+
+  if (alloc_fields(0))
+    DBUG_RETURN(1);
+
+  create_flag_fields();
+
+  create_remaining_fields(TRUE);
+
+  set_constants();
+
+  buff_size= std::min<ulong>(buff_size, UINT_MAX32);
+  buff_size-= buff_size % sizeof(Hash_entry);
+
+  if (alloc_buffer())
+    DBUG_RETURN(1);
+
+  hash_entries_end= reinterpret_cast<Hash_entry *>(buff + buff_size);
+
+  reset_cache(true);
+
+  DBUG_RETURN(0);
+}
+
+
 /* 
   Initialize a BKA cache       
 
@@ -1916,6 +1972,373 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
   return rc;
 }
 
+
+/*
+  Check whether equal values of two fields always have equal hashes
+
+  SYNOPSIS
+    hash_join_comparable()
+      a, b   the fields of an equality
+
+  DESCRIPTION
+    The values of integer fields are hashed as 64 bit integers, so both
+    fields must be of integer types of the same signedness. The values of
+    string fields are hashed with the collation of their character set, so
+    both fields must be of string types with the same collation. Other types
+    are compared in ways the hashes don't follow and are not supported.
+
+  RETURN
+    TRUE   the equality of the fields can be used for a hash join
+    FALSE  otherwise
+*/
+
+static bool hash_join_comparable(const Field *a, const Field *b)
+{
+  const Field *fields[2]= { a, b };
+  uint int_fields= 0;
+  uint string_fields= 0;
+
+  for (uint i= 0; i < 2; i++)
+  {
+    switch (fields[i]->real_type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+      int_fields++;
+      break;
+    case MYSQL_TYPE_VARCHAR:
+    case MYSQL_TYPE_VAR_STRING:
+    case MYSQL_TYPE_STRING:
+    case MYSQL_TYPE_BLOB:
+      string_fields++;
+      break;
+    default:
+      return FALSE;
+    }
+  }
+  if (int_fields == 2)
+    return (a->flags & UNSIGNED_FLAG) == (b->flags & UNSIGNED_FLAG);
+  if (string_fields == 2)
+    return a->charset() == b->charset();
+  return FALSE;
+}
+
+
+/*
+  Collect the equalities of a condition that a hash join can use
+
+  SYNOPSIS
+    collect_hash_join_equalities()
+      cond          the condition to look into
+      tab           the joined table
+      outer_fields  OUT the fields of the previous tables, or NULL
+      inner_fields  OUT the fields of the joined table, or NULL
+      parts         IN/OUT the number of the equalities found so far
+
+  DESCRIPTION
+    The function looks into the conjuncts of 'cond'. The condition guarded
+    by the trigger that is on while the matches for the records of the join
+    buffer are searched for is looked into as well when 'tab' is the first
+    inner table of an outer join.
+*/
+
+static void collect_hash_join_equalities(Item *cond, JOIN_TAB *tab,
+                                         Field **outer_fields,
+                                         Field **inner_fields, uint *parts)
+{
+  if (*parts == MAX_REF_PARTS)
+    return;
+
+  if (cond->type() == Item::COND_ITEM)
+  {
+    if (((Item_cond *) cond)->functype() != Item_func::COND_AND_FUNC)
+      return;
+    List_iterator<Item> li(*((Item_cond *) cond)->argument_list());
+    Item *item;
+    while ((item= li++))
+      collect_hash_join_equalities(item, tab, outer_fields, inner_fields,
+                                   parts);
+    return;
+  }
+
+  if (cond->type() != Item::FUNC_ITEM)
+    return;
+
+  Item_func *const func= (Item_func *) cond;
+  if (func->functype() == Item_func::TRIG_COND_FUNC)
+  {
+    if (tab->first_inner == tab &&
+        ((Item_func_trig_cond *) func)->get_trig_var() ==
+        &tab->not_null_compl)
+      collect_hash_join_equalities(func->arguments()[0], tab, outer_fields,
+                                   inner_fields, parts);
+    return;
+  }
+
+  if (func->functype() != Item_func::EQ_FUNC)
+    return;
+
+  Item *inner= func->arguments()[0]->real_item();
+  Item *outer= func->arguments()[1]->real_item();
+  if (inner->type() != Item::FIELD_ITEM || outer->type() != Item::FIELD_ITEM)
+    return;
+  if (((Item_field *) outer)->field->table == tab->table)
+    std::swap(inner, outer);
+
+  Field *const inner_field= ((Item_field *) inner)->field;
+  Field *const outer_field= ((Item_field *) outer)->field;
+  if (inner->used_tables() != tab->table->map ||
+      outer->used_tables() != outer_field->table->map ||
+      outer_field->table == tab->table ||
+      !(outer->used_tables() & tab->prefix_tables()) ||
+      !hash_join_comparable(inner_field, outer_field))
+    return;
+
+  if (outer_fields)
+  {
+    outer_fields[*parts]= outer_field;
+    inner_fields[*parts]= inner_field;
+  }
+  (*parts)++;
+}
+
+
+/*
+  Find the equalities of the condition of a table a hash join can use
+
+  SYNOPSIS
+    find_key_fields()
+      tab           the joined table
+      outer_fields  OUT the fields of the previous tables, or NULL
+      inner_fields  OUT the fields of the joined table, or NULL
+
+  DESCRIPTION
+    The function looks for the conjuncts of the condition attached to 'tab'
+    that are equalities between a field of 'tab' and a field of a previous
+    table whose equal values have equal hashes. If the arrays are not NULL
+    the fields of the equalities are stored into them. At most MAX_REF_PARTS
+    equalities are used.
+
+  RETURN
+    the number of the found equalities
+*/
+
+uint JOIN_CACHE_HASH::find_key_fields(JOIN_TAB *tab, Field **outer_fields,
+                                      Field **inner_fields)
+{
+  uint parts= 0;
+  if (tab->condition())
+    collect_hash_join_equalities(tab->condition(), tab, outer_fields,
+                                 inner_fields, &parts);
+  return parts;
+}
+
+
+/*
+  Calculate the hash of the values of key fields in the record buffers
+
+  SYNOPSIS
+    hash_key()
+      key_fields  the fields whose values are hashed
+      hash        OUT the hash of the values
+
+  DESCRIPTION
+    Integers are hashed as 64 bit values and strings with the collation
+    of their character set, so values that are equal when compared by the
+    equalities have equal hashes.
+
+  RETURN
+    TRUE   one of the values is NULL, so the equalities can't be true
+    FALSE  otherwise
+*/
+
+bool JOIN_CACHE_HASH::hash_key(Field **key_fields, uint32 *hash)
+{
+  ulong nr1= 1, nr2= 4;
+  for (uint i= 0; i < key_parts; i++)
+  {
+    Field *const field= key_fields[i];
+    if (field->is_null())
+      return TRUE;
+    if (field->result_type() == INT_RESULT)
+    {
+      uchar value[8];
+      int8store(value, field->val_int());
+      my_charset_bin.coll->hash_sort(&my_charset_bin, value, sizeof(value),
+                                     &nr1, &nr2);
+    }
+    else
+    {
+      const String *const str= field->val_str(&key_value);
+      const CHARSET_INFO *const cs= field->charset();
+      cs->coll->hash_sort(cs, (const uchar *) str->ptr(), str->length(),
+                          &nr1, &nr2);
+    }
+  }
+  *hash= (uint32) nr1;
+  return FALSE;
+}
+
+
+/*
+  Reset the join buffer of a hash join cache for reading/writing
+
+  SYNOPSIS
+    reset_cache()
+      for_writing  if it's TRUE the function reset the buffer for writing
+
+  DESCRIPTION
+    Besides what JOIN_CACHE::reset_cache does the function drops the hash
+    entries when the buffer is reset for writing.
+*/
+
+void JOIN_CACHE_HASH::reset_cache(bool for_writing)
+{
+  JOIN_CACHE::reset_cache(for_writing);
+  if (for_writing)
+  {
+    hash_entry_count= 0;
+    last_rec_has_entry= false;
+  }
+}
+
+
+/*
+  Add a record into the join buffer of a hash join cache
+
+  SYNOPSIS
+    put_record_in_cache()
+
+  DESCRIPTION
+    The function writes the record into the join buffer as the default
+    implementation does and adds the hash entry for it unless its key
+    contains a NULL value.
+
+  RETURN
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_HASH::put_record_in_cache()
+{
+  const bool is_full= JOIN_CACHE::put_record_in_cache();
+  uint32 hash;
+  last_rec_has_entry= !hash_key(outer_key_fields, &hash);
+  if (last_rec_has_entry)
+  {
+    Hash_entry *const entry= hash_entries_end - ++hash_entry_count;
+    entry->hash= hash;
+    entry->offset= (uint32) (curr_rec_pos - buff);
+  }
+  return is_full;
+}
+
+
+/*
+  Using the hash entries find matches from the next table for records
+  from the join buffer
+
+  SYNOPSIS
+    join_matching_records()
+      skip_last    do not look for matches for the last partial join record
+
+  DESCRIPTION
+    The function works as JOIN_CACHE_BNL::join_matching_records does, but
+    it first sorts the hash entries of the records by their hashes. Then
+    each row of the joined table is checked only against the records whose
+    hash is the hash of the values of its key fields. The entries with the
+    same hash are sorted by the offsets of their records, so the matches
+    are generated in the same order as with JOIN_CACHE_BNL.
+
+  RETURN
+    return one of enum_nested_loop_state.
+*/
+
+enum_nested_loop_state JOIN_CACHE_HASH::join_matching_records(bool skip_last)
+{
+  int error;
+  READ_RECORD *info;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  SQL_SELECT *select= join_tab->cache_select;
+
+  join_tab->table->null_row= 0;
+
+  /* Return at once if there are no records in the join buffer */
+  if (!records)
+    return NESTED_LOOP_OK;
+
+  if (skip_last)
+    put_record_in_cache();
+
+  /* The entry of the last record is left out if it's to be skipped */
+  Hash_entry *const entries= hash_entries_end - hash_entry_count +
+                             MY_TEST(skip_last && last_rec_has_entry);
+  std::sort(entries, hash_entries_end);
+
+  if (join_tab->use_quick == QS_DYNAMIC_RANGE && join_tab->select->quick)
+    /* A dynamic range access was used last. Clean up after it */
+    join_tab->select->set_quick(NULL);
+
+  /* Start retrieving all records of the joined table */
+  if ((error= (*join_tab->read_first_record)(join_tab)))
+    return error < 0 ? NESTED_LOOP_OK : NESTED_LOOP_ERROR;
+
+  info= &join_tab->read_record;
+  do
+  {
+    if (join_tab->keep_current_rowid)
+      join_tab->table->file->position(join_tab->table->record[0]);
+
+    if (join->thd->killed)
+    {
+      /* The user has aborted the execution of the query */
+      join->thd->send_kill_message();
+      return NESTED_LOOP_KILLED;
+    }
+
+    /*
+      Do not look for matches if the last read record of the joined table
+      does not meet the conditions that have been pushed to this table
+    */
+    bool skip_record;
+    bool consider_record= (!select ||
+                           (!select->skip_record(join->thd, &skip_record) &&
+                            !skip_record));
+    if (select && join->thd->is_error())
+      return NESTED_LOOP_ERROR;
+
+    uint32 hash;
+    if (consider_record && !hash_key(inner_key_fields, &hash))
+    {
+      const Hash_entry key= { hash, 0 };
+      for (const Hash_entry *entry= std::lower_bound(entries,
+                                                     hash_entries_end, key);
+           entry < hash_entries_end && entry->hash == hash;
+           entry++)
+      {
+        uchar *const rec_ptr= buff + entry->offset;
+        /*
+          If only the first match is needed and it has been already found
+          for the record then the record is skipped.
+        */
+        if (check_only_first_match && get_match_flag_by_pos(rec_ptr))
+          continue;
+        get_record_by_pos(rec_ptr);
+        rc= generate_full_extensions(rec_ptr);
+        if (rc != NESTED_LOOP_OK)
+          return rc;
+      }
+    }
+  } while (!(error= info->read_record(info)));
+
+  if (error > 0)				// Fatal error
+    rc= NESTED_LOOP_ERROR;
+  return rc;
+}
+
      
 /*
   Set match flag for a record in join buffer if it has not been set yet    
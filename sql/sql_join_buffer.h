@@ -511,9 +511,11 @@ public:
   }
 
   /** Bits describing cache's type @sa setup_join_buffering() */
-  enum {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4};
+  enum {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4,
+        ALG_HASH= 8};
 
   friend class JOIN_CACHE_BNL;
+  friend class JOIN_CACHE_HASH;
   friend class JOIN_CACHE_BKA;
   friend class JOIN_CACHE_BKA_UNIQUE;
 };
@@ -536,6 +538,94 @@ public:
 
 };
 
+
+/*
+  The class JOIN_CACHE_HASH supports a variant of the Block Nested Loop join
+  algorithm for equi-joins. The records put into the join buffer are hashed
+  on the values of the outer fields of the equalities that join them to the
+  rows of the next table. The hash entries are kept in the auxiliary buffer
+  at the end of the join buffer. When the join buffer is full the entries
+  are sorted, and each row of the next table is joined only with the records
+  whose hash is the hash of the values of its inner fields, instead of with
+  every record of the join buffer.
+
+  A record whose key contains a NULL value has no hash entry since the
+  equalities can't be true for it. The full join condition is checked for
+  every candidate record, so hash collisions don't produce wrong matches.
+  The records are still joined in the order in which they are put into the
+  buffer, so the result is the same as with JOIN_CACHE_BNL.
+
+  As with JOIN_CACHE_BNL, when the join buffer fills up the matches for the
+  buffered records are found with one more scan of the next table.
+*/
+
+class JOIN_CACHE_HASH :public JOIN_CACHE_BNL
+{
+  /* An entry of the hash table: the hash of a record and its offset */
+  struct Hash_entry
+  {
+    uint32 hash;
+    uint32 offset;
+
+    bool operator<(const Hash_entry &other) const
+    {
+      return hash < other.hash ||
+             (hash == other.hash && offset < other.offset);
+    }
+  };
+
+  /* The number of the equalities the records are hashed on */
+  uint key_parts;
+  /* The fields of the previous tables in the equalities */
+  Field **outer_key_fields;
+  /* The fields of the joined table in the equalities */
+  Field **inner_key_fields;
+
+  /* The end of the hash entries that grow down from the end of the buffer */
+  Hash_entry *hash_entries_end;
+  /* The number of hash entries in the buffer */
+  uint hash_entry_count;
+  /* Set if the last record put into the buffer has got a hash entry */
+  bool last_rec_has_entry;
+
+  /* Buffer for the string values of the fields that are hashed */
+  String key_value;
+
+  bool hash_key(Field **key_fields, uint32 *hash);
+
+protected:
+
+  uint aux_buffer_min_size() const { return 2 * sizeof(Hash_entry); }
+
+  /* Leave room for the hash entries of this record and the next one */
+  ulong rem_space()
+  {
+    const ulong used= (end_pos - buff) +
+                      (hash_entry_count + 2) * sizeof(Hash_entry);
+    return buff_size > used ? buff_size - used : 0;
+  }
+
+  bool put_record_in_cache();
+
+  /* Using the hash entries find matches for records from join buffer */
+  enum_nested_loop_state join_matching_records(bool skip_last);
+
+public:
+  JOIN_CACHE_HASH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev)
+    : JOIN_CACHE_BNL(j, tab, prev), key_parts(0), outer_key_fields(NULL),
+    inner_key_fields(NULL), hash_entries_end(NULL), hash_entry_count(0),
+    last_rec_has_entry(false)
+  {}
+
+  /* Initialize the hash join cache */
+  int init();
+
+  void reset_cache(bool for_writing);
+
+  static uint find_key_fields(JOIN_TAB *tab, Field **outer_fields,
+                              Field **inner_fields);
+};
+
 class JOIN_CACHE_BKA :public JOIN_CACHE
 {
 protected:
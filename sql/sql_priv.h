@@ -242,7 +242,10 @@ template <class T> bool valid_buffer_range(T jump,
 /** The following two work similar to MRR. See above comments. */
 #define OPTIMIZER_SKIP_SCAN                        (1ULL << 16)
 #define OPTIMIZER_SKIP_SCAN_COST_BASED             (1ULL << 17)
-#define OPTIMIZER_SWITCH_LAST                      (1ULL << 18)
+#define OPTIMIZER_SWITCH_HASH_JOIN                 (1ULL << 18)
+#define OPTIMIZER_SWITCH_HASH_GROUP_BY             (1ULL << 19)
+#define OPTIMIZER_SWITCH_BATCHED_CONDITION         (1ULL << 20)
+#define OPTIMIZER_SWITCH_LAST                      (1ULL << 21)
 
 /**
    If OPTIMIZER_SWITCH_ALL is defined, optimizer_switch flags for newer 
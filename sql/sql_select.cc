@@ -1273,7 +1273,11 @@ static uint join_buffer_alg(const THD *thd)
   uint alg= JOIN_CACHE::ALG_NONE;
 
   if (thd->optimizer_switch_flag(OPTIMIZER_SWITCH_BNL))
+  {
     alg|= JOIN_CACHE::ALG_BNL;
+    if (thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN))
+      alg|= JOIN_CACHE::ALG_HASH;
+  }
 
   if (thd->optimizer_switch_flag(OPTIMIZER_SWITCH_BKA))
   {
@@ -2552,6 +2556,25 @@ static bool setup_join_buffering(JOIN_TAB *tab, JOIN *join,
       goto no_join_cache;
     }
 
+    /*
+      Hash the records of the join buffer when the table is joined to them
+      with equalities that a hash join can use.
+    */
+    if (join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN) &&
+        JOIN_CACHE_HASH::find_key_fields(tab, NULL, NULL))
+    {
+      if ((options & SELECT_DESCRIBE) ||
+          ((tab->op= new JOIN_CACHE_HASH(join, tab, prev_cache)) &&
+           !tab->op->init()))
+      {
+        *icp_other_tables_ok= FALSE;
+        DBUG_ASSERT(might_do_join_buffering(join_buffer_alg(join->thd), tab));
+        tab->use_join_cache= JOIN_CACHE::ALG_HASH;
+        return false;
+      }
+      goto no_join_cache;
+    }
+
     if ((options & SELECT_DESCRIBE) ||
         ((tab->op= new JOIN_CACHE_BNL(join, tab, prev_cache)) &&
          !tab->op->init()))
@@ -2877,6 +2900,8 @@ make_join_readinfo(JOIN *join, ulonglong options, uint no_jbuf_after)
         DBUG_RETURN(true);
       if (tab->use_join_cache != JOIN_CACHE::ALG_NONE)
         tab[-1].next_select=sub_select_op;
+      if (tab->use_join_cache == JOIN_CACHE::ALG_HASH)
+        trace_refine_table.add("hash_join", true);
 
       /* These init changes read_record */
       if (tab->use_quick == QS_DYNAMIC_RANGE)
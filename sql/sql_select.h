@@ -742,6 +742,9 @@ public:
   /* Sorting related info */
   Filesort *filesort;
 
+  /** Rows read ahead by scans of the table, see Row_batch */
+  Row_batch *row_batch;
+
   /**
     List of topmost expressions in the select list. The *next* JOIN TAB
     in the plan should use it to obtain correct values. Same applicable to
@@ -969,6 +972,7 @@ st_join_table::st_join_table()
     embedding_map(0),
     tmp_table_param(NULL),
     filesort(NULL),
+    row_batch(NULL),
     fields(NULL),
     all_fields(NULL),
     ref_array(NULL),
@@ -2599,7 +2599,7 @@ static const char *optimizer_switch_names[]=
   "subquery_materialization_cost_based",
 #endif
   "use_index_extensions", "skip_scan", "skip_scan_cost_based",
-  "default", NullS
+  "hash_join", "hash_group_by", "batched_condition", "default", NullS
 };
 /** propagates changes to @@engine_condition_pushdown */
 static bool fix_optimizer_switch(sys_var *self, THD *thd,
@@ -2622,7 +2622,8 @@ static Sys_var_flagset Sys_optimizer_switch(
        " subquery_materialization_cost_based"
 #endif
        ", block_nested_loop, batched_key_access, use_index_extensions"
-       ", skip_scan, skip_scan_cost_based"
+       ", skip_scan, skip_scan_cost_based, hash_join, hash_group_by"
+       ", batched_condition"
        "} and val is one of {on, off, default}",
        SESSION_VAR(optimizer_switch), CMD_LINE(REQUIRED_ARG),
        optimizer_switch_names, DEFAULT(OPTIMIZER_SWITCH_DEFAULT),
@@ -3486,6 +3487,15 @@ static Sys_var_ulong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, ULONG_MAX), DEFAULT(DEFAULT_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_filesort_threads(
+       "filesort_threads",
+       "Number of threads that sort the keys of one filesort buffer. "
+       "1 sorts them in the thread of the query. Sorts get fewer threads "
+       "while the server already runs "
+       STRINGIFY_ARG(MAX_FILESORT_THREADS) " sort worker threads",
+       SESSION_VAR(filesort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_FILESORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 void sql_mode_deprecation_warnings(sql_mode_t sql_mode)
 {
   /**
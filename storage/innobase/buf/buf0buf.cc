@@ -644,14 +644,15 @@ buf_page_is_checksum_valid_none(
 }
 
 /********************************************************************//**
-Checks if a page is corrupt.
+Checks if a page is corrupt, comparing its LSN with a system LSN that
+the caller has read.
 @return	TRUE if corrupted */
-UNIV_INTERN
+static
 ibool
-buf_page_is_corrupted(
-/*==================*/
-	bool		check_lsn,	/*!< in: true if we need to check
-					and complain about the LSN */
+buf_page_is_corrupted_low(
+/*======================*/
+	lsn_t		current_lsn,	/*!< in: current system LSN, or 0
+					if the page LSN is not checked */
 	const byte*	read_buf,	/*!< in: a database page */
 	ulint		zip_size)	/*!< in: size of compressed page;
 					0 for uncompressed pages */
@@ -681,15 +682,8 @@ buf_page_is_corrupted(
 	}
 
 #ifndef UNIV_HOTBACKUP
-	if (check_lsn && recv_lsn_checks_on) {
-		lsn_t	current_lsn;
-
-		/* Since we are going to reset the page LSN during the import
-		phase it makes no sense to spam the log with error messages. */
-
-		if (log_peek_lsn(&current_lsn)
-		    && current_lsn
-		    < mach_read_from_8(read_buf + FIL_PAGE_LSN)) {
+	if (current_lsn != 0) {
+		if (current_lsn < mach_read_from_8(read_buf + FIL_PAGE_LSN)) {
 			ut_print_timestamp(stderr);
 
 			fprintf(stderr,
@@ -906,6 +900,84 @@ FIL_PAGE_END_LSN_OLD_CHKSUM == 0 */
 	return(FALSE);
 }
 
+/********************************************************************//**
+Reads the current system LSN that the LSN of pages read from disk
+is checked against.
+@return	current LSN, or 0 if the LSN should not be checked */
+static
+lsn_t
+buf_page_check_lsn(
+/*===============*/
+	bool	check_lsn)	/*!< in: true if we need to check
+				and complain about the LSN */
+{
+	lsn_t	current_lsn = 0;
+
+#ifndef UNIV_HOTBACKUP
+	/* Since we are going to reset the page LSN during the import
+	phase it makes no sense to spam the log with error messages. */
+
+	if (check_lsn && recv_lsn_checks_on
+	    && !log_peek_lsn(&current_lsn)) {
+		current_lsn = 0;
+	}
+#endif /* !UNIV_HOTBACKUP */
+
+	return(current_lsn);
+}
+
+/********************************************************************//**
+Checks if a page is corrupt.
+@return	TRUE if corrupted */
+UNIV_INTERN
+ibool
+buf_page_is_corrupted(
+/*==================*/
+	bool		check_lsn,	/*!< in: true if we need to check
+					and complain about the LSN */
+	const byte*	read_buf,	/*!< in: a database page */
+	ulint		zip_size)	/*!< in: size of compressed page;
+					0 for uncompressed pages */
+{
+	return(buf_page_is_corrupted_low(
+		       buf_page_check_lsn(check_lsn), read_buf, zip_size));
+}
+
+/********************************************************************//**
+Checks a batch of pages of the same size for corruption. The system
+LSN is read once for the whole batch, and the checksums of consecutive
+pages are computed back to back.
+@return	number of corrupted pages */
+UNIV_INTERN
+ulint
+buf_page_is_corrupted_batch(
+/*========================*/
+	bool			check_lsn,	/*!< in: true if we need to
+						check and complain about
+						the LSN */
+	const byte* const*	pages,		/*!< in: database pages */
+	ulint			n_pages,	/*!< in: number of pages */
+	ulint			zip_size,	/*!< in: size of compressed
+						pages; 0 for uncompressed
+						pages */
+	bool*			corrupted)	/*!< out: corrupted[i] is set
+						if pages[i] is corrupted */
+{
+	const lsn_t	current_lsn = buf_page_check_lsn(check_lsn);
+	ulint		n_corrupted = 0;
+
+	for (ulint i = 0; i < n_pages; i++) {
+		corrupted[i] = buf_page_is_corrupted_low(
+			current_lsn, pages[i], zip_size);
+
+		if (corrupted[i]) {
+			n_corrupted++;
+		}
+	}
+
+	return(n_corrupted);
+}
+
 /********************************************************************//**
 Prints a page to stderr. */
 UNIV_INTERN
@@ -2319,6 +2391,40 @@ buf_pool_withdraw_blocks(
 	return(false);
 }
 
+/** Number of slots in buf_page_hash_optimistic_active[] */
+#define BUF_PAGE_HASH_OPTIMISTIC_SLOTS		64
+
+/** Counts of buf_page_hash_get_optimistic() calls in progress, spread
+over cache lines by thread id. buf_pool_resize() waits for all of them
+to drop to zero after setting buf_pool_resizing, before it frees chunks
+or replaces buf_pool->chunks and the page_hash. */
+static struct {
+	volatile lint	n_active;	/*!< lookups in progress */
+	byte		pad[64];	/*!< padding */
+} buf_page_hash_optimistic_active[BUF_PAGE_HASH_OPTIMISTIC_SLOTS];
+
+/********************************************************************//**
+Checks if any buf_page_hash_get_optimistic() call is in progress.
+@return true if some thread may still be walking the page_hash or the
+chunks without a latch */
+static
+bool
+buf_page_hash_optimistic_is_active(void)
+/*====================================*/
+{
+	for (ulint i = 0; i < BUF_PAGE_HASH_OPTIMISTIC_SLOTS; i++) {
+		/* The atomic read-modify-write orders the read after
+		the store of buf_pool_resizing. */
+		if (os_atomic_increment_lint(
+			    &buf_page_hash_optimistic_active[i].n_active,
+			    0) != 0) {
+
+			return(true);
+		}
+	}
+
+	return(false);
+}
 
 /** resize page_hash and zip_hash for a buffer pool instance.
 @param[in]	buf_pool	buffer pool instance */
@@ -2464,12 +2570,12 @@ buf_pool_resize()
 
 	buf_resize_status("Disabling adaptive hash index.");
 
-	rw_lock_s_lock(&btr_search_latch);
+	btr_search_s_lock_all();
 	if (btr_search_enabled) {
-		rw_lock_s_unlock(&btr_search_latch);
+		btr_search_s_unlock_all();
 		btr_search_disabled = true;
 	} else {
-		rw_lock_s_unlock(&btr_search_latch);
+		btr_search_s_unlock_all();
 	}
 
 	btr_search_disable();
@@ -2822,6 +2928,12 @@ wait_lock_empty:
 		goto abort_resize;
 	}
 
+	/* Wait for the optimistic page_hash lookups that started before
+	buf_pool_resizing was set. New ones see it and take the latches. */
+	while (buf_page_hash_optimistic_is_active()) {
+		os_thread_sleep(1000);
+	}
+
 	/* Acquire all buf_pool_mutex/hash_lock */
 	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
 		buf_pool_t*	buf_pool = buf_pool_from_array(i);
@@ -3164,7 +3276,7 @@ buf_pool_clear_hash_index(void)
 	ulint	p;
 
 #ifdef UNIV_SYNC_DEBUG
-	ut_ad(rw_lock_own(&btr_search_latch, RW_LOCK_EX));
+	ut_ad(btr_search_own_all(RW_LOCK_EX));
 #endif /* UNIV_SYNC_DEBUG */
 	ut_ad(!buf_pool_forbidden);
 	ut_ad(!btr_search_enabled);
@@ -3182,7 +3294,8 @@ buf_pool_clear_hash_index(void)
 				dict_index_t*	index	= block->index;
 
 				/* We can set block->index = NULL
-				when we have an x-latch on btr_search_latch;
+				when we have an x-latch on all of
+				btr_search_latches;
 				see the comment in buf0buf.h */
 
 				if (!index) {
@@ -4223,12 +4336,26 @@ buf_block_is_uncompressed(
 	const buf_block_t*	block)		/*!< in: pointer to block,
 						not dereferenced */
 {
-	if ((((ulint) block) % sizeof *block) != 0) {
-		/* The pointer should be aligned. */
-		return(FALSE);
+	const buf_chunk_t*		chunk	= buf_pool->chunks;
+	const buf_chunk_t* const	echunk	= chunk + buf_pool->n_chunks;
+
+	ut_ad(!buf_pool_forbidden);
+
+	while (chunk < echunk) {
+		if (block >= chunk->blocks
+		    && block < chunk->blocks + chunk->size) {
+
+			/* The pointer should be aligned on a
+			buf_block_t of the chunk. */
+			return((((const byte*) block
+				 - (const byte*) chunk->blocks)
+				% sizeof *block) == 0);
+		}
+
+		chunk++;
 	}
 
-	return(buf_pointer_is_block_field_instance(buf_pool, (void*) block));
+	return(FALSE);
 }
 
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
@@ -4294,6 +4421,132 @@ buf_wait_for_read(buf_block_t* block)
 	}
 }
 
+/** Maximum number of page_hash chain nodes that
+buf_page_hash_get_optimistic() visits before giving up */
+#define BUF_PAGE_HASH_OPTIMISTIC_MAX_CHAIN	16
+
+/********************************************************************//**
+Looks up and buffer-fixes a resident file page for
+buf_page_hash_get_optimistic(), which keeps buf_pool_resize() from
+freeing the memory that is walked here.
+@return buffer-fixed block, or NULL if the page_hash must be searched
+under its lock */
+static
+buf_block_t*
+buf_page_hash_get_optimistic_low(
+/*=============================*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	ulint		space,		/*!< in: space id */
+	ulint		offset,		/*!< in: page number */
+	ulint		fold,		/*!< in: buf_page_address_fold() */
+	buf_block_t*	guess)		/*!< in: guessed block or NULL */
+{
+	buf_block_t*	block = guess;
+
+	if (block == NULL || !buf_block_is_uncompressed(buf_pool, block)) {
+		hash_table_t*	page_hash = buf_pool->page_hash;
+		buf_page_t*	bpage;
+		ulint		n_visited = 0;
+
+		bpage = static_cast<buf_page_t*>(HASH_GET_FIRST(
+				page_hash, hash_calc_hash(fold, page_hash)));
+
+		for (;;) {
+			if (bpage == NULL
+			    || ++n_visited > BUF_PAGE_HASH_OPTIMISTIC_MAX_CHAIN
+			    || !buf_block_is_uncompressed(
+				    buf_pool,
+				    reinterpret_cast<buf_block_t*>(bpage))) {
+
+				return(NULL);
+			}
+
+			if (bpage->offset == offset && bpage->space == space) {
+				break;
+			}
+
+			bpage = static_cast<buf_page_t*>(
+				HASH_GET_NEXT(hash, bpage));
+		}
+
+		block = reinterpret_cast<buf_block_t*>(bpage);
+	}
+
+	/* Suppress Valgrind warnings about conditional jump
+	on uninitialized value. */
+	UNIV_MEM_VALID(&block->page.space, sizeof(block->page.space));
+	UNIV_MEM_VALID(&block->page.offset, sizeof(block->page.offset));
+
+	mutex_enter(&block->mutex);
+
+	if (buf_pool_resizing
+	    || buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
+	    || block->page.offset != offset
+	    || block->page.space != space) {
+
+		mutex_exit(&block->mutex);
+
+		return(NULL);
+	}
+
+	ut_ad(block->page.in_page_hash);
+	ut_ad(!block->page.in_zip_hash);
+
+#ifdef PAGE_ATOMIC_REF_COUNT
+	os_atomic_increment_uint32(&block->page.buf_fix_count, 1);
+#else
+	++block->page.buf_fix_count;
+#endif /* PAGE_ATOMIC_REF_COUNT */
+
+	mutex_exit(&block->mutex);
+
+	return(block);
+}
+
+/********************************************************************//**
+Looks up a resident file page without acquiring the page_hash lock.
+The hash chain is walked without any latch, following only control
+blocks that belong to the buffer pool chunks. The lookup is counted in
+buf_page_hash_optimistic_active[] and skipped while buf_pool_resizing is
+set, so buf_pool_resize() cannot free that memory under us. A matching
+block is confirmed and buffer-fixed under its block mutex:
+buf_LRU_free_page() and buf_page_realloc() hold that mutex from the
+moment they find the block unfixed until they have removed it from the
+page_hash, so the block cannot be evicted or relocated under us.
+Compressed-only pages and watch sentinels are left to the locked
+lookup.
+@return buffer-fixed block, or NULL if the page_hash must be searched
+under its lock */
+static
+buf_block_t*
+buf_page_hash_get_optimistic(
+/*=========================*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
+	ulint		space,		/*!< in: space id */
+	ulint		offset,		/*!< in: page number */
+	ulint		fold,		/*!< in: buf_page_address_fold() */
+	buf_block_t*	guess)		/*!< in: guessed block or NULL */
+{
+	/* Thread ids are addresses at the same offset in different
+	thread stacks, so the page offset bits are dropped. */
+	volatile lint*	n_active = &buf_page_hash_optimistic_active[
+		(os_thread_pf(os_thread_get_curr_id()) >> 12)
+		% BUF_PAGE_HASH_OPTIMISTIC_SLOTS].n_active;
+
+	/* The increment is a full barrier: either buf_pool_resize()
+	sees it and waits for us, or we see buf_pool_resizing. */
+	os_atomic_increment_lint(n_active, 1);
+
+	buf_block_t*	block = buf_pool_resizing
+		? NULL
+		: buf_page_hash_get_optimistic_low(
+			buf_pool, space, offset, fold, guess);
+
+	os_atomic_decrement_lint(n_active, 1);
+
+	return(block);
+}
+
 /********************************************************************//**
 This is the general function used to get access to a database page.
 @return	pointer to the block or NULL */
@@ -4354,6 +4607,16 @@ buf_page_get_gen(
 	buf_pool->stat.n_page_gets++;
 	fold = buf_page_address_fold(space, offset);
 	hash_lock = buf_page_hash_lock_get(buf_pool, fold);
+
+	if (srv_page_hash_optimistic_lookup) {
+		fix_block = buf_page_hash_get_optimistic(
+			buf_pool, space, offset, fold, guess);
+
+		if (fix_block != NULL) {
+			block = fix_block;
+			goto got_block;
+		}
+	}
 loop:
 	block = guess;
 
@@ -6960,6 +7223,12 @@ buf_stats_aggregate_pool_info(
 	total_info->n_flushed_list += pool_info->n_flushed_list;
 	total_info->n_flushed_single_page +=
 		pool_info->n_flushed_single_page;
+
+	total_info->n_lru_batches += pool_info->n_lru_batches;
+	total_info->lru_batch_time += pool_info->lru_batch_time;
+	total_info->n_flush_list_batches += pool_info->n_flush_list_batches;
+	total_info->flush_list_batch_time +=
+		pool_info->flush_list_batch_time;
 }
 /*******************************************************************//**
 Collect buffer pool stats information for a buffer pool. Also
@@ -7037,6 +7306,16 @@ buf_stats_get_pool_info(
 	pool_info->n_flushed_single_page =
 		 buf_pool->n_flushed[BUF_FLUSH_SINGLE_PAGE];
 
+	pool_info->n_lru_batches = buf_pool->n_flush_batches[BUF_FLUSH_LRU];
+
+	pool_info->lru_batch_time = buf_pool->flush_batch_time[BUF_FLUSH_LRU];
+
+	pool_info->n_flush_list_batches =
+		buf_pool->n_flush_batches[BUF_FLUSH_LIST];
+
+	pool_info->flush_list_batch_time =
+		buf_pool->flush_batch_time[BUF_FLUSH_LIST];
+
 	buf_flush_list_mutex_exit(buf_pool);
 
 	current_time = time(NULL);
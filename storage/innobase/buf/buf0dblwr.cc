@@ -49,6 +49,15 @@ UNIV_INTERN buf_dblwr_t*	buf_dblwr = NULL;
 /** Set to TRUE when the doublewrite buffer is being created */
 UNIV_INTERN ibool	buf_dblwr_being_created = FALSE;
 
+/** Parallel doublewrite buffers, one per buffer pool instance, or NULL
+if innodb_parallel_doublewrite is not set */
+UNIV_INTERN buf_dblwr_t**	buf_dblwr_parallel = NULL;
+
+/** Pages read from the files of the parallel doublewrite buffers at
+startup, which recv_sys->dblwr points to until the doublewrite pages
+have been processed. The buffers are unaligned. */
+static byte*	buf_dblwr_parallel_recv_buf[MAX_BUFFER_POOLS];
+
 /****************************************************************//**
 Determines if a page number is located inside the doublewrite buffer.
 @return TRUE if the location is inside the two blocks of the
@@ -120,18 +129,17 @@ buf_dblwr_sync_datafiles()
 }
 
 /****************************************************************//**
-Creates or initialializes the doublewrite buffer at a database start. */
+Allocates the memory structure of a doublewrite buffer.
+@return doublewrite buffer */
 static
-void
-buf_dblwr_init(
-/*===========*/
-	byte*	doublewrite)	/*!< in: pointer to the doublewrite buf
-				header on trx sys page */
+buf_dblwr_t*
+buf_dblwr_alloc(void)
+/*=================*/
 {
-	ulint	buf_size;
+	buf_dblwr_t*	dblwr;
+	ulint		buf_size;
 
-	buf_dblwr = static_cast<buf_dblwr_t*>(
-		mem_zalloc(sizeof(buf_dblwr_t)));
+	dblwr = static_cast<buf_dblwr_t*>(mem_zalloc(sizeof(buf_dblwr_t)));
 
 	/* There are two blocks of same size in the doublewrite
 	buffer. */
@@ -143,44 +151,358 @@ buf_dblwr_init(
 	     && srv_doublewrite_batch_size < buf_size);
 
 	mutex_create(buf_dblwr_mutex_key,
-		     &buf_dblwr->mutex, SYNC_DOUBLEWRITE);
+		     &dblwr->mutex, SYNC_DOUBLEWRITE);
 
-	buf_dblwr->b_event = os_event_create();
-	buf_dblwr->s_event = os_event_create();
-	buf_dblwr->first_free = 0;
-	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
+	dblwr->b_event = os_event_create();
+	dblwr->s_event = os_event_create();
+	dblwr->first_free = 0;
+	dblwr->s_reserved = 0;
+	dblwr->b_reserved = 0;
 
-	buf_dblwr->block1 = mach_read_from_4(
-		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
-	buf_dblwr->block2 = mach_read_from_4(
-		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK2);
-
-	buf_dblwr->in_use = static_cast<bool*>(
+	dblwr->in_use = static_cast<bool*>(
 		mem_zalloc(buf_size * sizeof(bool)));
 
-	buf_dblwr->write_buf_unaligned = static_cast<byte*>(
+	dblwr->write_buf_unaligned = static_cast<byte*>(
 		mem_zalloc((1 + buf_size) * UNIV_PAGE_SIZE));
 
-	buf_dblwr->write_buf = static_cast<byte*>(
-		ut_align(buf_dblwr->write_buf_unaligned,
+	dblwr->write_buf = static_cast<byte*>(
+		ut_align(dblwr->write_buf_unaligned,
 			 UNIV_PAGE_SIZE));
 
-	buf_dblwr->header_unaligned = static_cast<byte*>(
+	dblwr->header_unaligned = static_cast<byte*>(
 		mem_zalloc(2 * BUF_DBLWR_HEADER_SIZE));
 
-	buf_dblwr->header = static_cast<byte*>(
-		ut_align(buf_dblwr->header_unaligned,
+	dblwr->header = static_cast<byte*>(
+		ut_align(dblwr->header_unaligned,
 			 BUF_DBLWR_HEADER_SIZE));
 
-	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
+	dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		mem_zalloc(buf_size * sizeof(void*)));
-	/* Write the page number and the page type to the doublewrite
-	 * header in case it gets used. */
+
+	mach_write_to_2(dblwr->header + FIL_PAGE_TYPE,
+			FIL_PAGE_TYPE_DBLWR_HEADER);
+
+	return(dblwr);
+}
+
+/****************************************************************//**
+Frees the memory structure of a doublewrite buffer. */
+static
+void
+buf_dblwr_dealloc(
+/*==============*/
+	buf_dblwr_t*	dblwr)	/*!< in,own: doublewrite buffer */
+{
+	ut_ad(dblwr->s_reserved == 0);
+	ut_ad(dblwr->b_reserved == 0);
+
+	os_event_free(dblwr->b_event);
+	os_event_free(dblwr->s_event);
+	mem_free(dblwr->write_buf_unaligned);
+	dblwr->write_buf_unaligned = NULL;
+	mem_free(dblwr->header_unaligned);
+	dblwr->header_unaligned = NULL;
+	dblwr->header = NULL;
+
+	mem_free(dblwr->buf_block_arr);
+	dblwr->buf_block_arr = NULL;
+
+	mem_free(dblwr->in_use);
+	dblwr->in_use = NULL;
+
+	if (dblwr->path != NULL) {
+		os_file_close(dblwr->file);
+		mem_free(dblwr->path);
+		dblwr->path = NULL;
+	}
+
+	mutex_free(&dblwr->mutex);
+	mem_free(dblwr);
+}
+
+/****************************************************************//**
+Creates or initialializes the doublewrite buffer at a database start. */
+static
+void
+buf_dblwr_init(
+/*===========*/
+	byte*	doublewrite)	/*!< in: pointer to the doublewrite buf
+				header on trx sys page */
+{
+	buf_dblwr = buf_dblwr_alloc();
+
+	buf_dblwr->block1 = mach_read_from_4(
+		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
+	buf_dblwr->block2 = mach_read_from_4(
+		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK2);
+
+	/* Write the page number to the doublewrite header in case it
+	gets used. */
 	mach_write_to_4(buf_dblwr->header + FIL_PAGE_OFFSET,
 			buf_dblwr->block1);
-	mach_write_to_2(buf_dblwr->header + FIL_PAGE_TYPE,
-			FIL_PAGE_TYPE_DBLWR_HEADER);
+}
+
+/****************************************************************//**
+Builds the name of the file of a parallel doublewrite buffer. */
+static
+void
+buf_dblwr_parallel_file_name(
+/*=========================*/
+	char*	name,	/*!< out: file name */
+	ulint	size,	/*!< in: size of name */
+	ulint	i)	/*!< in: buffer pool instance */
+{
+	ulint	dirnamelen = strlen(srv_data_home);
+
+	/* Add a path separator if needed. */
+	if (dirnamelen && srv_data_home[dirnamelen - 1]
+	    != SRV_PATH_SEPARATOR) {
+		ut_snprintf(name, size, "%s%cib_doublewrite%lu",
+			    srv_data_home, SRV_PATH_SEPARATOR, (ulong) i);
+	} else {
+		ut_snprintf(name, size, "%sib_doublewrite%lu",
+			    srv_data_home, (ulong) i);
+	}
+}
+
+/****************************************************************//**
+Reads the pages of the file of a parallel doublewrite buffer into memory
+for crash recovery. A file that was last written in reduced-doublewrite
+mode starts with a header page listing the pages of the last batch. */
+static
+void
+buf_dblwr_parallel_load_pages(
+/*==========================*/
+	const char*	name,	/*!< in: file name */
+	ulint		i)	/*!< in: buffer pool instance */
+{
+	os_file_t	file;
+	ibool		success;
+	os_offset_t	size;
+	byte*		buf;
+	recv_dblwr_t&	recv_dblwr = recv_sys->dblwr;
+
+	file = os_file_create_simple_no_error_handling(
+		innodb_file_data_key, name, OS_FILE_OPEN,
+		OS_FILE_READ_ONLY, &success);
+
+	if (!success) {
+		return;
+	}
+
+	size = os_file_get_size(file);
+
+	if (size != (os_offset_t) BUF_DBLWR_PARALLEL_PAGES
+	    * UNIV_PAGE_SIZE) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"Ignoring the parallel doublewrite file %s of "
+			UINT64PF " bytes.", name, size);
+		os_file_close(file);
+		return;
+	}
+
+	ut_a(buf_dblwr_parallel_recv_buf[i] == NULL);
+	buf_dblwr_parallel_recv_buf[i] = static_cast<byte*>(
+		ut_malloc((1 + BUF_DBLWR_PARALLEL_PAGES) * UNIV_PAGE_SIZE));
+	buf = static_cast<byte*>(
+		ut_align(buf_dblwr_parallel_recv_buf[i], UNIV_PAGE_SIZE));
+
+	success = os_file_read(file, buf, 0, (ulint) size);
+	os_file_close(file);
+
+	if (!success) {
+		return;
+	}
+
+	if (fil_page_get_type(buf) == FIL_PAGE_TYPE_DBLWR_HEADER) {
+		const byte*	ptr = buf + FIL_PAGE_DATA;
+
+		if (buf_page_is_corrupted(false, buf,
+					  BUF_DBLWR_HEADER_SIZE)) {
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"The header of the parallel doublewrite "
+				"file %s is corrupt.", name);
+			buf_page_print(buf, BUF_DBLWR_HEADER_SIZE,
+				       BUF_PAGE_PRINT_NO_CRASH);
+			ut_error;
+		}
+
+		ulint	n_pages = mach_read_from_2(ptr);
+
+		ptr += 2;
+
+		for (ulint j = 0; j < n_pages; ++j) {
+			ulint	space_id = mach_read_from_4(ptr);
+			ulint	page_no = mach_read_from_4(ptr + 4);
+
+			ptr += 8;
+			recv_dblwr.add(NULL, space_id, page_no);
+		}
+
+		/* The rest of the file was zeroed when the mode was
+		switched to reduced-doublewrite. */
+		return;
+	}
+
+	for (ulint j = 0; j < BUF_DBLWR_PARALLEL_PAGES; ++j) {
+		byte*	page = buf + j * UNIV_PAGE_SIZE;
+
+		if (buf_page_is_zeroes(page, 0)) {
+			/* Unused since the file was last reset */
+			continue;
+		}
+
+		recv_dblwr.add(page,
+			       mach_read_from_4(page + FIL_PAGE_SPACE_ID),
+			       mach_read_from_4(page + FIL_PAGE_OFFSET));
+	}
+}
+
+/****************************************************************//**
+Frees the pages read from the files of the parallel doublewrite buffers
+at startup. */
+static
+void
+buf_dblwr_parallel_free_recv_pages(void)
+/*====================================*/
+{
+	std::list<recv_dblwr_item_t>&	pages = recv_sys->dblwr.pages;
+
+	for (ulint i = 0; i < MAX_BUFFER_POOLS; ++i) {
+		const byte*	start = buf_dblwr_parallel_recv_buf[i];
+
+		if (start == NULL) {
+			continue;
+		}
+
+		const byte*	end = start
+			+ (1 + BUF_DBLWR_PARALLEL_PAGES) * UNIV_PAGE_SIZE;
+
+		for (std::list<recv_dblwr_item_t>::iterator it
+			     = pages.begin();
+		     it != pages.end();) {
+			if (it->page >= start && it->page < end) {
+				it = pages.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		ut_free(buf_dblwr_parallel_recv_buf[i]);
+		buf_dblwr_parallel_recv_buf[i] = NULL;
+	}
+}
+
+/****************************************************************//**
+Loads the pages of existing parallel doublewrite files for crash recovery,
+and creates one parallel doublewrite buffer per buffer pool instance if
+innodb_parallel_doublewrite is set. The pages are loaded even if the option
+is not set, in case the server was started without it after a crash. */
+static
+void
+buf_dblwr_parallel_init(
+/*====================*/
+	bool	load_corrupt_pages)	/*!< in: whether to load the pages
+					for crash recovery */
+{
+	char	name[OS_FILE_MAX_PATH];
+
+	ut_ad(buf_dblwr_parallel == NULL);
+
+	for (ulint i = 0; load_corrupt_pages && i < MAX_BUFFER_POOLS; ++i) {
+		ibool		exists;
+		os_file_type_t	type;
+
+		buf_dblwr_parallel_file_name(name, sizeof name, i);
+
+		if (os_file_status(name, &exists, &type) && exists) {
+			buf_dblwr_parallel_load_pages(name, i);
+		}
+	}
+
+	if (!srv_parallel_doublewrite || srv_read_only_mode) {
+		return;
+	}
+
+	buf_dblwr_parallel = static_cast<buf_dblwr_t**>(
+		mem_zalloc(srv_buf_pool_instances * sizeof(buf_dblwr_t*)));
+
+	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
+		buf_dblwr_t*	dblwr = buf_dblwr_alloc();
+		ibool		exists;
+		os_file_type_t	type;
+		ibool		success;
+
+		buf_dblwr_parallel_file_name(name, sizeof name, i);
+
+		success = os_file_status(name, &exists, &type);
+
+		if (success) {
+			dblwr->file = os_file_create(
+				innodb_file_data_key, name,
+				exists ? OS_FILE_OPEN : OS_FILE_CREATE,
+				OS_FILE_NORMAL, OS_DATA_FILE, &success);
+		}
+
+		if (!success) {
+			ib_logf(IB_LOG_LEVEL_ERROR,
+				"Cannot open or create the parallel "
+				"doublewrite file %s. Cannot continue "
+				"operation.", name);
+
+			exit(EXIT_FAILURE);
+		}
+
+		/* The file is reset before the first batch is written
+		to it, after the pages loaded above have been used. */
+		dblwr->path = mem_strdup(name);
+		dblwr->mode = 0;
+
+		buf_dblwr_parallel[i] = dblwr;
+	}
+
+	/* The batches are no longer written to the system doublewrite
+	buffer. Reset it before the first batch is flushed, after its
+	pages loaded for crash recovery have been used, so that the full
+	page copies left in it by a run without the option cannot be
+	used by a later recovery. */
+	srv_doublewrite_reset = TRUE;
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Using %lu parallel doublewrite buffers",
+		(ulong) srv_buf_pool_instances);
+}
+
+/****************************************************************//**
+Zeroes out the file of a parallel doublewrite buffer and sizes it to
+BUF_DBLWR_PARALLEL_PAGES. This is done before the first batch is written
+to the file, and when the doublewrite mode has been changed by the user,
+so that no stale page copies are left in the file. It is only called
+for a batch of the parallel doublewrite buffer, so it need not be
+thread-safe. */
+static
+void
+buf_dblwr_parallel_reset(
+/*=====================*/
+	buf_dblwr_t*	dblwr,			/*!< in/out: parallel
+						doublewrite buffer */
+	ulint		doublewrite_mode)	/*!< in: doublewrite mode */
+{
+	ut_ad(dblwr->batch_running);
+	ut_a(doublewrite_mode);
+
+	if (!os_file_set_size(dblwr->path, dblwr->file,
+			      (os_offset_t) BUF_DBLWR_PARALLEL_PAGES
+			      * UNIV_PAGE_SIZE)) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Cannot reset the parallel doublewrite file %s.",
+			dblwr->path);
+		ut_error;
+	}
+
+	os_file_flush(dblwr->file);
+
+	dblwr->mode = doublewrite_mode;
 }
 
 /****************************************************************//**
@@ -218,6 +540,7 @@ start_again:
 		just read in some numbers */
 
 		buf_dblwr_init(doublewrite);
+		buf_dblwr_parallel_init(false);
 
 		mtr_commit(&mtr);
 		buf_dblwr_being_created = FALSE;
@@ -590,12 +913,136 @@ buf_dblwr_init_or_load_pages(
 		os_file_flush(file);
 	}
 
+	buf_dblwr_parallel_init(load_corrupt_pages);
+
 leave_func:
 	ut_free(unaligned_read_buf);
 }
 
 /****************************************************************//**
-Process the double write buffer pages. */
+Restores a page that was read from a data file during recovery from its
+copy in the doublewrite buffer, if the page turned out to be corrupted
+or all zeroes. */
+static
+void
+buf_dblwr_recover_page(
+/*===================*/
+	const recv_dblwr_item_t*	item,		/*!< in: page in the
+							doublewrite buffer */
+	const byte*			read_buf,	/*!< in: page read from
+							the data file */
+	ulint				zip_size,	/*!< in: compressed page
+							size, or 0 */
+	bool				corrupted)	/*!< in: whether
+							read_buf is
+							corrupted */
+{
+	byte*	dblwr_page = NULL;
+
+	if (item->page != NULL
+	    && (corrupted || buf_page_is_zeroes(read_buf, zip_size))) {
+		/* A page can have copies both in the system tablespace
+		and in a parallel doublewrite file. Restore it from the
+		newest one. */
+		dblwr_page = recv_sys->dblwr.find_page(
+			item->space_id, item->page_no);
+	}
+
+	if (corrupted) {
+		if (!dblwr_page) {
+			fprintf(stderr,
+				"InnoDB: Database page"
+				" corruption or a failed "
+				"file read of "
+				"space %lu page %lu.\n"
+				"InnoDB: Cannot recover it "
+				"from the doublewrite buffer "
+				"because it was written in "
+				"reduced-doublewrite mode.\n",
+				(ulong) item->space_id,
+				(ulong) item->page_no);
+			fprintf(stderr, "InnoDB: Dump of the "
+					"page:\n");
+			buf_page_print(read_buf, zip_size,
+				       BUF_PAGE_PRINT_NO_CRASH);
+			ut_error;
+		}
+
+		fprintf(stderr,
+			"InnoDB: Database page"
+			" corruption or a failed\n"
+			"InnoDB: file read of"
+			" space %lu page %lu.\n"
+			"InnoDB: Trying to recover it from"
+			" the doublewrite buffer.\n",
+			(ulong) item->space_id,
+			(ulong) item->page_no);
+
+		if (buf_page_is_corrupted(true, dblwr_page, zip_size)) {
+			fprintf(stderr,
+				"InnoDB: Dump of the page:\n");
+			buf_page_print(
+				read_buf, zip_size,
+				BUF_PAGE_PRINT_NO_CRASH);
+			fprintf(stderr,
+				"InnoDB: Dump of"
+				" corresponding page"
+				" in doublewrite buffer:\n");
+			buf_page_print(
+				dblwr_page, zip_size,
+				BUF_PAGE_PRINT_NO_CRASH);
+
+			fprintf(stderr,
+				"InnoDB: Also the page in the"
+				" doublewrite buffer"
+				" is corrupt.\n"
+				"InnoDB: Cannot continue"
+				" operation.\n"
+				"InnoDB: You can try to"
+				" recover the database"
+				" with the my.cnf\n"
+				"InnoDB: option:\n"
+				"InnoDB:"
+				" innodb_force_recovery=6\n");
+			ut_error;
+		}
+
+		/* Write the good page from the
+		doublewrite buffer to the intended
+		position */
+		fil_io(OS_FILE_WRITE, true, item->space_id,
+		       zip_size, item->page_no, 0,
+		       zip_size ? zip_size : UNIV_PAGE_SIZE,
+		       dblwr_page, NULL);
+
+		ib_logf(IB_LOG_LEVEL_INFO,
+			"Recovered the page from"
+			" the doublewrite buffer.");
+	} else if (dblwr_page != NULL) {
+		/* read_buf is all zeroes */
+
+		if (!buf_page_is_zeroes(dblwr_page, zip_size)
+		    && !buf_page_is_corrupted(true, dblwr_page,
+					      zip_size)) {
+
+			/* Database page contained only
+			zeroes, while a valid copy is
+			available in dblwr buffer. */
+
+			fil_io(OS_FILE_WRITE, true, item->space_id,
+			       zip_size, item->page_no, 0,
+			       zip_size ? zip_size
+					: UNIV_PAGE_SIZE,
+			       dblwr_page, NULL);
+		}
+	}
+}
+
+/****************************************************************//**
+Process the double write buffer pages. The pages are read from the data
+files into a buffer of TRX_SYS_DOUBLEWRITE_BLOCK_SIZE pages, and the
+checksums of a full buffer are verified with one call to
+buf_page_is_corrupted_batch(). */
 void
 buf_dblwr_process()
 /*===============*/
@@ -604,15 +1051,27 @@ buf_dblwr_process()
 	byte*	read_buf;
 	byte*	unaligned_read_buf;
 	std::list<recv_dblwr_item_t>& dblwr_pages = recv_sys->dblwr.pages;
+	const recv_dblwr_item_t*	batch[TRX_SYS_DOUBLEWRITE_BLOCK_SIZE];
+	const byte*	batch_pages[TRX_SYS_DOUBLEWRITE_BLOCK_SIZE];
+	bool		batch_corrupted[TRX_SYS_DOUBLEWRITE_BLOCK_SIZE];
+	ulint		n_batch = 0;
+	ulint		batch_zip_size = 0;
 
-	unaligned_read_buf = static_cast<byte*>(ut_malloc(2 * UNIV_PAGE_SIZE));
+	unaligned_read_buf = static_cast<byte*>(
+		ut_malloc((TRX_SYS_DOUBLEWRITE_BLOCK_SIZE + 1)
+			  * UNIV_PAGE_SIZE));
 
 	read_buf = static_cast<byte*>(
 		ut_align(unaligned_read_buf, UNIV_PAGE_SIZE));
 
 	for (std::list<recv_dblwr_item_t>::iterator i = dblwr_pages.begin();
-	     i != dblwr_pages.end(); ++i, ++page_no_dblwr ) {
-		if (!fil_tablespace_exists_in_mem(i->space_id)) {
+	     ; ++i, ++page_no_dblwr) {
+		ulint	zip_size = 0;
+		bool	add = false;
+
+		if (i == dblwr_pages.end()) {
+			/* Process the last batch below. */
+		} else if (!fil_tablespace_exists_in_mem(i->space_id)) {
 			/* Maybe we have dropped the single-table tablespace
 			and this page once belonged to it: do nothing */
 			ib_logf(IB_LOG_LEVEL_INFO,
@@ -633,111 +1092,61 @@ buf_dblwr_process()
 				(ulong) i->space_id, (ulong) i->page_no,
 				page_no_dblwr);
 		} else {
-			ulint	zip_size = fil_space_get_zip_size(i->space_id);
+			zip_size = fil_space_get_zip_size(i->space_id);
+			add = true;
+		}
+
+		/* A batch holds pages of one size only, and a page must
+		be restored before it is read again for a later copy in
+		the doublewrite buffer. */
+		bool	flush = i == dblwr_pages.end()
+			|| n_batch == TRX_SYS_DOUBLEWRITE_BLOCK_SIZE
+			|| (add && n_batch > 0 && zip_size != batch_zip_size);
+
+		for (ulint j = 0; add && !flush && j < n_batch; j++) {
+			flush = batch[j]->space_id == i->space_id
+				&& batch[j]->page_no == i->page_no;
+		}
+
+		if (flush && n_batch > 0) {
+			buf_page_is_corrupted_batch(
+				true, batch_pages, n_batch, batch_zip_size,
+				batch_corrupted);
+
+			for (ulint j = 0; j < n_batch; j++) {
+				buf_dblwr_recover_page(
+					batch[j], batch_pages[j],
+					batch_zip_size, batch_corrupted[j]);
+			}
+
+			n_batch = 0;
+		}
+
+		if (i == dblwr_pages.end()) {
+			break;
+		}
+
+		if (add) {
+			byte*	page = read_buf + n_batch * UNIV_PAGE_SIZE;
 
 			/* Read in the actual page from the file */
 			fil_io(OS_FILE_READ, true, i->space_id, zip_size,
 			       i->page_no, 0,
 			       zip_size ? zip_size : UNIV_PAGE_SIZE,
-			       read_buf, NULL);
-
-			/* Check if the page is corrupt */
-
-			if (buf_page_is_corrupted(true, read_buf, zip_size)) {
-				if (!i->page) {
-					fprintf(stderr,
-						"InnoDB: Database page"
-						" corruption or a failed "
-						"file read of "
-						"space %lu page %lu.\n"
-						"InnoDB: Cannot recover it "
-						"from the doublewrite buffer "
-						"because it was written in "
-						"reduced-doublewrite mode.\n",
-						(ulong) i->space_id,
-						(ulong) i->page_no);
-					fprintf(stderr, "InnoDB: Dump of the "
-							"page:\n");
-					buf_page_print(read_buf, zip_size,
-						       BUF_PAGE_PRINT_NO_CRASH);
-					ut_error;
-				}
+			       page, NULL);
 
-				fprintf(stderr,
-					"InnoDB: Database page"
-					" corruption or a failed\n"
-					"InnoDB: file read of"
-					" space %lu page %lu.\n"
-					"InnoDB: Trying to recover it from"
-					" the doublewrite buffer.\n",
-					(ulong) i->space_id,
-					(ulong) i->page_no);
-
-				if (buf_page_is_corrupted(true,
-							  i->page, zip_size)) {
-					fprintf(stderr,
-						"InnoDB: Dump of the page:\n");
-					buf_page_print(
-						read_buf, zip_size,
-						BUF_PAGE_PRINT_NO_CRASH);
-					fprintf(stderr,
-						"InnoDB: Dump of"
-						" corresponding page"
-						" in doublewrite buffer:\n");
-					buf_page_print(
-						i->page, zip_size,
-						BUF_PAGE_PRINT_NO_CRASH);
-
-					fprintf(stderr,
-						"InnoDB: Also the page in the"
-						" doublewrite buffer"
-						" is corrupt.\n"
-						"InnoDB: Cannot continue"
-						" operation.\n"
-						"InnoDB: You can try to"
-						" recover the database"
-						" with the my.cnf\n"
-						"InnoDB: option:\n"
-						"InnoDB:"
-						" innodb_force_recovery=6\n");
-					ut_error;
-				}
-
-				/* Write the good page from the
-				doublewrite buffer to the intended
-				position */
-				fil_io(OS_FILE_WRITE, true, i->space_id,
-				       zip_size, i->page_no, 0,
-				       zip_size ? zip_size : UNIV_PAGE_SIZE,
-				       i->page, NULL);
-
-				ib_logf(IB_LOG_LEVEL_INFO,
-					"Recovered the page from"
-					" the doublewrite buffer.");
-			} else if (i->page &&
-				   buf_page_is_zeroes(read_buf, zip_size)) {
-
-				if (!buf_page_is_zeroes(i->page, zip_size)
-				    && !buf_page_is_corrupted(true, i->page,
-							      zip_size)) {
-
-					/* Database page contained only
-					zeroes, while a valid copy is
-					available in dblwr buffer. */
-
-					fil_io(OS_FILE_WRITE, true, i->space_id,
-					       zip_size, i->page_no, 0,
-					       zip_size ? zip_size
-							: UNIV_PAGE_SIZE,
-					       i->page, NULL);
-				}
-			}
+			batch[n_batch] = &*i;
+			batch_pages[n_batch] = page;
+			batch_zip_size = zip_size;
+			n_batch++;
 		}
 	}
 
 	fil_flush_file_spaces(FIL_TABLESPACE, FLUSH_FROM_DOUBLEWRITE);
 
 	ut_free(unaligned_read_buf);
+
+	buf_dblwr_parallel_free_recv_pages();
 }
 
 /****************************************************************//**
@@ -749,26 +1158,44 @@ buf_dblwr_free(void)
 {
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
-	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
 
-	os_event_free(buf_dblwr->b_event);
-	os_event_free(buf_dblwr->s_event);
-	mem_free(buf_dblwr->write_buf_unaligned);
-	buf_dblwr->write_buf_unaligned = NULL;
-	mem_free(buf_dblwr->header_unaligned);
-	buf_dblwr->header_unaligned = NULL;
-	buf_dblwr->header = NULL;
+	buf_dblwr_dealloc(buf_dblwr);
+	buf_dblwr = NULL;
+
+	if (buf_dblwr_parallel != NULL) {
+		for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
+			buf_dblwr_dealloc(buf_dblwr_parallel[i]);
+		}
 
-	mem_free(buf_dblwr->buf_block_arr);
-	buf_dblwr->buf_block_arr = NULL;
+		mem_free(buf_dblwr_parallel);
+		buf_dblwr_parallel = NULL;
+	}
 
-	mem_free(buf_dblwr->in_use);
-	buf_dblwr->in_use = NULL;
+	/* The recovery pages are still allocated if there was no
+	crash recovery. recv_sys->dblwr has been emptied by now. */
+	for (ulint i = 0; i < MAX_BUFFER_POOLS; ++i) {
+		if (buf_dblwr_parallel_recv_buf[i] != NULL) {
+			ut_free(buf_dblwr_parallel_recv_buf[i]);
+			buf_dblwr_parallel_recv_buf[i] = NULL;
+		}
+	}
+}
 
-	mutex_free(&buf_dblwr->mutex);
-	mem_free(buf_dblwr);
-	buf_dblwr = NULL;
+/********************************************************************//**
+Gets the doublewrite buffer that batch flushes of a page go through.
+@return the parallel doublewrite buffer of the buffer pool instance of
+the page, or the doublewrite buffer in the system tablespace */
+UNIV_INLINE
+buf_dblwr_t*
+buf_dblwr_get_batch(
+/*================*/
+	const buf_page_t*	bpage)	/*!< in: buffer block descriptor */
+{
+	if (buf_dblwr_parallel != NULL) {
+		return(buf_dblwr_parallel[bpage->buf_pool_index]);
+	}
+
+	return(buf_dblwr);
 }
 
 /********************************************************************//**
@@ -787,29 +1214,34 @@ buf_dblwr_update(
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
 	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+		{
+			buf_dblwr_t*	dblwr = buf_dblwr_get_batch(bpage);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+			mutex_enter(&dblwr->mutex);
 
-		buf_dblwr->b_reserved--;
+			ut_ad(dblwr->batch_running);
+			ut_ad(dblwr->b_reserved > 0);
+			ut_ad(dblwr->b_reserved <= dblwr->first_free);
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
-			/* This will finish the batch. Sync data files
-			to the disk. */
-			fil_flush_file_spaces(FIL_TABLESPACE,
-					      FLUSH_FROM_DOUBLEWRITE);
-			mutex_enter(&buf_dblwr->mutex);
+			dblwr->b_reserved--;
 
-			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
-		}
+			if (dblwr->b_reserved == 0) {
+				mutex_exit(&dblwr->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TABLESPACE,
+						      FLUSH_FROM_DOUBLEWRITE);
+				mutex_enter(&dblwr->mutex);
 
-		mutex_exit(&buf_dblwr->mutex);
+				/* We can now reuse the doublewrite
+				memory buffer: */
+				dblwr->first_free = 0;
+				dblwr->batch_running = false;
+				os_event_set(dblwr->b_event);
+			}
+
+			mutex_exit(&dblwr->mutex);
+		}
 		break;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
@@ -963,59 +1395,70 @@ buf_dblwr_write_block_to_datafile(
 }
 
 /********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
-UNIV_INTERN
+Writes the pages of a batch to the file of a parallel doublewrite buffer,
+or in reduced-doublewrite mode a header page listing them, and syncs the
+file. */
+static
 void
-buf_dblwr_flush_buffered_writes(void)
-/*=================================*/
+buf_dblwr_parallel_write(
+/*=====================*/
+	buf_dblwr_t*	dblwr,			/*!< in/out: parallel
+						doublewrite buffer */
+	ulint		doublewrite_mode)	/*!< in: doublewrite mode */
 {
-	byte*		write_buf;
-	ulint		first_free;
-	ulint		len;
-	byte*		header_ptr;
-	ulong		use_doublewrite_buf = srv_use_doublewrite_buf;
+	ibool		success;
+	ib_uint64_t	start_us = ut_time_us(NULL);
 
-	if (!use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		return;
-	}
-
-try_again:
-	mutex_enter(&buf_dblwr->mutex);
-
-	/* Write first to doublewrite buffer blocks. We use synchronous
-	aio and thus know that file write has been completed when the
-	control returns. */
+	ut_ad(dblwr->batch_running);
+	ut_ad(dblwr->first_free <= BUF_DBLWR_PARALLEL_PAGES);
 
-	if (buf_dblwr->first_free == 0) {
+	if (dblwr->mode != doublewrite_mode) {
+		buf_dblwr_parallel_reset(dblwr, doublewrite_mode);
+	}
 
-		mutex_exit(&buf_dblwr->mutex);
+	if (doublewrite_mode == 2) {
+		success = os_file_write(dblwr->path, dblwr->file,
+					dblwr->header, 0,
+					BUF_DBLWR_HEADER_SIZE);
+	} else {
+		success = os_file_write(dblwr->path, dblwr->file,
+					dblwr->write_buf, 0,
+					dblwr->first_free * UNIV_PAGE_SIZE);
+	}
 
-		return;
+	if (!success) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Cannot write to the parallel doublewrite "
+			"file %s.", dblwr->path);
+		ut_error;
 	}
 
-	if (buf_dblwr->batch_running) {
-		/* Another thread is running the batch right now. Wait
-		for it to finish. */
-		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+	os_file_flush(dblwr->file);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
-		goto try_again;
-	}
+	dblwr->n_batches++;
+	dblwr->n_pages += dblwr->first_free;
+	dblwr->write_us += ut_time_us(NULL) - start_us;
+}
+
+/********************************************************************//**
+Flushes possible buffered writes from a doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. */
+static
+void
+buf_dblwr_flush_batch(
+/*==================*/
+	buf_dblwr_t*	dblwr,			/*!< in/out: doublewrite
+						buffer */
+	ulong		use_doublewrite_buf)	/*!< in: doublewrite mode */
+{
+	byte*		write_buf;
+	ulint		first_free;
+	ulint		len;
+	byte*		header_ptr;
 
-	ut_a(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+try_again:
+	mutex_enter(&dblwr->mutex);
 
-	/* Disallow anyone else to post to doublewrite buffer or to
-	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
 	/* Reset the doublewrite buffer if srv_doublewrite_reset is set.
 	 * This protects against the following scenario:
 	 * 1- server starts with full(=1) doublewrite mode and writes a bunch
@@ -1036,31 +1479,68 @@ try_again:
 	 * of the pages written to the doublewrite buffer in full mode. We
 	 * nevertheless protect against this case by resetting the doublewrite
 	 * buffer on disk, when the doublewrite mode changes.
+	 * With innodb_parallel_doublewrite no batch is written to the
+	 * system doublewrite buffer, so it is reset even if it has nothing
+	 * to write. It is then also reset once at startup, so that the
+	 * copies left by a run without the option are wiped, see
+	 * buf_dblwr_parallel_init().
 	 */
-	if (srv_doublewrite_reset) {
+	if (dblwr->path == NULL && srv_doublewrite_reset
+	    && !dblwr->batch_running) {
+		/* A parallel doublewrite buffer remembers the mode of
+		its file instead, see buf_dblwr_parallel_write(). */
 		buf_dblwr_reset(use_doublewrite_buf);
 		srv_doublewrite_reset = FALSE;
 	}
 
+	/* Write first to doublewrite buffer blocks. We use synchronous
+	aio and thus know that file write has been completed when the
+	control returns. */
+
+	if (dblwr->first_free == 0) {
+
+		mutex_exit(&dblwr->mutex);
+
+		return;
+	}
+
+	if (dblwr->batch_running) {
+		/* Another thread is running the batch right now. Wait
+		for it to finish. */
+		ib_int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
+
+		os_event_wait_low(dblwr->b_event, sig_count);
+		goto try_again;
+	}
+
+	ut_a(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
+
+	/* Disallow anyone else to post to doublewrite buffer or to
+	start another batch of flushing. */
+	dblwr->batch_running = true;
+	first_free = dblwr->first_free;
+
 	/* Now safe to release the mutex. Note that though no other
 	thread is allowed to post to the doublewrite batch flushing
 	but any threads working on single page flushes are allowed
 	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&dblwr->mutex);
 
-	write_buf = buf_dblwr->write_buf;
-	header_ptr = buf_dblwr->header + FIL_PAGE_DATA;
+	write_buf = dblwr->write_buf;
+	header_ptr = dblwr->header + FIL_PAGE_DATA;
 	memset(header_ptr, 0, BUF_DBLWR_HEADER_SIZE - FIL_PAGE_DATA);
-	mach_write_to_2(header_ptr, buf_dblwr->first_free);
+	mach_write_to_2(header_ptr, dblwr->first_free);
 	header_ptr += 2;
 
 	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	     i < dblwr->first_free;
 	     len2 += UNIV_PAGE_SIZE, i++) {
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) dblwr->buf_block_arr[i];
 		mach_write_to_4(header_ptr, buf_page_get_space(&block->page));
 		header_ptr += 4;
 		mach_write_to_4(header_ptr, buf_page_get_page_no(&block->page));
@@ -1084,75 +1564,86 @@ try_again:
 
 	if (use_doublewrite_buf == 2) {
 		ib_uint32_t	checksum = page_zip_calc_checksum(
-			buf_dblwr->header, BUF_DBLWR_HEADER_SIZE,
+			dblwr->header, BUF_DBLWR_HEADER_SIZE,
 			static_cast<srv_checksum_algorithm_t>(
 				srv_checksum_algorithm));
 
-		mach_write_to_4(buf_dblwr->header + FIL_PAGE_SPACE_OR_CHKSUM,
+		mach_write_to_4(dblwr->header + FIL_PAGE_SPACE_OR_CHKSUM,
 				checksum);
+	}
+
+	if (dblwr->path != NULL) {
+		/* Write the batch to the file of the parallel
+		doublewrite buffer, and sync it. */
+		buf_dblwr_parallel_write(dblwr, use_doublewrite_buf);
+		goto flush;
+	}
 
+	if (use_doublewrite_buf == 2) {
 		fil_io(OS_FILE_WRITE | OS_AIO_DOUBLE_WRITE, true,
 		       TRX_SYS_SPACE, 0,
-		       buf_dblwr->block1, 0, BUF_DBLWR_HEADER_SIZE,
-		       (void*) buf_dblwr->header, NULL);
+		       dblwr->block1, 0, BUF_DBLWR_HEADER_SIZE,
+		       (void*) dblwr->header, NULL);
 		goto flush;
 	}
 
 	/* Write out the first block of the doublewrite buffer */
 	len = ut_min(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-		     buf_dblwr->first_free) * UNIV_PAGE_SIZE;
+		     dblwr->first_free) * UNIV_PAGE_SIZE;
 
 	fil_io(OS_FILE_WRITE | OS_AIO_DOUBLE_WRITE, true, TRX_SYS_SPACE, 0,
-	       buf_dblwr->block1, 0, len,
+	       dblwr->block1, 0, len,
 	       (void*) write_buf, NULL);
 
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+	if (dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
 		/* No unwritten pages in the second block. */
 		goto flush;
 	}
 
 	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
+	len = (dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
 	       * UNIV_PAGE_SIZE;
 
-	write_buf = buf_dblwr->write_buf
+	write_buf = dblwr->write_buf
 		    + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE * UNIV_PAGE_SIZE;
 
 	fil_io(OS_FILE_WRITE | OS_AIO_DOUBLE_WRITE, true, TRX_SYS_SPACE, 0,
-	       buf_dblwr->block2, 0, len,
+	       dblwr->block2, 0, len,
 	       (void*) write_buf, NULL);
 
 flush:
 	/* increment the doublewrite flushed pages counter */
 	if (use_doublewrite_buf == 1) {
-		srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+		srv_stats.dblwr_pages_written.add(dblwr->first_free);
 	} else {
 		srv_stats.dblwr_pages_written.inc();
 	}
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
-	fil_flush(TRX_SYS_SPACE, FLUSH_FROM_DOUBLEWRITE);
+	if (dblwr->path == NULL) {
+		fil_flush(TRX_SYS_SPACE, FLUSH_FROM_DOUBLEWRITE);
+	}
 
 	/* We know that the writes have been flushed to disk now
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
+	/* Up to this point first_free and dblwr->first_free are
+	same because we have set the dblwr->batch_running flag
 	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	can't safely access dblwr->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting dblwr->first_free to a higher value.
+	If this happens and we are using dblwr->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	ut_ad(first_free == dblwr->first_free);
 	for (ulint i = 0; i < first_free; i++) {
 		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+			dblwr->buf_block_arr[i], false);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1162,6 +1653,72 @@ flush:
 	os_aio_simulated_wake_handler_threads();
 }
 
+/********************************************************************//**
+Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur. */
+UNIV_INTERN
+void
+buf_dblwr_flush_buffered_writes(void)
+/*=================================*/
+{
+	ulong		use_doublewrite_buf = srv_use_doublewrite_buf;
+
+	if (!use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		return;
+	}
+
+	buf_dblwr_flush_batch(buf_dblwr, use_doublewrite_buf);
+
+	if (buf_dblwr_parallel != NULL) {
+		for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
+			buf_dblwr_flush_batch(buf_dblwr_parallel[i],
+					      use_doublewrite_buf);
+		}
+	}
+}
+
+/********************************************************************//**
+Flushes possible buffered writes of one buffer pool instance from the
+doublewrite memory buffer to disk. With innodb_parallel_doublewrite only
+the doublewrite buffer of the instance is written, so that batches of
+different instances do not wait for each other. Otherwise this is the
+same as buf_dblwr_flush_buffered_writes(). */
+UNIV_INTERN
+void
+buf_dblwr_flush_buffered_writes_instance(
+/*=====================================*/
+	ulint	buf_pool_index)	/*!< in: buffer pool instance */
+{
+	ulong		use_doublewrite_buf = srv_use_doublewrite_buf;
+
+	if (!use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		return;
+	}
+
+	if (buf_dblwr_parallel == NULL) {
+		buf_dblwr_flush_batch(buf_dblwr, use_doublewrite_buf);
+		return;
+	}
+
+	ut_ad(buf_pool_index < srv_buf_pool_instances);
+
+	if (srv_doublewrite_reset) {
+		/* Only resets the system doublewrite buffer, which has
+		no batch to write */
+		buf_dblwr_flush_batch(buf_dblwr, use_doublewrite_buf);
+	}
+
+	buf_dblwr_flush_batch(buf_dblwr_parallel[buf_pool_index],
+			      use_doublewrite_buf);
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1172,34 +1729,36 @@ buf_dblwr_add_to_batch(
 /*====================*/
 	buf_page_t*	bpage)	/*!< in: buffer block to write */
 {
-	ulint	zip_size;
+	ulint		zip_size;
+	buf_dblwr_t*	dblwr = buf_dblwr_get_batch(bpage);
 
 	ut_a(buf_page_in_file(bpage));
 
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&dblwr->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(dblwr->first_free <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->batch_running) {
+	if (dblwr->batch_running) {
 
 		/* This not nearly as bad as it looks. There is only
 		page_cleaner thread which does background flushing
 		in batches therefore it is unlikely to be a contention
 		point. The only exception is when a user thread is
 		forced to do a flush batch because of a sync
-		checkpoint. */
-		ib_int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		checkpoint. With innodb_parallel_doublewrite, only
+		batches of the same buffer pool instance wait here. */
+		ib_int64_t	sig_count = os_event_reset(dblwr->b_event);
+		mutex_exit(&dblwr->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(dblwr->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(dblwr, srv_use_doublewrite_buf);
 
 		goto try_again;
 	}
@@ -1209,40 +1768,40 @@ try_again:
 	if (zip_size) {
 		UNIV_MEM_ASSERT_RW(bpage->zip.data, zip_size);
 		/* Copy the compressed page and clear the rest. */
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
+		memcpy(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free,
 		       bpage->zip.data, zip_size);
-		memset(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free
+		memset(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free
 		       + zip_size, 0, UNIV_PAGE_SIZE - zip_size);
 	} else {
 		ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
 		UNIV_MEM_ASSERT_RW(((buf_block_t*) bpage)->frame,
 				   UNIV_PAGE_SIZE);
 
-		memcpy(buf_dblwr->write_buf
-		       + UNIV_PAGE_SIZE * buf_dblwr->first_free,
+		memcpy(dblwr->write_buf
+		       + UNIV_PAGE_SIZE * dblwr->first_free,
 		       ((buf_block_t*) bpage)->frame, UNIV_PAGE_SIZE);
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	dblwr->buf_block_arr[dblwr->first_free] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	dblwr->first_free++;
+	dblwr->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!dblwr->batch_running);
+	ut_ad(dblwr->first_free == dblwr->b_reserved);
+	ut_ad(dblwr->b_reserved <= srv_doublewrite_batch_size);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (dblwr->first_free == srv_doublewrite_batch_size) {
+		mutex_exit(&(dblwr->mutex));
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_batch(dblwr, srv_use_doublewrite_buf);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&(dblwr->mutex));
 }
 
 /********************************************************************//**
@@ -1371,4 +1930,30 @@ retry:
 	blocks. Next do the write to the intended position. */
 	buf_dblwr_write_block_to_datafile(bpage, sync);
 }
+
+/********************************************************************//**
+Prints the number of batches and the average write latency of each
+parallel doublewrite buffer. */
+UNIV_INTERN
+void
+buf_dblwr_print(
+/*============*/
+	FILE*	file)	/*!< in/out: buffer where to print */
+{
+	if (buf_dblwr_parallel == NULL) {
+		return;
+	}
+
+	for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
+		const buf_dblwr_t*	dblwr = buf_dblwr_parallel[i];
+		ulint			n_batches = dblwr->n_batches;
+
+		fprintf(file,
+			"Parallel doublewrite %lu: " ULINTPF " batches, "
+			ULINTPF " pages, %.2f us per batch write\n",
+			(ulong) i, n_batches, dblwr->n_pages,
+			n_batches
+			? (double) dblwr->write_us / n_batches : 0.0);
+	}
+}
 #endif /* !UNIV_HOTBACKUP */
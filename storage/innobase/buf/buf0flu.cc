@@ -64,8 +64,77 @@ UNIV_INTERN ibool buf_lru_manager_is_active = FALSE;
 #ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_thread_key;
 UNIV_INTERN mysql_pfs_key_t buf_lru_manager_thread_key;
+UNIV_INTERN mysql_pfs_key_t buf_page_cleaner_worker_thread_key;
 #endif /* UNIV_PFS_THREAD */
 
+#ifdef UNIV_PFS_MUTEX
+UNIV_INTERN mysql_pfs_key_t page_cleaner_mutex_key;
+#endif /* UNIV_PFS_MUTEX */
+
+/** State of a batch requested on one buffer pool instance */
+enum page_cleaner_state_t {
+	PAGE_CLEANER_STATE_NONE = 0,	/*!< no batch requested */
+	PAGE_CLEANER_STATE_REQUESTED,	/*!< waiting for a page cleaner */
+	PAGE_CLEANER_STATE_FLUSHING,	/*!< a page cleaner is running it */
+	PAGE_CLEANER_STATE_FINISHED	/*!< finished, the coordinator has
+					not yet collected the result */
+};
+
+/** Batches requested on one buffer pool instance. An LRU batch and a
+flush list batch can be requested at the same time. */
+struct page_cleaner_slot_t {
+	page_cleaner_state_t	state[BUF_FLUSH_N_TYPES];
+					/*!< state of the LRU and of the
+					flush list batch */
+	ulint			min_n;	/*!< flush list batch: wished
+					minimum number of blocks flushed */
+	lsn_t			lsn_limit;
+					/*!< flush list batch: lsn limit */
+	bool			success;/*!< flush list batch: false if
+					another flush list batch was running
+					on the instance */
+	ulint			n_flushed[BUF_FLUSH_N_TYPES];
+					/*!< pages flushed by the batches */
+	ulint			n_evicted;
+					/*!< pages evicted by the LRU batch */
+};
+
+/** Page cleaner coordination. The page_cleaner thread coordinates the
+flush list batches and the lru_manager thread the LRU batches: each
+coordinator requests a batch on every buffer pool instance and runs them
+together with srv_n_page_cleaners - 1 page cleaner worker threads. */
+struct page_cleaner_t {
+	ib_mutex_t		mutex;	/*!< protects the fields below and
+					the slots, except the results of a
+					slot whose batch is being run */
+	os_event_t		is_requested;
+					/*!< set when batches are requested
+					or the workers must exit */
+	os_event_t		is_finished;
+					/*!< set when all the batches of a
+					type have finished */
+	ulint			n_slots;/*!< number of buffer pool
+					instances */
+	page_cleaner_slot_t*	slots;	/*!< one slot per buffer pool
+					instance */
+	ulint			n_requested[BUF_FLUSH_N_TYPES];
+					/*!< number of slots in
+					PAGE_CLEANER_STATE_REQUESTED */
+	ulint			n_finished[BUF_FLUSH_N_TYPES];
+					/*!< number of slots in
+					PAGE_CLEANER_STATE_FINISHED */
+	ulint			n_workers;
+					/*!< number of running worker
+					threads */
+	bool			is_running;
+					/*!< false when the workers must
+					exit */
+};
+
+/** The page cleaner coordination, or NULL if there are no page cleaner
+worker threads */
+static page_cleaner_t*	page_cleaner = NULL;
+
 /** Event to synchronise with the flushing. */
  os_event_t	buf_lru_event;
 
@@ -1050,7 +1119,8 @@ buf_flush_page(
 			/* avoiding deadlock possibility involves doublewrite
 			buffer, should flush it, because it might hold the
 			another block->lock. */
-			buf_dblwr_flush_buffered_writes();
+			buf_dblwr_flush_buffered_writes_instance(
+				buf_pool_index(buf_pool));
 
 			rw_lock_s_lock_gen(rw_lock, BUF_IO_WRITE);
                 }
@@ -1676,6 +1746,7 @@ buf_flush_batch(
 					min_n), otherwise ignored */
 {
 	std::pair<ulint, ulint>	res;
+	ullint			start_time;
 
 	ut_ad(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
 #ifdef UNIV_SYNC_DEBUG
@@ -1683,6 +1754,8 @@ buf_flush_batch(
 	      || sync_thread_levels_empty_except_dict());
 #endif /* UNIV_SYNC_DEBUG */
 
+	start_time = ut_time_us(NULL);
+
 	buf_pool_mutex_enter(buf_pool);
 
 	/* Note: The buffer pool mutex is released and reacquired within
@@ -1699,6 +1772,9 @@ buf_flush_batch(
 		ut_error;
 	}
 
+	buf_pool->n_flush_batches[flush_type]++;
+	buf_pool->flush_batch_time[flush_type] += ut_time_us(NULL) - start_time;
+
 	buf_pool_mutex_exit(buf_pool);
 
 #ifdef UNIV_DEBUG
@@ -1719,10 +1795,11 @@ static
 void
 buf_flush_common(
 /*=============*/
+	buf_pool_t*	buf_pool,	/*!< in: buffer pool instance */
 	buf_flush_t	flush_type,	/*!< in: type of flush */
 	ulint		page_count)	/*!< in: number of pages flushed */
 {
-	buf_dblwr_flush_buffered_writes();
+	buf_dblwr_flush_buffered_writes_instance(buf_pool_index(buf_pool));
 
 	ut_a(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
 
@@ -1793,7 +1870,8 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes_instance(
+			buf_pool_index(buf_pool));
 	}
 }
 
@@ -1875,6 +1953,52 @@ buf_flush_do_batch(
 	return(true);
 }
 
+/*******************************************************************//**
+Flushes dirty blocks from the end of the flush list of one buffer pool
+instance, see buf_flush_list().
+@return true if the batch ran, false if another flush list batch was
+already running on the instance */
+static
+bool
+buf_flush_list_instance(
+/*====================*/
+	buf_pool_t*	buf_pool,	/*!< in/out: buffer pool instance */
+	ulint		min_n,		/*!< in: wished minimum mumber of blocks
+					flushed */
+	lsn_t		lsn_limit,	/*!< in: all blocks whose
+					oldest_modification is smaller than
+					this should be flushed (if their
+					number does not exceed min_n) */
+	ulint*		n_processed)	/*!< out: the number of pages
+					which were processed */
+{
+	std::pair<ulint, ulint>	res;
+
+	*n_processed = 0;
+
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		return(false);
+	}
+
+	res = buf_flush_batch(buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
+
+	buf_flush_end(buf_pool, BUF_FLUSH_LIST);
+
+	buf_flush_common(buf_pool, BUF_FLUSH_LIST, res.first);
+
+	if (res.first) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_FLUSH_BATCH_TOTAL_PAGE,
+			MONITOR_FLUSH_BATCH_COUNT,
+			MONITOR_FLUSH_BATCH_PAGES,
+			res.first);
+	}
+
+	*n_processed = res.first;
+
+	return(true);
+}
+
 /*******************************************************************//**
 This utility flushes dirty blocks from the end of the flush list of
 all buffer pool instances.
@@ -1917,12 +2041,10 @@ buf_flush_list(
 
 	/* Flush to lsn_limit in all buffer pool instances */
 	for (i = 0; i < srv_buf_pool_instances; i++) {
-		buf_pool_t*		buf_pool;
-		std::pair<ulint, ulint>	res;
+		ulint	n_flushed;
 
-		buf_pool = buf_pool_from_array(i);
-
-		if (!buf_flush_start(buf_pool, BUF_FLUSH_LIST)) {
+		if (!buf_flush_list_instance(buf_pool_from_array(i),
+					     min_n, lsn_limit, &n_flushed)) {
 			/* We have two choices here. If lsn_limit was
 			specified then skipping an instance of buffer
 			pool means we cannot guarantee that all pages
@@ -1938,23 +2060,8 @@ buf_flush_list(
 			continue;
 		}
 
-		res = buf_flush_batch(
-			buf_pool, BUF_FLUSH_LIST, min_n, lsn_limit);
-
-		buf_flush_end(buf_pool, BUF_FLUSH_LIST);
-
-		buf_flush_common(BUF_FLUSH_LIST, res.first);
-
 		if (n_processed) {
-			*n_processed += res.first;
-		}
-
-		if (res.first) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_FLUSH_BATCH_TOTAL_PAGE,
-				MONITOR_FLUSH_BATCH_COUNT,
-				MONITOR_FLUSH_BATCH_PAGES,
-				res.first);
+			*n_processed += n_flushed;
 		}
 	}
 
@@ -2111,6 +2218,60 @@ buf_flush_LRU_lists(void)
 	return(n_flushed);
 }
 
+/*********************************************************************//**
+Clears up tail of the LRU list of one buffer pool instance, see
+buf_flush_LRU_tail().
+@return pages flushed and pages evicted */
+static
+std::pair<ulint, ulint>
+buf_flush_LRU_tail_instance(
+/*========================*/
+	buf_pool_t*	buf_pool)	/*!< in/out: buffer pool instance */
+{
+	std::pair<ulint, ulint>	res;
+	ulint			scan_depth;
+
+	/* srv_LRU_scan_depth can be arbitrarily large value.
+	We cap it with current LRU size. */
+	buf_pool_mutex_enter(buf_pool);
+	scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
+	buf_pool_mutex_exit(buf_pool);
+
+	scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
+
+	/* Currently page_cleaner is the only thread
+	that can trigger an LRU flush. It is possible
+	that a batch triggered during last iteration is
+	still running, */
+	if (!buf_flush_start(buf_pool, BUF_FLUSH_LRU)) {
+		return(std::make_pair(0, 0));
+	}
+
+	res = buf_flush_batch(buf_pool, BUF_FLUSH_LRU, scan_depth, 0);
+
+	buf_flush_end(buf_pool, BUF_FLUSH_LRU);
+
+	buf_flush_common(buf_pool, BUF_FLUSH_LRU, res.first);
+
+	if (res.first) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_FLUSH_COUNT,
+			MONITOR_LRU_BATCH_FLUSH_PAGES,
+			res.first);
+	}
+
+	if (res.second) {
+		MONITOR_INC_VALUE_CUMULATIVE(
+			MONITOR_LRU_BATCH_EVICT_TOTAL_PAGE,
+			MONITOR_LRU_BATCH_EVICT_COUNT,
+			MONITOR_LRU_BATCH_EVICT_PAGES,
+			res.second);
+	}
+
+	return(res);
+}
+
 /*********************************************************************//**
 Clears up tail of the LRU lists:
 * Put replaceable pages at the tail of LRU to the free list
@@ -2126,48 +2287,9 @@ buf_flush_LRU_tail(void)
 	ulint	total_processed = 0;
 
 	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
-
-		buf_pool_t*	buf_pool = buf_pool_from_array(i);
 		std::pair<ulint, ulint>	res;
-		ulint	scan_depth;
-
-		/* srv_LRU_scan_depth can be arbitrarily large value.
-		We cap it with current LRU size. */
-		buf_pool_mutex_enter(buf_pool);
-		scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
-		buf_pool_mutex_exit(buf_pool);
-
-		scan_depth = ut_min(srv_LRU_scan_depth, scan_depth);
-
-		/* Currently page_cleaner is the only thread
-		that can trigger an LRU flush. It is possible
-		that a batch triggered during last iteration is
-		still running, */
-		if (!buf_flush_start(buf_pool, BUF_FLUSH_LRU)) {
-			continue;
-		}
-
-		res = buf_flush_batch(buf_pool, BUF_FLUSH_LRU, scan_depth, 0);
-
-		buf_flush_end(buf_pool, BUF_FLUSH_LRU);
-
-		buf_flush_common(BUF_FLUSH_LRU, res.first);
-
-		if (res.first) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_LRU_BATCH_FLUSH_TOTAL_PAGE,
-				MONITOR_LRU_BATCH_FLUSH_COUNT,
-				MONITOR_LRU_BATCH_FLUSH_PAGES,
-				res.first);
-		}
 
-		if (res.second) {
-			MONITOR_INC_VALUE_CUMULATIVE(
-				MONITOR_LRU_BATCH_EVICT_TOTAL_PAGE,
-				MONITOR_LRU_BATCH_EVICT_COUNT,
-				MONITOR_LRU_BATCH_EVICT_PAGES,
-				res.second);
-		}
+		res = buf_flush_LRU_tail_instance(buf_pool_from_array(i));
 
 		total_processed += (res.first + res.second);
 	}
@@ -2200,6 +2322,353 @@ buf_flush_wait_LRU_batch_end(void)
 	}
 }
 
+/*********************************************************************//**
+Picks a requested batch, runs it and marks it finished.
+@return true if a batch was run, false if there were no requested
+batches of the given type */
+static
+bool
+page_cleaner_flush_slot(
+/*====================*/
+	buf_flush_t	type)	/*!< in: BUF_FLUSH_LRU or BUF_FLUSH_LIST,
+				or BUF_FLUSH_N_TYPES for either of them */
+{
+	page_cleaner_slot_t*	slot = NULL;
+	ulint			i;
+
+	mutex_enter(&page_cleaner->mutex);
+
+	/* The LRU batches come first, because user threads may be
+	waiting for free blocks */
+	if (type == BUF_FLUSH_N_TYPES) {
+		type = page_cleaner->n_requested[BUF_FLUSH_LRU] > 0
+			? BUF_FLUSH_LRU : BUF_FLUSH_LIST;
+	}
+
+	ut_ad(type == BUF_FLUSH_LRU || type == BUF_FLUSH_LIST);
+
+	if (page_cleaner->n_requested[type] == 0) {
+		mutex_exit(&page_cleaner->mutex);
+
+		return(false);
+	}
+
+	for (i = 0; i < page_cleaner->n_slots; i++) {
+		slot = &page_cleaner->slots[i];
+
+		if (slot->state[type] == PAGE_CLEANER_STATE_REQUESTED) {
+			break;
+		}
+	}
+
+	ut_a(i < page_cleaner->n_slots);
+
+	slot->state[type] = PAGE_CLEANER_STATE_FLUSHING;
+	page_cleaner->n_requested[type]--;
+
+	mutex_exit(&page_cleaner->mutex);
+
+	if (type == BUF_FLUSH_LRU) {
+		std::pair<ulint, ulint>	res;
+
+		res = buf_flush_LRU_tail_instance(buf_pool_from_array(i));
+
+		slot->n_flushed[BUF_FLUSH_LRU] = res.first;
+		slot->n_evicted = res.second;
+	} else {
+		slot->success = buf_flush_list_instance(
+			buf_pool_from_array(i), slot->min_n, slot->lsn_limit,
+			&slot->n_flushed[BUF_FLUSH_LIST]);
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+
+	slot->state[type] = PAGE_CLEANER_STATE_FINISHED;
+
+	if (++page_cleaner->n_finished[type] == page_cleaner->n_slots) {
+		os_event_set(page_cleaner->is_finished);
+	}
+
+	mutex_exit(&page_cleaner->mutex);
+
+	return(true);
+}
+
+/*********************************************************************//**
+Requests a batch on every buffer pool instance, runs the requested batches
+together with the page cleaner workers and waits for all of them to
+finish. Only one coordinator may request batches of a given type.
+@return true if a flush list batch was run on every instance, false if
+another flush list batch was already running on at least one of them */
+static
+bool
+page_cleaner_run_batches(
+/*=====================*/
+	buf_flush_t	type,		/*!< in: BUF_FLUSH_LRU or
+					BUF_FLUSH_LIST */
+	ulint		min_n,		/*!< in: flush list batch: wished
+					minimum number of blocks flushed in
+					each instance */
+	lsn_t		lsn_limit,	/*!< in: flush list batch: lsn
+					limit */
+	ulint*		n_flushed,	/*!< out: pages flushed */
+	ulint*		n_evicted)	/*!< out: pages evicted by the LRU
+					batches, ignored if NULL */
+{
+	bool	success = true;
+	ulint	i;
+
+	ut_ad(type == BUF_FLUSH_LRU || type == BUF_FLUSH_LIST);
+
+	mutex_enter(&page_cleaner->mutex);
+
+	ut_ad(page_cleaner->n_requested[type] == 0);
+	ut_ad(page_cleaner->n_finished[type] == 0);
+
+	for (i = 0; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		ut_ad(slot->state[type] == PAGE_CLEANER_STATE_NONE);
+
+		slot->state[type] = PAGE_CLEANER_STATE_REQUESTED;
+
+		if (type == BUF_FLUSH_LIST) {
+			slot->min_n = min_n;
+			slot->lsn_limit = lsn_limit;
+		}
+	}
+
+	page_cleaner->n_requested[type] = page_cleaner->n_slots;
+
+	os_event_set(page_cleaner->is_requested);
+
+	mutex_exit(&page_cleaner->mutex);
+
+	/* Work on the requested batches too, so that they are run even
+	if all the workers are busy or have exited */
+	while (page_cleaner_flush_slot(type)) {
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+
+	while (page_cleaner->n_finished[type] < page_cleaner->n_slots) {
+		ib_int64_t	sig_count;
+
+		sig_count = os_event_reset(page_cleaner->is_finished);
+
+		mutex_exit(&page_cleaner->mutex);
+
+		os_event_wait_low(page_cleaner->is_finished, sig_count);
+
+		mutex_enter(&page_cleaner->mutex);
+	}
+
+	*n_flushed = 0;
+
+	if (n_evicted != NULL) {
+		*n_evicted = 0;
+	}
+
+	for (i = 0; i < page_cleaner->n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner->slots[i];
+
+		ut_ad(slot->state[type] == PAGE_CLEANER_STATE_FINISHED);
+
+		slot->state[type] = PAGE_CLEANER_STATE_NONE;
+
+		*n_flushed += slot->n_flushed[type];
+
+		if (type == BUF_FLUSH_LRU) {
+			if (n_evicted != NULL) {
+				*n_evicted += slot->n_evicted;
+			}
+		} else if (!slot->success) {
+			success = false;
+		}
+	}
+
+	page_cleaner->n_finished[type] = 0;
+
+	mutex_exit(&page_cleaner->mutex);
+
+	return(success);
+}
+
+/******************************************************************//**
+page_cleaner worker thread, running the LRU and flush list batches that
+the page_cleaner and lru_manager threads request.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(buf_page_cleaner_worker_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+#ifdef UNIV_DEBUG_THREAD_CREATION
+	fprintf(stderr, "InnoDB: page_cleaner worker running, id %lu\n",
+		os_thread_pf(os_thread_get_curr_id()));
+#endif /* UNIV_DEBUG_THREAD_CREATION */
+
+	for (;;) {
+		ib_int64_t	sig_count;
+		bool		is_running;
+
+		sig_count = os_event_reset(page_cleaner->is_requested);
+
+		if (page_cleaner_flush_slot(BUF_FLUSH_N_TYPES)) {
+			continue;
+		}
+
+		mutex_enter(&page_cleaner->mutex);
+		is_running = page_cleaner->is_running;
+		mutex_exit(&page_cleaner->mutex);
+
+		if (!is_running) {
+			break;
+		}
+
+		os_event_wait_low(page_cleaner->is_requested, sig_count);
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+	ut_a(page_cleaner->n_workers > 0);
+	page_cleaner->n_workers--;
+	mutex_exit(&page_cleaner->mutex);
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+Creates the page cleaner coordination and starts srv_n_page_cleaners - 1
+page cleaner worker threads. Without workers the page_cleaner and
+lru_manager threads flush all the buffer pool instances themselves. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void)
+/*=============================*/
+{
+	ulint	n_workers;
+
+	ut_ad(page_cleaner == NULL);
+	ut_ad(srv_n_page_cleaners <= srv_buf_pool_instances);
+
+	if (srv_n_page_cleaners <= 1) {
+		return;
+	}
+
+	n_workers = srv_n_page_cleaners - 1;
+
+	page_cleaner = static_cast<page_cleaner_t*>(
+		mem_zalloc(sizeof *page_cleaner));
+
+	mutex_create(page_cleaner_mutex_key, &page_cleaner->mutex,
+		     SYNC_PAGE_CLEANER);
+
+	page_cleaner->is_requested = os_event_create();
+	page_cleaner->is_finished = os_event_create();
+
+	page_cleaner->n_slots = srv_buf_pool_instances;
+
+	page_cleaner->slots = static_cast<page_cleaner_slot_t*>(
+		mem_zalloc(page_cleaner->n_slots
+			   * sizeof *page_cleaner->slots));
+
+	page_cleaner->n_workers = n_workers;
+	page_cleaner->is_running = true;
+
+	for (ulint i = 0; i < n_workers; i++) {
+		os_thread_create(buf_flush_page_cleaner_worker, NULL, NULL);
+	}
+}
+
+/******************************************************************//**
+Makes the page cleaner worker threads exit and waits for them. Batches
+requested afterwards are run by the requesting coordinator alone. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_workers_exit(void)
+/*=====================================*/
+{
+	if (page_cleaner == NULL) {
+		return;
+	}
+
+	mutex_enter(&page_cleaner->mutex);
+
+	page_cleaner->is_running = false;
+	os_event_set(page_cleaner->is_requested);
+
+	while (page_cleaner->n_workers > 0) {
+		mutex_exit(&page_cleaner->mutex);
+
+		os_thread_sleep(10000);
+
+		mutex_enter(&page_cleaner->mutex);
+	}
+
+	mutex_exit(&page_cleaner->mutex);
+}
+
+/******************************************************************//**
+Frees the page cleaner coordination. The page cleaner threads must have
+exited. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_close(void)
+/*==============================*/
+{
+	if (page_cleaner == NULL) {
+		return;
+	}
+
+	ut_ad(!page_cleaner->is_running);
+	ut_ad(page_cleaner->n_workers == 0);
+	ut_ad(!buf_page_cleaner_is_active);
+	ut_ad(!buf_lru_manager_is_active);
+
+	mutex_free(&page_cleaner->mutex);
+
+	os_event_free(page_cleaner->is_requested);
+	os_event_free(page_cleaner->is_finished);
+
+	mem_free(page_cleaner->slots);
+	mem_free(page_cleaner);
+
+	page_cleaner = NULL;
+}
+
+/*********************************************************************//**
+Runs an LRU batch on all the buffer pool instances, see
+buf_flush_LRU_tail(). Used by the lru_manager thread, which runs the
+batches with the page cleaner workers if there are any.
+@return total pages processed */
+static
+ulint
+lru_manager_do_LRU_batch(void)
+/*==========================*/
+{
+	ulint	n_flushed;
+	ulint	n_evicted;
+
+	if (page_cleaner == NULL) {
+		return(buf_flush_LRU_tail());
+	}
+
+	page_cleaner_run_batches(BUF_FLUSH_LRU, 0, 0, &n_flushed, &n_evicted);
+
+	return(n_flushed + n_evicted);
+}
+
 /*********************************************************************//**
 Flush a batch of dirty pages from the flush list
 @return number of pages flushed, 0 if no page is flushed or if another
@@ -2215,7 +2684,21 @@ page_cleaner_do_flush_batch(
 {
 	ulint n_flushed;
 
-	buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
+	if (page_cleaner == NULL) {
+		buf_flush_list(n_to_flush, lsn_limit, &n_flushed);
+
+		return(n_flushed);
+	}
+
+	/* Spread the flushing evenly amongst the buffer pool instances,
+	as buf_flush_list() does */
+	if (n_to_flush != ULINT_MAX) {
+		n_to_flush = (n_to_flush + srv_buf_pool_instances - 1)
+			     / srv_buf_pool_instances;
+	}
+
+	page_cleaner_run_batches(BUF_FLUSH_LIST, n_to_flush, lsn_limit,
+				 &n_flushed, NULL);
 
 	return(n_flushed);
 }
@@ -2717,7 +3200,7 @@ DECLARE_THREAD(buf_flush_lru_manager_thread)(
 
 		next_loop_time = ut_time_ms() + lru_sleep_time;
 
-		buf_flush_LRU_tail();
+		lru_manager_do_LRU_batch();
 	}
 
 	buf_lru_manager_is_active = false;
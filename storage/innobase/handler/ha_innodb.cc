@@ -323,6 +323,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&server_mutex_key, "server_mutex", 0},
 #  endif /* !HAVE_ATOMIC_BUILTINS */
 	{&log_sys_mutex_key, "log_sys_mutex", 0},
+	{&log_write_mutex_key, "log_write_mutex", 0},
 #  ifdef UNIV_MEM_DEBUG
 	{&mem_hash_mutex_key, "mem_hash_mutex", 0},
 #  endif /* UNIV_MEM_DEBUG */
@@ -332,6 +333,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&purge_sys_bh_mutex_key, "purge_sys_bh_mutex", 0},
 	{&recv_sys_mutex_key, "recv_sys_mutex", 0},
 	{&recv_writer_mutex_key, "recv_writer_mutex", 0},
+	{&page_cleaner_mutex_key, "page_cleaner_mutex", 0},
 	{&rseg_mutex_key, "rseg_mutex", 0},
 #  ifdef UNIV_SYNC_DEBUG
 	{&rw_lock_debug_mutex_key, "rw_lock_debug_mutex", 0},
@@ -352,6 +354,8 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&srv_sys_mutex_key, "srv_sys_mutex", 0},
 	{&lock_sys_mutex_key, "lock_mutex", 0},
 	{&lock_sys_wait_mutex_key, "lock_wait_mutex", 0},
+	{&lock_sys_shard_mutex_key, "lock_shard_mutex", 0},
+	{&lock_sys_table_mutex_key, "lock_table_mutex", 0},
 	{&trx_mutex_key, "trx_mutex", 0},
 	{&srv_sys_tasks_mutex_key, "srv_threads_mutex", 0},
 	/* mutex with os_fast_mutex_ interfaces */
@@ -396,6 +400,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	{&index_tree_rw_lock_key, "index_tree_rw_lock", 0},
 	{&index_online_log_key, "index_online_log", 0},
 	{&dict_table_stats_key, "dict_table_stats", 0},
+	{&lock_sys_latch_key, "lock_sys_latch", 0},
 	{&hash_table_rw_lock_key, "hash_table_locks", 0}
 };
 # endif /* UNIV_PFS_RWLOCK */
@@ -414,7 +419,11 @@ static PSI_thread_info	all_innodb_threads[] = {
 	{&srv_purge_thread_key, "srv_purge_thread", 0},
 	{&buf_page_cleaner_thread_key, "page_cleaner_thread", 0},
 	{&buf_lru_manager_thread_key, "lru_manager_thread", 0},
-	{&recv_writer_thread_key, "recv_writer_thread", 0}
+	{&buf_page_cleaner_worker_thread_key, "page_cleaner_worker_thread", 0},
+	{&recv_writer_thread_key, "recv_writer_thread", 0},
+	{&recv_apply_thread_key, "recv_apply_thread", 0},
+	{&log_writer_thread_key, "log_writer_thread", 0},
+	{&log_flusher_thread_key, "log_flusher_thread", 0}
 };
 # endif /* UNIV_PFS_THREAD */
 
@@ -4035,6 +4044,24 @@ innobase_change_buffering_inited_ok:
 
 	srv_log_buffer_size = (ulint) innobase_log_buffer_size;
 
+#ifndef HAVE_ATOMIC_BUILTINS_64
+	if (srv_log_writer_threads) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"innodb_log_writer_threads requires 64-bit atomic"
+			" operations, which are not available on this"
+			" platform; disabling it.");
+		srv_log_writer_threads = FALSE;
+	}
+#endif /* !HAVE_ATOMIC_BUILTINS_64 */
+#ifdef UNIV_LOG_ARCHIVE
+	if (srv_log_writer_threads) {
+		ib_logf(IB_LOG_LEVEL_WARN,
+			"innodb_log_writer_threads is not supported with"
+			" log archiving; disabling it.");
+		srv_log_writer_threads = FALSE;
+	}
+#endif /* UNIV_LOG_ARCHIVE */
+
 	if (innobase_buffer_pool_instances == 0) {
 		innobase_buffer_pool_instances = 8;
 
@@ -8658,11 +8685,9 @@ ha_innobase::index_read(
 		error = 0;
 		table->status = 0;
 		if (prebuilt->table->is_system_db)
-			srv_stats.n_system_rows_read.add(
-				(size_t) prebuilt->trx->id, 1);
+			srv_stats.n_system_rows_read.inc();
 		else
-			srv_stats.n_rows_read.add(
-				(size_t) prebuilt->trx->id, 1);
+			srv_stats.n_rows_read.inc();
 		stats.rows_read++;
 		stats.rows_index_first++;
 		break;
@@ -8967,11 +8992,9 @@ ha_innobase::general_fetch(
 		error = 0;
 		table->status = 0;
 		if (prebuilt->table->is_system_db)
-			srv_stats.n_system_rows_read.add(
-				(size_t) prebuilt->trx->id, 1);
+			srv_stats.n_system_rows_read.inc();
 		else
-			srv_stats.n_rows_read.add(
-				(size_t) prebuilt->trx->id, 1);
+			srv_stats.n_rows_read.inc();
 		stats.rows_read++;
 		stats.rows_index_next++;
 		break;
@@ -17440,11 +17463,11 @@ checkpoint_now_set(
 						check function */
 {
 	if (*(my_bool*) save) {
-		while (log_sys->last_checkpoint_lsn < log_sys->lsn) {
+		while (log_sys->last_checkpoint_lsn < log_get_lsn_low()) {
 			log_make_checkpoint_at(LSN_MAX, TRUE);
 			fil_flush_file_spaces(FIL_LOG, FLUSH_FROM_OTHER);
 		}
-		fil_write_flushed_lsn_to_data_files(log_sys->lsn, 0);
+		fil_write_flushed_lsn_to_data_files(log_get_lsn_low(), 0);
 		fil_flush_file_spaces(FIL_TABLESPACE, FLUSH_FROM_OTHER);
 	}
 }
@@ -17695,6 +17718,13 @@ static MYSQL_SYSVAR_ULONG(doublewrite, srv_use_doublewrite_buf,
   "2=Enable reduced doublewrite mode. ",
   NULL, innodb_doublewrite_update, 1, 0, 2, 0);
 
+static MYSQL_SYSVAR_BOOL(parallel_doublewrite, srv_parallel_doublewrite,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use one doublewrite file per buffer pool instance for LRU and flush "
+  "list batches, so that the batches of different instances are not "
+  "serialized.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(stats_include_delete_marked,
   srv_stats_include_delete_marked,
   PLUGIN_VAR_OPCMDARG,
@@ -17983,6 +18013,13 @@ static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   "Disable with --skip-innodb-adaptive-hash-index.",
   NULL, innodb_adaptive_hash_index_update, TRUE);
 
+static MYSQL_SYSVAR_ULONG(adaptive_hash_index_parts, btr_ahi_parts,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Number of InnoDB adaptive hash index partitions, each protected by "
+  "its own latch. Indexes are mapped to a partition by index id "
+  "(default 8).",
+  NULL, NULL, 8, 1, 512, 0);
+
 static MYSQL_SYSVAR_ULONG(replication_delay, srv_replication_delay,
   PLUGIN_VAR_RQCMDARG,
   "Replication thread delay (ms) on the slave server if "
@@ -18136,6 +18173,13 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_populate, srv_buf_pool_populate,
   "established by the buffer pool memory region. Disabled by default.",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(page_hash_optimistic_lookup,
+  srv_page_hash_optimistic_lookup,
+  PLUGIN_VAR_NOCMDARG,
+  "Look up pages that are already in the buffer pool without acquiring "
+  "the page_hash locks. Enabled by default.",
+  NULL, NULL, TRUE);
+
 static MYSQL_SYSVAR_LONG(buffer_pool_instances, innobase_buffer_pool_instances,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Number of buffer pool instances, set to higher value on high-end machines to increase scalability",
@@ -18265,6 +18309,12 @@ static MYSQL_SYSVAR_ULONG(lru_scan_depth, srv_LRU_scan_depth,
   "How deep to scan LRU to keep it clean",
   NULL, NULL, 1024, 100, ~0UL, 0);
 
+static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads running the LRU and flush list batches of the buffer"
+  " pool instances. Capped at innodb_buffer_pool_instances.",
+  NULL, NULL, 4, 1, MAX_BUFFER_POOLS, 0);
+
 static MYSQL_SYSVAR_ULONG(flush_neighbors, srv_flush_neighbors,
   PLUGIN_VAR_OPCMDARG,
   "Set to 0 (don't flush neighbors from buffer pool),"
@@ -18370,6 +18420,12 @@ static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   "Helps to save your data in case the disk image of the database becomes corrupt.",
   NULL, NULL, 0, 0, 6, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_n_recv_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log records to pages during crash"
+  " recovery.",
+  NULL, NULL, 4, 1, 64, 0);
+
 #ifndef DBUG_OFF
 static MYSQL_SYSVAR_ULONG(force_recovery_crash, srv_force_recovery_crash,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
@@ -18388,6 +18444,13 @@ static MYSQL_SYSVAR_LONG(log_buffer_size, innobase_log_buffer_size,
   "The size of the buffer which InnoDB uses to write log to the log files on disk.",
   NULL, NULL, 16*1024*1024L, 256*1024L, LONG_MAX, 1024);
 
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Let mini-transactions write the redo log concurrently, without the log"
+  " mutex, and use dedicated log writer and log flusher threads to write and"
+  " flush it to disk.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_LONGLONG(log_file_size, innobase_log_file_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Size of each log file in a log group.",
@@ -18777,6 +18840,14 @@ static MYSQL_SYSVAR_BOOL(deadlock_detect, srv_deadlock_detect,
   "Enableds deadlock detection checking.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(lock_sys_shards, srv_lock_sys_shards,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of shards of the record lock hash table. Lock requests that do"
+  " not have to wait, and the release of locks at commit, only latch the"
+  " shard of the page and a separate table lock mutex. 1 serializes all"
+  " lock operations on the lock system mutex.",
+  NULL, NULL, 16, 1, 1024, 0);
+
 static MYSQL_SYSVAR_ULONG(lru_manager_max_sleep_time, srv_cleaner_max_lru_time,
   PLUGIN_VAR_RQCMDARG,
   "The maximum time limit for a single LRU tail flush iteration by the lru "
@@ -18835,6 +18906,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoextend_increment),
   MYSQL_SYSVAR(buffer_pool_size),
   MYSQL_SYSVAR(buffer_pool_populate),
+  MYSQL_SYSVAR(page_hash_optimistic_lookup),
   MYSQL_SYSVAR(buffer_pool_chunk_size),
   MYSQL_SYSVAR(sync_pool_size),
   MYSQL_SYSVAR(buffer_pool_instances),
@@ -18868,6 +18940,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(defragment_fill_factor),
   MYSQL_SYSVAR(defragment_fill_factor_n_recs),
   MYSQL_SYSVAR(lru_scan_depth),
+  MYSQL_SYSVAR(page_cleaners),
   MYSQL_SYSVAR(flush_neighbors),
   MYSQL_SYSVAR(checksum_algorithm),
   MYSQL_SYSVAR(checksums),
@@ -18877,7 +18950,9 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(lock_sys_shards),
   MYSQL_SYSVAR(doublewrite),
+  MYSQL_SYSVAR(parallel_doublewrite),
   MYSQL_SYSVAR(stats_include_delete_marked),
   MYSQL_SYSVAR(api_enable_binlog),
   MYSQL_SYSVAR(api_enable_mdl),
@@ -18897,6 +18972,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #ifndef DBUG_OFF
   MYSQL_SYSVAR(force_recovery_crash),
 #endif /* !DBUG_OFF */
+  MYSQL_SYSVAR(recovery_apply_threads),
   MYSQL_SYSVAR(force_index_records_in_range),
   MYSQL_SYSVAR(ft_cache_size),
   MYSQL_SYSVAR(ft_total_cache_size),
@@ -18916,6 +18992,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* UNIV_LOG_ARCHIVE */
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
+  MYSQL_SYSVAR(log_writer_threads),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_group_home_dir),
@@ -18946,6 +19023,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_auto_recalc),
   MYSQL_SYSVAR(stats_recalc_threshold),
   MYSQL_SYSVAR(adaptive_hash_index),
+  MYSQL_SYSVAR(adaptive_hash_index_parts),
   MYSQL_SYSVAR(stats_method),
   MYSQL_SYSVAR(replication_delay),
   MYSQL_SYSVAR(status_file),
@@ -4901,6 +4901,42 @@ static ST_FIELD_INFO	i_s_innodb_buffer_stats_fields_info[] =
 	 STRUCT_FLD(old_name,		""),
 	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
 
+#define IDX_BUF_STATS_LRU_BATCHES	32
+	{STRUCT_FLD(field_name,		"LRU_BATCHES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_BUF_STATS_LRU_BATCH_TIME	33
+	{STRUCT_FLD(field_name,		"LRU_BATCH_TIME_US"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_BUF_STATS_FLUSH_LIST_BATCHES	34
+	{STRUCT_FLD(field_name,		"FLUSH_LIST_BATCHES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define IDX_BUF_STATS_FLUSH_LIST_BATCH_TIME	35
+	{STRUCT_FLD(field_name,		"FLUSH_LIST_BATCH_TIME_US"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
 	END_OF_ST_FIELD_INFO
 };
 
@@ -5034,6 +5070,18 @@ i_s_innodb_stats_fill(
 	OK(fields[IDX_BUF_STATS_UNZIP_CUR]->store(
 		static_cast<double>(info->unzip_cur)));
 
+	OK(fields[IDX_BUF_STATS_LRU_BATCHES]->store(
+		static_cast<double>(info->n_lru_batches)));
+
+	OK(fields[IDX_BUF_STATS_LRU_BATCH_TIME]->store(
+		static_cast<double>(info->lru_batch_time)));
+
+	OK(fields[IDX_BUF_STATS_FLUSH_LIST_BATCHES]->store(
+		static_cast<double>(info->n_flush_list_batches)));
+
+	OK(fields[IDX_BUF_STATS_FLUSH_LIST_BATCH_TIME]->store(
+		static_cast<double>(info->flush_list_batch_time)));
+
 	DBUG_RETURN(schema_table_store_record(thd, table));
 }
 
@@ -40,11 +40,13 @@ UNIV_INTERN
 void
 btr_search_sys_create(
 /*==================*/
-	ulint	hash_size);	/*!< in: hash index hash table size */
+	ulint	hash_size);	/*!< in: hash index hash table size,
+				divided among btr_ahi_parts partitions */
 
 /**
 Resize hash index hash table.
-@param	[in]	hash_size	hash index hash table size */
+@param	[in]	hash_size	hash index hash table size, divided among
+				btr_ahi_parts partitions */
 
 void
 btr_search_sys_resize(
@@ -70,6 +72,66 @@ void
 btr_search_enable(void);
 /*====================*/
 
+/********************************************************************//**
+Returns the latch protecting the adaptive hash index partition of an index.
+@return	search latch of the partition the index is mapped to */
+UNIV_INLINE
+rw_lock_t*
+btr_get_search_latch(
+/*=================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/********************************************************************//**
+Returns the hash table of the adaptive hash index partition of an index.
+@return	hash table of the partition the index is mapped to */
+UNIV_INLINE
+hash_table_t*
+btr_get_search_table(
+/*=================*/
+	const dict_index_t*	index)	/*!< in: index */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/********************************************************************//**
+X-latches all the adaptive hash index partitions. */
+UNIV_INLINE
+void
+btr_search_x_lock_all(void);
+/*=======================*/
+/********************************************************************//**
+X-unlatches all the adaptive hash index partitions. */
+UNIV_INLINE
+void
+btr_search_x_unlock_all(void);
+/*=========================*/
+/********************************************************************//**
+S-latches all the adaptive hash index partitions. */
+UNIV_INLINE
+void
+btr_search_s_lock_all(void);
+/*=======================*/
+/********************************************************************//**
+S-unlatches all the adaptive hash index partitions. */
+UNIV_INLINE
+void
+btr_search_s_unlock_all(void);
+/*=========================*/
+#ifdef UNIV_SYNC_DEBUG
+/********************************************************************//**
+Checks if the thread owns all the adaptive hash index partition latches.
+@return	TRUE if all the latches are owned in the given mode */
+UNIV_INLINE
+ibool
+btr_search_own_all(
+/*===============*/
+	ulint	mode);	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+/********************************************************************//**
+Checks if the thread owns any of the adaptive hash index partition latches.
+@return	TRUE if any of the latches is owned in the given mode */
+UNIV_INLINE
+ibool
+btr_search_own_any(
+/*===============*/
+	ulint	mode);	/*!< in: RW_LOCK_SHARED or RW_LOCK_EX */
+#endif /* UNIV_SYNC_DEBUG */
 /********************************************************************//**
 Returns search info for an index.
 @return	search info; search mutex reserved */
@@ -88,14 +150,15 @@ btr_search_info_create(
 /*===================*/
 	mem_heap_t*	heap);	/*!< in: heap where created */
 /*****************************************************************//**
-Returns the value of ref_count. The value is protected by
-btr_search_latch.
+Returns the value of ref_count. The value is protected by the search
+latch of the index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info);	/*!< in: search info. */
+	btr_search_t*		info,	/*!< in: search info. */
+	const dict_index_t*	index);	/*!< in: index */
 /*********************************************************************//**
 Updates the search info. */
 UNIV_INLINE
@@ -121,7 +184,8 @@ btr_search_guess_on_hash(
 	ulint		latch_mode,	/*!< in: BTR_SEARCH_LEAF, ... */
 	btr_cur_t*	cursor,		/*!< out: tree cursor */
 	ulint		has_search_latch,/*!< in: latch mode the caller
-					currently has on btr_search_latch:
+					currently has on the search latch
+					of the index:
 					RW_S_LATCH, RW_X_LATCH, or 0 */
 	mtr_t*		mtr);		/*!< in: mtr */
 /********************************************************************//**
@@ -205,7 +269,8 @@ struct btr_search_t{
 	ulint	ref_count;	/*!< Number of blocks in this index tree
 				that have search index built
 				i.e. block->index points to this index.
-				Protected by btr_search_latch except
+				Protected by the search latch of the
+				index except
 				when during initialization in
 				btr_search_info_create(). */
 
@@ -257,9 +322,11 @@ struct btr_search_t{
 
 /** The hash index system */
 struct btr_search_sys_t{
-	hash_table_t*	hash_index;	/*!< the adaptive hash index,
-					mapping dtuple_fold values
-					to rec_t pointers on index pages */
+	hash_table_t**	hash_tables;	/*!< the adaptive hash index
+					partitions, mapping dtuple_fold
+					values to rec_t pointers on index
+					pages; partition i is protected by
+					btr_search_latches[i] */
 };
 
 /** The adaptive hash index */
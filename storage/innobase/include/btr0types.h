@@ -41,9 +41,12 @@ struct btr_search_t;
 
 #ifndef UNIV_HOTBACKUP
 
-/** @brief The latch protecting the adaptive search system
+/** @brief The latches protecting the adaptive search system
 
-This latch protects the
+The adaptive hash index is split into btr_ahi_parts partitions, each
+with its own hash table and latch. An index is mapped to one partition
+by its index id, see btr_get_search_latch(). Each latch protects, for
+the indexes mapped to its partition, the
 (1) hash index;
 (2) columns of a record to which we have a pointer in the hash index;
 
@@ -54,15 +57,16 @@ but does NOT protect:
 
 Bear in mind (3) and (4) when using the hash index.
 */
-extern rw_lock_t*	btr_search_latch_temp;
+extern rw_lock_t**	btr_search_latches;
 
-#endif /* UNIV_HOTBACKUP */
+/** Number of adaptive hash index partitions
+(innodb_adaptive_hash_index_parts) */
+extern ulong		btr_ahi_parts;
 
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
+#endif /* UNIV_HOTBACKUP */
 
 /** Flag: has the search system been enabled?
-Protected by btr_search_latch. */
+Protected by all of btr_search_latches. */
 extern char	btr_search_enabled;
 
 #ifdef UNIV_BLOB_DEBUG
@@ -232,6 +232,14 @@ struct buf_pool_info_t{
 	ulint	unzip_cur;		/*!< buf_LRU_stat_cur.unzip, num
 					pages decompressed in current
 					interval */
+
+	/* Flush batch timing */
+	ulint	n_lru_batches;		/*!< number of LRU batches */
+	ullint	lru_batch_time;		/*!< time spent in LRU batches,
+					in microseconds */
+	ulint	n_flush_list_batches;	/*!< number of flush list batches */
+	ullint	flush_list_batch_time;	/*!< time spent in flush list
+					batches, in microseconds */
 };
 
 /** The occupied bytes of lists in all buffer pools */
@@ -751,6 +759,26 @@ buf_page_is_corrupted(
 					0 for uncompressed pages */
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
 /********************************************************************//**
+Checks a batch of pages of the same size for corruption. The system
+LSN is read once for the whole batch, and the checksums of consecutive
+pages are computed back to back.
+@return	number of corrupted pages */
+UNIV_INTERN
+ulint
+buf_page_is_corrupted_batch(
+/*========================*/
+	bool			check_lsn,	/*!< in: true if we need to
+						check and complain about
+						the LSN */
+	const byte* const*	pages,		/*!< in: database pages */
+	ulint			n_pages,	/*!< in: number of pages */
+	ulint			zip_size,	/*!< in: size of compressed
+						pages; 0 for uncompressed
+						pages */
+	bool*			corrupted)	/*!< out: corrupted[i] is set
+						if pages[i] is corrupted */
+	MY_ATTRIBUTE((nonnull));
+/********************************************************************//**
 Checks if a page is all zeroes.
 @return	TRUE if the page is all zeroes */
 bool
@@ -1834,7 +1862,7 @@ struct buf_block_t{
 
 	/** @name Hash search fields
 	These 5 fields may only be modified when we have
-	an x-latch on btr_search_latch AND
+	an x-latch on the search latch of block->index AND
 	- we are holding an s-latch or x-latch on buf_block_t::lock or
 	- we know that buf_block_t::buf_fix_count == 0.
 
@@ -1842,7 +1870,8 @@ struct buf_block_t{
 	in the buffer pool in buf0buf.cc.
 
 	Another exception is that assigning block->index = NULL
-	is allowed whenever holding an x-latch on btr_search_latch. */
+	is allowed whenever holding an x-latch on the search latch
+	of block->index, or on all of btr_search_latches. */
 
 	/* @{ */
 
@@ -2232,6 +2261,12 @@ struct buf_pool_t{
 	ulint		n_flushed[BUF_FLUSH_N_TYPES];
 					/*!< this is the number of total
 					writes in the given flush type */
+	ulint		n_flush_batches[BUF_FLUSH_N_TYPES];
+					/*!< number of LRU and flush list
+					batches run on this instance */
+	ullint		flush_batch_time[BUF_FLUSH_N_TYPES];
+					/*!< time spent in those batches,
+					in microseconds */
 	os_event_t	no_flush[BUF_FLUSH_N_TYPES];
 					/*!< this is in the set state
 					when there is no flush batch
@@ -37,9 +37,14 @@ Created 2011/12/19 Inaam Rana
 extern buf_dblwr_t*	buf_dblwr;
 /** Set to TRUE when the doublewrite buffer is being created */
 extern ibool		buf_dblwr_being_created;
+/** Parallel doublewrite buffers, one per buffer pool instance, or NULL
+if innodb_parallel_doublewrite is not set */
+extern buf_dblwr_t**	buf_dblwr_parallel;
 /** The size of the doublewrite header page when the reduced-doublewrite mode
 is used. */
 #define BUF_DBLWR_HEADER_SIZE 4096
+/** The size of the file of a parallel doublewrite buffer, in pages */
+#define BUF_DBLWR_PARALLEL_PAGES	(2 * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
 
 /****************************************************************//**
 Creates the doublewrite buffer to a new InnoDB installation. The header of the
@@ -111,6 +116,17 @@ void
 buf_dblwr_flush_buffered_writes(void);
 /*=================================*/
 /********************************************************************//**
+Flushes possible buffered writes of one buffer pool instance from the
+doublewrite memory buffer to disk. With innodb_parallel_doublewrite only
+the doublewrite buffer of the instance is written, so that batches of
+different instances do not wait for each other. Otherwise this is the
+same as buf_dblwr_flush_buffered_writes(). */
+UNIV_INTERN
+void
+buf_dblwr_flush_buffered_writes_instance(
+/*=====================================*/
+	ulint	buf_pool_index);	/*!< in: buffer pool instance */
+/********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
 for single page flushes. If all the buffers allocated for single page
@@ -124,6 +140,14 @@ buf_dblwr_write_single_page(
 /*========================*/
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
+/********************************************************************//**
+Prints the number of batches and the average write latency of each
+parallel doublewrite buffer. */
+UNIV_INTERN
+void
+buf_dblwr_print(
+/*============*/
+	FILE*	file);	/*!< in/out: buffer where to print */
 
 /** Doublewrite control struct */
 struct buf_dblwr_t{
@@ -162,6 +186,18 @@ struct buf_dblwr_t{
 				mode (innodb_doublewrite=2) */
 	byte*		header_unaligned;/*!< pointer to header,
 				but unaligned */
+	char*		path;	/*!< file of a parallel doublewrite
+				buffer, or NULL for the doublewrite
+				buffer in the system tablespace */
+	os_file_t	file;	/*!< handle to path */
+	ulint		mode;	/*!< innodb_doublewrite mode of the
+				batches in file, or 0 if the file has
+				not been reset since startup */
+	ulint		n_batches;/*!< number of batches written to
+				file */
+	ulint		n_pages;/*!< number of pages in those batches */
+	ib_uint64_t	write_us;/*!< total time spent writing and
+				syncing file, in microseconds */
 };
 
 
@@ -230,6 +230,38 @@ DECLARE_THREAD(buf_flush_lru_manager_thread)(
 /*=========================================*/
 	void*   arg);           /*!< in: a dummy parameter required by
 				os_thread_create */
+/******************************************************************//**
+page_cleaner worker thread, running the LRU and flush list batches that
+the page_cleaner and lru_manager threads request.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_page_cleaner_worker)(
+/*==========================================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
+/******************************************************************//**
+Creates the page cleaner coordination and starts srv_n_page_cleaners - 1
+page cleaner worker threads. Without workers the page_cleaner and
+lru_manager threads flush all the buffer pool instances themselves. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_init(void);
+/*=============================*/
+/******************************************************************//**
+Makes the page cleaner worker threads exit and waits for them. Batches
+requested afterwards are run by the requesting coordinator alone. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_workers_exit(void);
+/*=====================================*/
+/******************************************************************//**
+Frees the page cleaner coordination. The page cleaner threads must have
+exited. */
+UNIV_INTERN
+void
+buf_flush_page_cleaner_close(void);
+/*==============================*/
 /*********************************************************************//**
 Clears up tail of the LRU lists:
 * Put replaceable pages at the tail of LRU to the free list
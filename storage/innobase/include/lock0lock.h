@@ -942,8 +942,33 @@ struct lock_op_t{
 
 /** The lock system struct */
 struct lock_sys_t{
+	rw_lock_t	latch;			/*!< Latch on the whole lock
+						system. Operations that may
+						have to wait for a lock, or
+						that look at the locks of
+						several pages or tables, hold
+						it in exclusive mode together
+						with mutex. Requests that are
+						granted at once, and the
+						release of locks at commit,
+						hold it in shared mode
+						together with the mutex of
+						one shard. */
 	ib_mutex_t	mutex;			/*!< Mutex protecting the
-						locks */
+						locks, acquired after latch
+						in exclusive mode */
+	ib_mutex_t*	rec_shards;		/*!< Mutexes protecting the
+						record lock queues while
+						latch is held in shared mode:
+						cell i of rec_hash belongs to
+						shard i % n_rec_shards */
+	ulint		n_rec_shards;		/*!< number of rec_shards;
+						if 1, all the locks are
+						protected by latch in
+						exclusive mode */
+	ib_mutex_t	table_mutex;		/*!< Mutex protecting the
+						table lock queues while latch
+						is held in shared mode */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	ib_mutex_t	wait_mutex;		/*!< Mutex protecting the
@@ -976,22 +1001,39 @@ struct lock_sys_t{
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
-#define lock_mutex_enter_nowait() mutex_enter_nowait(&lock_sys->mutex)
+/** Test if lock_sys->latch and lock_sys->mutex can be acquired without
+waiting. Returns 0 if they were acquired. */
+#define lock_mutex_enter_nowait()				\
+	(rw_lock_x_lock_nowait(&lock_sys->latch)		\
+	 ? (mutex_enter(&lock_sys->mutex), 0) : 1)
 
-/** Test if lock_sys->mutex is owned. */
+/** Test if lock_sys->mutex is owned, that is, if the whole lock system
+is latched in exclusive mode. */
 #define lock_mutex_own() mutex_own(&lock_sys->mutex)
 
-/** Acquire the lock_sys->mutex. */
+/** Acquire the lock_sys->latch in exclusive mode and the lock_sys->mutex. */
 #define lock_mutex_enter() do {			\
+	rw_lock_x_lock(&lock_sys->latch);	\
 	mutex_enter(&lock_sys->mutex);		\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release the lock_sys->mutex and the lock_sys->latch. */
 #define lock_mutex_exit() do {			\
 	mutex_exit(&lock_sys->mutex);		\
+	rw_lock_x_unlock(&lock_sys->latch);	\
 } while (0)
 
+#ifdef UNIV_DEBUG
+/*********************************************************************//**
+Test if the current thread holds lock_sys->mutex or the mutex of a
+shard of the lock system.
+@return TRUE if the lock system is latched by the current thread */
+UNIV_INTERN
+ibool
+lock_latched(void);
+/*==============*/
+#endif /* UNIV_DEBUG */
+
 /** Test if lock_sys->wait_mutex is owned. */
 #define lock_wait_mutex_own() mutex_own(&lock_sys->wait_mutex)
 
@@ -51,6 +51,9 @@ typedef	ib_uint64_t		lsn_t;
 struct log_t;
 /** Redo log group */
 struct log_group_t;
+/** Reservation of a log sequence number range by a mini-transaction
+in the concurrent write mode */
+struct log_handle_t;
 
 #ifdef UNIV_DEBUG
 /** Flag: write to log file? */
@@ -146,6 +149,100 @@ UNIV_INLINE
 lsn_t
 log_get_lsn(void);
 /*=============*/
+/************************************************************//**
+Gets the current lsn without acquiring the log mutex. Unless the log is
+in the concurrent write mode, the value may be stale if the caller does
+not hold the log mutex.
+@return	current lsn */
+UNIV_INLINE
+lsn_t
+log_get_lsn_low(void);
+/*=================*/
+/************************************************************//**
+Converts a count of log data bytes to the lsn at which they end.
+@return	lsn */
+UNIV_INLINE
+lsn_t
+log_sn_to_lsn(
+/*==========*/
+	lsn_t	sn);	/*!< in: log data bytes since lsn 0 */
+/************************************************************//**
+Converts an lsn to the count of log data bytes before it. The lsn
+must point into the data area of a log block.
+@return	log data bytes since lsn 0 */
+UNIV_INLINE
+lsn_t
+log_lsn_to_sn(
+/*==========*/
+	lsn_t	lsn);	/*!< in: lsn */
+#ifndef UNIV_HOTBACKUP
+/************************************************************//**
+Reserves an lsn range for a mini-transaction log in the concurrent
+write mode. This does not acquire the log mutex: the range is claimed
+with an atomic increment, and the log must then be copied with
+log_concurrent_write and the range closed with log_concurrent_close. */
+UNIV_INTERN
+void
+log_concurrent_reserve(
+/*===================*/
+	ulint		len,	/*!< in: length of the log */
+	log_handle_t*	handle);/*!< out: reserved range */
+/************************************************************//**
+Copies a part of a mini-transaction log to the log buffer in the
+concurrent write mode. */
+UNIV_INTERN
+void
+log_concurrent_write(
+/*=================*/
+	log_handle_t*	handle,	/*!< in/out: reserved range */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len);/*!< in: string length */
+/************************************************************//**
+Closes an lsn range in the concurrent write mode, after the whole log
+of the mini-transaction has been copied to the log buffer. */
+UNIV_INTERN
+void
+log_concurrent_close(
+/*=================*/
+	log_handle_t*	handle);/*!< in/out: reserved range */
+/******************************************************//**
+Switches the log to the concurrent write mode and starts the log writer
+and log flusher threads. Must be called at startup, after recovery and
+before any other thread can generate redo log. */
+UNIV_INTERN
+void
+log_concurrent_writes_enable(void);
+/*==============================*/
+/******************************************************//**
+Makes the log writer and log flusher threads exit. Must be called at
+shutdown after srv_shutdown_state has been set to
+SRV_SHUTDOWN_LAST_PHASE. */
+UNIV_INTERN
+void
+log_concurrent_threads_exit(void);
+/*=============================*/
+/******************************************************************//**
+The log writer thread writes the log buffer to the log files as
+mini-transactions complete their copies to it in the concurrent write
+mode.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg);	/*!< in: a dummy parameter required by
+			os_thread_create */
+/******************************************************************//**
+The log flusher thread flushes the log files to disk in the concurrent
+write mode, when some thread waits for it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg);	/*!< in: a dummy parameter required by
+			os_thread_create */
+#endif /* !UNIV_HOTBACKUP */
 /****************************************************************
 Gets the log group capacity. It is OK to read the value without
 holding log_sys->mutex because it is constant.
@@ -604,6 +701,15 @@ extern log_t*	log_sys;
 #define LOG_START_LSN		((lsn_t) (16 * OS_FILE_LOG_BLOCK_SIZE))
 
 #define LOG_BUFFER_SIZE		(srv_log_buffer_size * UNIV_PAGE_SIZE)
+
+/** Number of slots in log_sys->recent_written: this bounds how far the
+mini-transactions copying to the log buffer in the concurrent write mode
+may run ahead of the oldest one that has not completed its copy */
+#define LOG_RECENT_WRITTEN_SIZE	(1024 * 1024)
+/** Number of events on which threads wait for the log to be written
+or flushed up to an lsn in the concurrent write mode; a waiter for lsn
+uses the event (lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_N_WAIT_EVENTS */
+#define LOG_N_WAIT_EVENTS	64
 #define LOG_ARCHIVE_BUF_SIZE	(srv_log_buffer_size * UNIV_PAGE_SIZE / 4)
 
 /* Offsets of a log block header */
@@ -790,6 +896,18 @@ struct log_group_t{
 			log_groups;	/*!< list of log groups */
 };
 
+/** Reservation of a log sequence number range by a mini-transaction
+in the concurrent write mode */
+struct log_handle_t{
+	lsn_t		start_lsn;	/*!< start of the reserved range */
+	lsn_t		end_lsn;	/*!< end of the reserved range */
+	lsn_t		lsn;		/*!< the log has been copied to the
+					log buffer up to this lsn */
+	lsn_t		completed_lsn;	/*!< the copy has been reported to
+					log_sys->recent_written up to this
+					lsn */
+};
+
 /** Redo log buffer */
 struct log_t{
 	byte		pad[64];	/*!< padding to prevent other memory
@@ -836,6 +954,54 @@ struct log_t{
 	UT_LIST_BASE_NODE_T(log_group_t)
 			log_groups;	/*!< log groups */
 
+#ifndef UNIV_HOTBACKUP
+	/** Fields of the concurrent write mode @{ */
+	bool		concurrent_writes;
+					/*!< true if mini-transactions reserve
+					lsn ranges with an atomic increment of
+					sn and copy to the log buffer without
+					the log mutex; the log buffer is then
+					a ring in which the block holding lsn
+					is at offset lsn % buf_size, lsn is
+					the end of the completely copied part
+					of it and is advanced only by the log
+					writer, under write_mutex */
+	byte		pad2[64];	/*!< padding */
+	volatile lsn_t	sn;		/*!< number of log data bytes
+					reserved, see log_sn_to_lsn() */
+	byte		pad3[64];	/*!< padding */
+	lsn_t*		recent_written;	/*!< LOG_RECENT_WRITTEN_SIZE slots;
+					when the copy of the range [start,
+					end) has completed, end is stored in
+					slot start % LOG_RECENT_WRITTEN_SIZE;
+					0 if the slot is free */
+	ib_mutex_t	write_mutex;	/*!< serializes the writes of the log
+					buffer to the log files in the
+					concurrent write mode; protects lsn,
+					write_buf, and the log group write
+					positions */
+	byte*		write_buf_ptr;	/*!< unaligned write_buf */
+	byte*		write_buf;	/*!< the log blocks are copied here
+					from the ring before they are written,
+					because the last one may still be
+					filled concurrently */
+	os_event_t	writer_event;	/*!< set to wake up the log writer */
+	os_event_t	flusher_event;	/*!< set to wake up the log flusher */
+	os_event_t*	write_events;	/*!< LOG_N_WAIT_EVENTS events, set
+					when write_lsn advances */
+	os_event_t*	flush_events;	/*!< LOG_N_WAIT_EVENTS events, set
+					when flushed_to_disk_lsn advances */
+	ulint		n_flush_waiters;/*!< number of threads waiting for
+					the log flusher */
+	volatile bool	writer_thread_active;
+					/*!< true if the log writer thread
+					is running */
+	volatile bool	flusher_thread_active;
+					/*!< true if the log flusher thread
+					is running */
+	/* @} */
+#endif /* !UNIV_HOTBACKUP */
+
 #ifndef UNIV_HOTBACKUP
 	/** The fields involved in the log buffer flush @{ */
 
@@ -1009,6 +1175,9 @@ struct log_t{
 #endif /* UNIV_LOG_ARCHIVE */
 };
 
+/** Test if the log write mutex is owned. */
+#define log_write_mutex_own()	mutex_own(&log_sys->write_mutex)
+
 /** Test if flush order mutex is owned. */
 #define log_flush_order_mutex_own()	\
 	mutex_own(&log_sys->log_flush_order_mutex)
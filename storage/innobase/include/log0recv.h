@@ -467,6 +467,17 @@ struct recv_sys_t{
 	hash_table_t*	addr_hash;/*!< hash table of file addresses of pages */
 	ulint		n_addrs;/*!< number of not processed hashed file
 				addresses in the hash table */
+#ifndef UNIV_HOTBACKUP
+	ulint		n_apply_threads;
+				/*!< number of recv_apply_thread instances
+				started for the current apply batch */
+	ulint		n_apply_threads_active;
+				/*!< number of those that have not yet
+				finished their part of the batch */
+	os_event_t	apply_event;
+				/*!< set when n_addrs drops to zero or
+				a recv_apply_thread finishes */
+#endif /* !UNIV_HOTBACKUP */
 
 	recv_dblwr_t	dblwr;
 };
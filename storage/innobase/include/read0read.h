@@ -47,6 +47,36 @@ read_view_open_now(
 	mem_heap_t*	heap);		/*!< in: memory heap from which
 					allocated */
 /*********************************************************************//**
+Opens a read view for a non-locking autocommit read-only transaction. The
+view cached by the previous such transaction of the same trx object is
+reopened without acquiring trx_sys->mutex if it is still an exact snapshot
+of the current state; otherwise a new view is created.
+@return	own: read view struct */
+UNIV_INTERN
+read_view_t*
+read_view_open_for_autocommit(
+/*==========================*/
+	trx_t*		trx);	/*!< in/out: non-locking autocommit
+				read-only transaction */
+/*********************************************************************//**
+Closes the read view of a non-locking autocommit read-only transaction at
+commit. A view that can be reopened is left on trx_sys->view_list marked
+as VIEW_CLOSED and cached in trx->cached_read_view; other views are
+removed from the list. */
+UNIV_INTERN
+void
+read_view_close_for_autocommit(
+/*===========================*/
+	trx_t*		trx);	/*!< in/out: non-locking autocommit
+				read-only transaction */
+/*********************************************************************//**
+Frees the read view cached in trx->cached_read_view, if any. */
+UNIV_INTERN
+void
+read_view_free_cached(
+/*==================*/
+	trx_t*		trx);	/*!< in/out: transaction */
+/*********************************************************************//**
 Makes a copy of the oldest existing read view, or opens a new. The view
 must be closed with ..._close.
 @return	own: read view struct */
@@ -155,7 +185,14 @@ struct read_view_t{
 				that is, up_limit_id and low_limit_id. */
 	trx_id_t	creator_trx_id;
 				/*!< trx id of creating transaction, or
-				0 used in purge */
+				0 used in purge, or TRX_ID_MAX if created
+				by a non-locking autocommit read-only
+				transaction */
+	ulint		state;	/*!< VIEW_OPEN, VIEW_CLOSED or
+				VIEW_DETACHED; changes from VIEW_CLOSED
+				are made with an atomic compare and swap
+				because the creating transaction reopens
+				its view without trx_sys->mutex */
 	UT_LIST_NODE_T(read_view_t) view_list;
 				/*!< List of read views in trx_sys */
 };
@@ -172,6 +209,19 @@ struct read_view_t{
 					read view was created. */
 /* @} */
 
+/** Read view states @{ */
+#define VIEW_OPEN		0	/*!< The view is in use */
+#define VIEW_CLOSED		1	/*!< The view was closed by a
+					non-locking autocommit read-only
+					transaction but is still on
+					trx_sys->view_list, so that the next
+					such transaction of the same trx
+					object can reopen it */
+#define VIEW_DETACHED		2	/*!< A closed view that purge has
+					removed from trx_sys->view_list; it
+					cannot be reopened */
+/* @} */
+
 /** Implement InnoDB framework to support consistent read views in
 cursors. This struct holds both heap where consistent read view
 is allocated and pointer to a read view. */
@@ -335,6 +335,7 @@ extern ulong	srv_n_log_files;
 extern ib_uint64_t	srv_log_file_size;
 extern ib_uint64_t	srv_log_file_size_requested;
 extern ulint	srv_log_buffer_size;
+extern my_bool	srv_log_writer_threads;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
 extern char	srv_adaptive_flushing;
@@ -360,8 +361,12 @@ extern my_bool	srv_buf_pool_populate;	/*!< virtual page preallocation */
 extern ulint    srv_buf_pool_instances; /*!< requested number of buffer pool instances */
 extern ulong	srv_n_page_hash_locks;	/*!< number of locks to
 					protect buf_pool->page_hash */
+extern my_bool	srv_page_hash_optimistic_lookup;/*!< look up resident
+					pages without the page_hash locks */
 extern ulong	srv_LRU_scan_depth;	/*!< Scan depth for LRU
 					flush batch */
+extern ulong	srv_n_page_cleaners;	/*!< number of threads running
+					the LRU and flush list batches */
 extern ulong	srv_flush_neighbors;	/*!< whether or not to flush
 					neighbors of a block */
 extern ulint	srv_buf_pool_old_size;	/*!< previously requested size */
@@ -438,6 +443,7 @@ extern double	srv_adaptive_flushing_lwm;
 extern ulong	srv_flushing_avg_loops;
 
 extern ulong	srv_force_recovery;
+extern ulong	srv_n_recv_apply_threads;
 #ifndef DBUG_OFF
 extern ulong	srv_force_recovery_crash;
 #endif /* !DBUG_OFF */
@@ -464,6 +470,7 @@ extern my_bool srv_recv_ibuf_operations;
 extern ulong	srv_use_doublewrite_buf;
 extern my_bool	srv_doublewrite_reset;
 extern ulong	srv_doublewrite_batch_size;
+extern my_bool	srv_parallel_doublewrite;
 
 extern double	srv_max_buf_pool_modified_pct;
 extern ulong	srv_max_purge_lag;
@@ -643,6 +650,9 @@ extern atomic_stat<ulint>	srv_sec_rec_cluster_reads_avoided;
 /** Perform deadlock detection check. */
 extern my_bool srv_deadlock_detect;
 
+/** Number of shards of the record lock hash table of lock_sys */
+extern ulong	srv_lock_sys_shards;
+
 /* The maximum time limit for a single LRU tail flush iteration by the lru manager thread */
 extern ulint	srv_cleaner_max_lru_time;
 
@@ -659,6 +669,7 @@ extern srv_stats_t	srv_stats;
 /* Keys to register InnoDB threads with performance schema */
 extern mysql_pfs_key_t	buf_page_cleaner_thread_key;
 extern mysql_pfs_key_t  buf_lru_manager_thread_key;
+extern mysql_pfs_key_t	buf_page_cleaner_worker_thread_key;
 extern mysql_pfs_key_t	trx_rollback_clean_thread_key;
 extern mysql_pfs_key_t	io_handler_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
@@ -667,6 +678,9 @@ extern mysql_pfs_key_t	srv_monitor_thread_key;
 extern mysql_pfs_key_t	srv_master_thread_key;
 extern mysql_pfs_key_t	srv_purge_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
+extern mysql_pfs_key_t	log_writer_thread_key;
+extern mysql_pfs_key_t	log_flusher_thread_key;
 
 /* This macro register the current thread and its key with performance
 schema */
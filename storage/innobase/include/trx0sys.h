@@ -655,6 +655,22 @@ struct trx_sys_t{
 					mysql_trx_list may additionally contain
 					transactions that have not yet been
 					started in InnoDB. */
+	trx_id_t*	descriptors;	/*!< Array of trx ids of the
+					transactions on rw_trx_list that are
+					not yet committed in memory, sorted in
+					ascending order. Read views are created
+					by copying this array instead of
+					traversing rw_trx_list. */
+	ulint		descr_n_max;	/*!< Capacity of the descriptors
+					array */
+	ulint		descr_n_used;	/*!< Number of used elements in the
+					descriptors array */
+	trx_list_t	serialisation_list;
+					/*!< Transactions that have been
+					assigned a serialisation number
+					(trx_t::no) but are not yet committed
+					in memory, sorted on trx_t::no,
+					smallest first */
 	trx_rseg_t*	const rseg_array[TRX_SYS_N_RSEGS];
 					/*!< Pointer array to rollback
 					segments; NULL if slot not in use;
@@ -675,6 +691,9 @@ struct trx_sys_t{
 two) is assigned, the field TRX_SYS_TRX_ID_STORE on the transaction system
 page is updated */
 #define TRX_SYS_TRX_ID_WRITE_MARGIN	256
+
+/** Initial capacity of trx_sys_t::descriptors */
+#define TRX_DESCR_ARRAY_INITIAL_SIZE	1000
 #endif /* !UNIV_HOTBACKUP */
 
 #ifndef UNIV_NONINL
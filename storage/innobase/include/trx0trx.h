@@ -283,6 +283,23 @@ void
 trx_mark_sql_stat_end(
 /*==================*/
 	trx_t*	trx);	/*!< in: trx handle */
+/****************************************************************//**
+Adds the id of a read-write transaction to trx_sys->descriptors. The caller
+must own trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_reserve_descriptor(
+/*===================*/
+	const trx_t*	trx);	/*!< in: transaction */
+/****************************************************************//**
+Removes the id of a read-write transaction from trx_sys->descriptors and
+the transaction from trx_sys->serialisation_list. The caller must own
+trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_release_descriptor(
+/*===================*/
+	trx_t*	trx);	/*!< in/out: transaction */
 /********************************************************************//**
 Assigns a read view for a consistent read query. All the consistent reads
 within the same transaction will get the same read view, which is created
@@ -936,6 +953,9 @@ struct trx_t{
 	ulint		has_search_latch;
 					/*!< TRUE if this trx has latched the
 					search system latch in S-mode */
+	rw_lock_t*	search_latch;	/*!< the adaptive hash index partition
+					latch this trx holds in S-mode when
+					has_search_latch is TRUE, else NULL */
 	ulint		search_latch_timeout;
 					/*!< If we notice that someone is
 					waiting for our S-lock on the search
@@ -1034,6 +1054,13 @@ struct trx_t{
 	ibool		in_rw_trx_list;	/*!< TRUE if in trx_sys->rw_trx_list */
 	/* @} */
 #endif /* UNIV_DEBUG */
+	UT_LIST_NODE_T(trx_t)
+			no_list;	/*!< list node for
+					trx_sys->serialisation_list;
+					protected by trx_sys->mutex */
+	ibool		in_serialisation_list;
+					/*!< TRUE if in
+					trx_sys->serialisation_list */
 	UT_LIST_NODE_T(trx_t)
 			mysql_trx_list;	/*!< list of transactions created for
 					MySQL; protected by trx_sys->mutex */
@@ -1073,6 +1100,14 @@ struct trx_t{
 					associated to a transaction (i.e.
 					same as global_read_view) or read view
 					associated to a cursor */
+	read_view_t*	cached_read_view;
+					/*!< read view of the previous
+					non-locking autocommit read-only
+					transaction run by this trx object,
+					kept on trx_sys->view_list for reuse by
+					read_view_open_for_autocommit(), or
+					NULL; allocated from
+					global_read_view_heap */
 	/*------------------------------*/
 	UT_LIST_BASE_NODE_T(trx_named_savept_t)
 			trx_savepoints;	/*!< savepoints set with SAVEPOINT ...,
@@ -1245,24 +1280,6 @@ struct commit_node_t{
 	mutex_exit(&t->mutex);			\
 } while (0)
 
-/** @brief The latch protecting the adaptive search system
-
-This latch protects the
-(1) hash index;
-(2) columns of a record to which we have a pointer in the hash index;
-
-but does NOT protect:
-
-(3) next record offset field in a record;
-(4) next or previous records on the same page.
-
-Bear in mind (3) and (4) when using the hash index.
-*/
-extern rw_lock_t*	btr_search_latch_temp;
-
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
-
 #ifndef UNIV_NONINL
 #include "trx0trx.ic"
 #endif
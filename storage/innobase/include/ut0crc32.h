@@ -48,4 +48,6 @@ extern ib_ut_crc32_t	ut_crc32;
 
 extern bool	ut_crc32_sse2_enabled;
 
+extern bool	ut_crc32_pclmul_enabled;
+
 #endif /* ut0crc32_h */
@@ -391,8 +391,17 @@ static const ulint	lock_types = UT_ARR_SIZE(lock_compatibility_matrix);
 UNIV_INTERN mysql_pfs_key_t	lock_sys_mutex_key;
 /* Key to register mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	lock_sys_wait_mutex_key;
+/* Key to register mutex with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_shard_mutex_key;
+/* Key to register mutex with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_table_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
+#ifdef UNIV_PFS_RWLOCK
+/* Key to register rwlock with performance schema */
+UNIV_INTERN mysql_pfs_key_t	lock_sys_latch_key;
+#endif /* UNIV_PFS_RWLOCK */
+
 #ifdef UNIV_DEBUG
 UNIV_INTERN ibool	lock_print_waits	= FALSE;
 
@@ -611,8 +620,31 @@ lock_sys_create(
 
 	lock_sys->last_slot = lock_sys->waiting_threads;
 
+	rw_lock_create(lock_sys_latch_key, &lock_sys->latch,
+		       SYNC_LOCK_SYS_LATCH);
+
 	mutex_create(lock_sys_mutex_key, &lock_sys->mutex, SYNC_LOCK_SYS);
 
+	/* The shard mutexes are never held together with lock_sys->mutex
+	or with each other, so they can share its latching order level. */
+	lock_sys->n_rec_shards = srv_lock_sys_shards;
+#ifndef HAVE_ATOMIC_BUILTINS
+	/* The record lock counters are updated under different shards
+	with atomic operations. */
+	lock_sys->n_rec_shards = 1;
+#endif /* !HAVE_ATOMIC_BUILTINS */
+
+	lock_sys->rec_shards = static_cast<ib_mutex_t*>(
+		mem_zalloc(lock_sys->n_rec_shards * sizeof(ib_mutex_t)));
+
+	for (ulint i = 0; i < lock_sys->n_rec_shards; i++) {
+		mutex_create(lock_sys_shard_mutex_key,
+			     &lock_sys->rec_shards[i], SYNC_LOCK_SYS);
+	}
+
+	mutex_create(lock_sys_table_mutex_key,
+		     &lock_sys->table_mutex, SYNC_LOCK_SYS);
+
 	mutex_create(lock_sys_wait_mutex_key,
 		     &lock_sys->wait_mutex, SYNC_LOCK_WAIT_SYS);
 
@@ -667,8 +699,16 @@ lock_sys_close(void)
 
 	hash_table_free(lock_sys->rec_hash);
 
+	for (ulint i = 0; i < lock_sys->n_rec_shards; i++) {
+		mutex_free(&lock_sys->rec_shards[i]);
+	}
+
+	mem_free(lock_sys->rec_shards);
+
+	mutex_free(&lock_sys->table_mutex);
 	mutex_free(&lock_sys->mutex);
 	mutex_free(&lock_sys->wait_mutex);
+	rw_lock_free(&lock_sys->latch);
 
 	mem_free(lock_stack);
 	mem_free(lock_sys);
@@ -677,6 +717,149 @@ lock_sys_close(void)
 	lock_stack = NULL;
 }
 
+/*********************************************************************//**
+Gets the shard mutex of the record lock queue of a page. The caller must
+hold lock_sys->latch, so that lock_sys->rec_hash cannot be resized.
+@return	shard mutex */
+UNIV_INLINE
+ib_mutex_t*
+lock_rec_get_shard(
+/*===============*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(&lock_sys->rec_shards[lock_rec_hash(space, page_no)
+				     % lock_sys->n_rec_shards]);
+}
+
+/*********************************************************************//**
+Latches the record lock queue of a page for a request that can be granted
+or refused without waiting: acquires lock_sys->latch in shared mode and
+the mutex of the shard of the page. If the lock system is not sharded,
+acquires lock_sys->mutex instead.
+@return	shard mutex to pass to lock_shard_exit(), or NULL if
+lock_sys->mutex was acquired */
+static
+ib_mutex_t*
+lock_rec_shard_enter(
+/*=================*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	ib_mutex_t*	shard;
+
+	if (lock_sys->n_rec_shards == 1) {
+		lock_mutex_enter();
+
+		return(NULL);
+	}
+
+	rw_lock_s_lock(&lock_sys->latch);
+
+	shard = lock_rec_get_shard(space, page_no);
+
+	mutex_enter(shard);
+
+	return(shard);
+}
+
+/*********************************************************************//**
+Latches the table lock queues for a request that can be granted without
+waiting: acquires lock_sys->latch in shared mode and
+lock_sys->table_mutex. If the lock system is not sharded, acquires
+lock_sys->mutex instead.
+@return	lock_sys->table_mutex to pass to lock_shard_exit(), or NULL if
+lock_sys->mutex was acquired */
+static
+ib_mutex_t*
+lock_table_shard_enter(void)
+/*========================*/
+{
+	if (lock_sys->n_rec_shards == 1) {
+		lock_mutex_enter();
+
+		return(NULL);
+	}
+
+	rw_lock_s_lock(&lock_sys->latch);
+
+	mutex_enter(&lock_sys->table_mutex);
+
+	return(&lock_sys->table_mutex);
+}
+
+/*********************************************************************//**
+Releases the latches acquired by lock_rec_shard_enter() or
+lock_table_shard_enter(). */
+static
+void
+lock_shard_exit(
+/*============*/
+	ib_mutex_t*	shard)	/*!< in: shard mutex, or NULL if
+				lock_sys->mutex is held */
+{
+	if (shard == NULL) {
+		lock_mutex_exit();
+	} else {
+		mutex_exit(shard);
+		rw_lock_s_unlock(&lock_sys->latch);
+	}
+}
+
+/*********************************************************************//**
+Switches from the shard latched by lock_rec_shard_enter() or
+lock_table_shard_enter() to lock_sys->mutex, when the request has to
+wait: the wait is enqueued and checked for deadlocks under
+lock_sys->mutex. The lock queues may change in between, so the caller
+must check its request again. */
+static
+void
+lock_shard_to_mutex(
+/*================*/
+	ib_mutex_t**	shard)	/*!< in/out: shard mutex, set to NULL */
+{
+	ut_ad(*shard != NULL);
+
+	lock_shard_exit(*shard);
+
+	lock_mutex_enter();
+
+	*shard = NULL;
+}
+
+#ifdef UNIV_DEBUG
+/*********************************************************************//**
+Test if the current thread holds lock_sys->mutex or the mutex of a
+shard of the lock system.
+@return TRUE if the lock system is latched by the current thread */
+UNIV_INTERN
+ibool
+lock_latched(void)
+/*==============*/
+{
+	if (lock_mutex_own() || mutex_own(&lock_sys->table_mutex)) {
+		return(TRUE);
+	}
+
+	for (ulint i = 0; i < lock_sys->n_rec_shards; i++) {
+		if (mutex_own(&lock_sys->rec_shards[i])) {
+			return(TRUE);
+		}
+	}
+
+	return(FALSE);
+}
+
+/** Test if the record lock queue of a page is latched by the current
+thread */
+# define lock_rec_latched(space, page_no)				\
+	(lock_mutex_own() || mutex_own(lock_rec_get_shard(space, page_no)))
+
+/** Test if the table lock queues are latched by the current thread */
+# define lock_table_latched()						\
+	(lock_mutex_own() || mutex_own(&lock_sys->table_mutex))
+#endif /* UNIV_DEBUG */
+
 /*********************************************************************//**
 Gets the size of a lock struct.
 @return	size in bytes */
@@ -887,7 +1070,7 @@ lock_reset_lock_and_trx_wait(
 {
 	ut_ad(lock->trx->lock.wait_lock == lock);
 	ut_ad(lock_get_wait(lock));
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	lock->trx->lock.wait_lock = NULL;
 	lock->type_mode &= ~LOCK_WAIT;
@@ -1184,7 +1367,7 @@ lock_rec_get_next_on_page_const(
 	ulint	space;
 	ulint	page_no;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 	ut_ad(lock_get_type_low(lock) == LOCK_REC);
 
 	space = lock->un_member.rec_lock.space;
@@ -1233,7 +1416,7 @@ lock_rec_get_first_on_page_addr(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	for (lock = static_cast<lock_t*>(
 			HASH_GET_FIRST(lock_sys->rec_hash,
@@ -1285,7 +1468,7 @@ lock_rec_get_first_on_page(
 	ulint	space	= buf_block_get_space(block);
 	ulint	page_no	= buf_block_get_page_no(block);
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	hash = buf_block_get_lock_hash_val(block);
 
@@ -1314,7 +1497,7 @@ lock_rec_get_next(
 	ulint	heap_no,/*!< in: heap number of the record */
 	lock_t*	lock)	/*!< in: lock */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	do {
 		ut_ad(lock_get_type_low(lock) == LOCK_REC);
@@ -1349,7 +1532,7 @@ lock_rec_get_first(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	for (lock = lock_rec_get_first_on_page(block); lock;
 	     lock = lock_rec_get_next_on_page(lock)) {
@@ -1516,7 +1699,7 @@ lock_rec_has_expl(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 	ut_ad((precise_mode & LOCK_MODE_MASK) == LOCK_S
 	      || (precise_mode & LOCK_MODE_MASK) == LOCK_X);
 	ut_ad(!(precise_mode & LOCK_INSERT_INTENTION));
@@ -1570,7 +1753,7 @@ lock_rec_other_has_expl_req(
 {
 	const lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 	ut_ad(mode == LOCK_X || mode == LOCK_S);
 	ut_ad(gap == 0 || gap == LOCK_GAP);
 	ut_ad(wait == 0 || wait == LOCK_WAIT);
@@ -1614,7 +1797,7 @@ lock_rec_other_has_conflicting(
 	const lock_t*		lock;
 	ibool			is_supremum;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	is_supremum = (heap_no == PAGE_HEAP_NO_SUPREMUM);
 
@@ -1644,7 +1827,7 @@ lock_rec_find_similar_on_page(
 	lock_t*		lock,		/*!< in: lock_rec_get_first_on_page() */
 	const trx_t*	trx)		/*!< in: transaction */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	for (/* No op */;
 	     lock != NULL;
@@ -1858,7 +2041,8 @@ lock_rec_create(
 	ulint		n_bytes;
 	const page_t*	page;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_latched(buf_block_get_space(block),
+			       buf_block_get_page_no(block)));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1906,7 +2090,13 @@ lock_rec_create(
 	/* Set the bit corresponding to rec */
 	lock_rec_set_nth_bit(lock, heap_no);
 
+	/* Record locks on different pages of the table may be created
+	concurrently under different shards. */
+#ifdef HAVE_ATOMIC_BUILTINS
+	os_atomic_increment_ulint(&index->table->n_rec_locks, 1);
+#else
 	index->table->n_rec_locks++;
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 	ut_ad(index->table->n_ref_count > 0 || !index->table->can_be_evicted);
 
@@ -1935,8 +2125,8 @@ lock_rec_create(
 		trx_mutex_exit(trx);
 	}
 
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return(lock);
 }
@@ -2092,7 +2282,8 @@ lock_rec_add_to_queue(
 	lock_t*	lock;
 	lock_t*	first_lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_latched(buf_block_get_space(block),
+			       buf_block_get_page_no(block)));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index)
 	      || dict_index_get_online_status(index) != ONLINE_INDEX_CREATION);
@@ -2207,7 +2398,8 @@ lock_rec_lock_fast(
 	trx_t*			trx;
 	enum lock_rec_req_status status = LOCK_REC_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_latched(buf_block_get_space(block),
+			       buf_block_get_page_no(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2289,7 +2481,8 @@ lock_rec_lock_slow(
 	trx_t*			trx;
 	dberr_t			err = DB_SUCCESS;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_latched(buf_block_get_space(block),
+			       buf_block_get_page_no(block)));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2348,7 +2541,9 @@ Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
 which does NOT look at implicit locks! Checks lock compatibility within
 explicit locks. This function sets a normal next-key lock, or in the case
-of a page supremum record, a gap type lock.
+of a page supremum record, a gap type lock. Latches the record lock queue
+of the page: a request that does not have to wait is handled under the
+shard of the page only.
 @return	DB_SUCCESS, DB_SUCCESS_LOCKED_REC, DB_LOCK_WAIT, DB_DEADLOCK,
 or DB_QUE_THR_SUSPENDED */
 static
@@ -2372,7 +2567,10 @@ lock_rec_lock(
 	dict_index_t*		index,	/*!< in: index of record */
 	que_thr_t*		thr)	/*!< in: query thread */
 {
-	ut_ad(lock_mutex_own());
+	ib_mutex_t*	shard;
+	dberr_t		err = DB_ERROR;
+
+	ut_ad(!lock_mutex_own());
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_X
@@ -2384,20 +2582,44 @@ lock_rec_lock(
 	      || mode - (LOCK_MODE_MASK & mode) == 0);
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
+	shard = lock_rec_shard_enter(buf_block_get_space(block),
+				     buf_block_get_page_no(block));
+
 	/* We try a simplified and faster subroutine for the most
 	common cases */
 	switch (lock_rec_lock_fast(impl, mode, block, heap_no, index, thr)) {
 	case LOCK_REC_SUCCESS:
-		return(DB_SUCCESS);
+		err = DB_SUCCESS;
+		break;
 	case LOCK_REC_SUCCESS_CREATED:
-		return(DB_SUCCESS_LOCKED_REC);
+		err = DB_SUCCESS_LOCKED_REC;
+		break;
 	case LOCK_REC_FAIL:
-		return(lock_rec_lock_slow(impl, mode, x_mode, block,
-					  heap_no, index, thr));
+		if (shard != NULL
+		    && x_mode == LOCK_X_REGULAR
+		    && !lock_rec_has_expl(mode, block, heap_no,
+					  thr_get_trx(thr))
+		    && lock_rec_other_has_conflicting(
+			    static_cast<enum lock_mode>(mode),
+			    block, heap_no, thr_get_trx(thr))) {
+
+			/* The request has to wait: it is enqueued and
+			checked for deadlocks under lock_sys->mutex. */
+			lock_shard_to_mutex(&shard);
+		}
+
+		err = lock_rec_lock_slow(impl, mode, x_mode, block,
+					 heap_no, index, thr);
+		break;
+	default:
+		ut_error;
 	}
 
-	ut_error;
-	return(DB_ERROR);
+	lock_shard_exit(shard);
+
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+
+	return(err);
 }
 
 /*********************************************************************//**
@@ -2416,7 +2638,7 @@ lock_rec_has_to_wait_in_queue(
 	ulint		bit_mask;
 	ulint		bit_offset;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 	ut_ad(lock_get_wait(wait_lock));
 	ut_ad(lock_get_type_low(wait_lock) == LOCK_REC);
 
@@ -2453,7 +2675,7 @@ lock_grant(
 /*=======*/
 	lock_t*	lock)	/*!< in/out: waiting lock request */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 
 	lock_reset_lock_and_trx_wait(lock);
 
@@ -2553,7 +2775,7 @@ lock_rec_dequeue_from_page(
 	lock_t*		lock;
 	trx_lock_t*	trx_lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 	ut_ad(lock_get_type_low(in_lock) == LOCK_REC);
 	/* We may or may not be holding in_lock->trx->mutex here. */
 
@@ -2562,15 +2784,19 @@ lock_rec_dequeue_from_page(
 	space = in_lock->un_member.rec_lock.space;
 	page_no = in_lock->un_member.rec_lock.page_no;
 
+#ifdef HAVE_ATOMIC_BUILTINS
+	os_atomic_decrement_ulint(&in_lock->index->table->n_rec_locks, 1);
+#else
 	in_lock->index->table->n_rec_locks--;
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 	HASH_DELETE(lock_t, hash, lock_sys->rec_hash,
 		    lock_rec_fold(space, page_no), in_lock);
 
 	UT_LIST_REMOVE(trx_locks, trx_lock->trx_locks, in_lock);
 
-	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_REMOVED);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
 
 	/* Check if waiting locks in the queue can now be granted: grant
 	locks if there are no conflicting locks ahead. Stop at the first
@@ -2612,15 +2838,19 @@ lock_rec_discard(
 	space = in_lock->un_member.rec_lock.space;
 	page_no = in_lock->un_member.rec_lock.page_no;
 
+#ifdef HAVE_ATOMIC_BUILTINS
+	os_atomic_decrement_ulint(&in_lock->index->table->n_rec_locks, 1);
+#else
 	in_lock->index->table->n_rec_locks--;
+#endif /* HAVE_ATOMIC_BUILTINS */
 
 	HASH_DELETE(lock_t, hash, lock_sys->rec_hash,
 		    lock_rec_fold(space, page_no), in_lock);
 
 	UT_LIST_REMOVE(trx_locks, trx_lock->trx_locks, in_lock);
 
-	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_REMOVED);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
 }
 
 /*************************************************************//**
@@ -4182,7 +4412,7 @@ lock_table_create(
 	lock_t*	lock;
 
 	ut_ad(table && trx);
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 	ut_ad(trx_mutex_own(trx));
 
 	/* Non-locking autocommit read-only transactions should not set
@@ -4244,7 +4474,7 @@ lock_table_pop_autoinc_locks(
 /*=========================*/
 	trx_t*	trx)	/*!< in/out: transaction that owns the AUTOINC locks */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 	ut_ad(!ib_vector_is_empty(trx->autoinc_locks));
 
 	/* Skip any gaps, gaps are NULL lock entries in the
@@ -4272,7 +4502,7 @@ lock_table_remove_autoinc_lock(
 	lock_t*	autoinc_lock;
 	lint	i = ib_vector_size(trx->autoinc_locks) - 1;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 	ut_ad(lock_get_mode(lock) == LOCK_AUTO_INC);
 	ut_ad(lock_get_type_low(lock) & LOCK_TABLE);
 	ut_ad(!ib_vector_is_empty(trx->autoinc_locks));
@@ -4324,7 +4554,7 @@ lock_table_remove_low(
 	trx_t*		trx;
 	dict_table_t*	table;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 
 	trx = lock->trx;
 	table = lock->un_member.tab_lock.table;
@@ -4502,7 +4732,7 @@ lock_table_other_has_incompatible(
 {
 	const lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 
 	if (lock_table_compatible_fast_check(mode, table))
 		return(NULL);
@@ -4540,6 +4770,7 @@ lock_table(
 	trx_t*		trx;
 	dberr_t		err;
 	const lock_t*	wait_for;
+	ib_mutex_t*	shard;
 
 	ut_ad(table != NULL);
 	ut_ad(thr != NULL);
@@ -4563,7 +4794,7 @@ lock_table(
 		return(DB_SUCCESS);
 	}
 
-	lock_mutex_enter();
+	shard = lock_table_shard_enter();
 
         DBUG_EXECUTE_IF("fatal-semaphore-timeout",
                         { os_thread_sleep(3600000000); });
@@ -4574,6 +4805,15 @@ lock_table(
 	wait_for = lock_table_other_has_incompatible(
 		trx, LOCK_WAIT, table, mode);
 
+	if (wait_for != NULL && shard != NULL) {
+		/* The request has to wait: the wait is enqueued under
+		lock_sys->mutex, and the queue may have changed. */
+		lock_shard_to_mutex(&shard);
+
+		wait_for = lock_table_other_has_incompatible(
+			trx, LOCK_WAIT, table, mode);
+	}
+
 	trx_mutex_enter(trx);
 
 	/* Another trx has a request on the table in an incompatible
@@ -4589,7 +4829,7 @@ lock_table(
 		err = DB_SUCCESS;
 	}
 
-	lock_mutex_exit();
+	lock_shard_exit(shard);
 
 	trx_mutex_exit(trx);
 
@@ -4637,7 +4877,7 @@ lock_table_has_to_wait_in_queue(
 	const dict_table_t*	table;
 	const lock_t*		lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 	ut_ad(lock_get_wait(wait_lock));
 
 	table = wait_lock->un_member.tab_lock.table;
@@ -4671,7 +4911,7 @@ lock_table_dequeue(
 	dict_table_t*   table;
 	enum lock_mode type = lock_get_mode(in_lock);
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 	ut_a(lock_get_type_low(in_lock) == LOCK_TABLE);
 
 	lock = UT_LIST_GET_NEXT(un_member.tab_lock.locks, in_lock);
@@ -4717,6 +4957,7 @@ lock_rec_unlock(
 {
 	lock_t*		first_lock;
 	lock_t*		lock;
+	ib_mutex_t*	shard;
 	ulint		heap_no;
 	const char*	stmt;
 	size_t		stmt_len;
@@ -4729,7 +4970,8 @@ lock_rec_unlock(
 
 	heap_no = page_rec_get_heap_no(rec);
 
-	lock_mutex_enter();
+	shard = lock_rec_shard_enter(buf_block_get_space(block),
+				     buf_block_get_page_no(block));
 	trx_mutex_enter(trx);
 
 	first_lock = lock_rec_get_first(block, heap_no);
@@ -4744,7 +4986,7 @@ lock_rec_unlock(
 		}
 	}
 
-	lock_mutex_exit();
+	lock_shard_exit(shard);
 	trx_mutex_exit(trx);
 
 	stmt = innobase_get_stmt(trx->mysql_thd, &stmt_len);
@@ -4776,13 +5018,15 @@ released:
 		}
 	}
 
-	lock_mutex_exit();
+	lock_shard_exit(shard);
 	trx_mutex_exit(trx);
 }
 
 /*********************************************************************//**
 Releases transaction locks, and releases possible other transactions waiting
-because of these locks. */
+because of these locks. If the lock system is sharded, the caller holds
+lock_sys->latch in shared mode and each lock is removed under the mutex of
+its shard; otherwise the caller holds lock_sys->mutex. */
 static
 void
 lock_release(
@@ -4792,16 +5036,22 @@ lock_release(
 	lock_t*		lock;
 	ulint		count = 0;
 	trx_id_t	max_trx_id;
+	const bool	sharded = lock_sys->n_rec_shards > 1;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(sharded || lock_mutex_own());
 	ut_ad(!trx_mutex_own(trx));
 
 	max_trx_id = trx_sys_get_max_trx_id();
 
+	/* Only this thread and the holders of lock_sys->mutex modify
+	trx->lock.trx_locks, so it can be traversed without a shard. */
+
 	for (lock = UT_LIST_GET_LAST(trx->lock.trx_locks);
 	     lock != NULL;
 	     lock = UT_LIST_GET_LAST(trx->lock.trx_locks)) {
 
+		ib_mutex_t*	shard = NULL;
+
 		if (lock_get_type_low(lock) == LOCK_REC) {
 
 #ifdef UNIV_DEBUG
@@ -4816,6 +5066,14 @@ lock_release(
 			}
 #endif /* UNIV_DEBUG */
 
+			if (sharded) {
+				shard = lock_rec_get_shard(
+					lock->un_member.rec_lock.space,
+					lock->un_member.rec_lock.page_no);
+
+				mutex_enter(shard);
+			}
+
 			lock_rec_dequeue_from_page(lock);
 		} else {
 			dict_table_t*	table;
@@ -4835,6 +5093,12 @@ lock_release(
 			}
 #endif /* UNIV_DEBUG */
 
+			if (sharded) {
+				shard = &lock_sys->table_mutex;
+
+				mutex_enter(shard);
+			}
+
 			if (lock_get_mode(lock) != LOCK_IS
 			    && trx->undo_no != 0) {
 
@@ -4848,13 +5112,23 @@ lock_release(
 			lock_table_dequeue(lock);
 		}
 
+		if (shard != NULL) {
+			mutex_exit(shard);
+		}
+
 		if (count == LOCK_RELEASE_INTERVAL) {
-			/* Release the  mutex for a while, so that we
+			/* Release the latch for a while, so that we
 			do not monopolize it */
 
-			lock_mutex_exit();
+			if (sharded) {
+				rw_lock_s_unlock(&lock_sys->latch);
 
-			lock_mutex_enter();
+				rw_lock_s_lock(&lock_sys->latch);
+			} else {
+				lock_mutex_exit();
+
+				lock_mutex_enter();
+			}
 
 			count = 0;
 		}
@@ -4891,9 +5165,10 @@ lock_trx_table_locks_remove(
 	lint		i;
 	trx_t*		trx = lock_to_remove->trx;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 
-	/* It is safe to read this because we are holding the lock mutex */
+	/* It is safe to read this because we are holding the lock mutex
+	or the table lock shard: cancel is only set under the lock mutex */
 	if (!trx->lock.cancel) {
 		trx_mutex_enter(trx);
 	} else {
@@ -5186,7 +5461,7 @@ lock_rec_print(
 	ulint*			offsets		= offsets_;
 	rec_offs_init(offsets_);
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 	ut_a(lock_get_type_low(lock) == LOCK_REC);
 
 	space = lock->un_member.rec_lock.space;
@@ -6105,6 +6380,8 @@ lock_rec_insert_check_and_lock(
 	const rec_t*	next_rec;
 	trx_t*		trx;
 	lock_t*		lock;
+	const lock_t*	wait_for;
+	ib_mutex_t*	shard;
 	dberr_t		err;
 	ulint		next_rec_heap_no;
 	ibool		inherit_in = *inherit;
@@ -6123,7 +6400,8 @@ lock_rec_insert_check_and_lock(
 	next_rec = page_rec_get_next_const(rec);
 	next_rec_heap_no = page_rec_get_heap_no(next_rec);
 
-	lock_mutex_enter();
+	shard = lock_rec_shard_enter(buf_block_get_space(block),
+				     buf_block_get_page_no(block));
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
 	to hold trx->mutex here. */
@@ -6138,7 +6416,7 @@ lock_rec_insert_check_and_lock(
 	if (UNIV_LIKELY(lock == NULL)) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
+		lock_shard_exit(shard);
 
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
@@ -6164,10 +6442,23 @@ lock_rec_insert_check_and_lock(
 	had to wait for their insert. Both had waiting gap type lock requests
 	on the successor, which produced an unnecessary deadlock. */
 
-	if (lock_rec_other_has_conflicting(
-		    static_cast<enum lock_mode>(
-			    LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION),
-		    block, next_rec_heap_no, trx)) {
+	wait_for = lock_rec_other_has_conflicting(
+		static_cast<enum lock_mode>(
+			LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION),
+		block, next_rec_heap_no, trx);
+
+	if (wait_for != NULL && shard != NULL) {
+		/* The insert has to wait: the wait is enqueued under
+		lock_sys->mutex, and the queue may have changed. */
+		lock_shard_to_mutex(&shard);
+
+		wait_for = lock_rec_other_has_conflicting(
+			static_cast<enum lock_mode>(
+				LOCK_X | LOCK_GAP | LOCK_INSERT_INTENTION),
+			block, next_rec_heap_no, trx);
+	}
+
+	if (wait_for != NULL) {
 
 		/* Note that we may get DB_SUCCESS also here! */
 		trx_mutex_enter(trx);
@@ -6181,7 +6472,7 @@ lock_rec_insert_check_and_lock(
 		err = DB_SUCCESS;
 	}
 
-	lock_mutex_exit();
+	lock_shard_exit(shard);
 
 	switch (err) {
 	case DB_SUCCESS_LOCKED_REC:
@@ -6328,17 +6619,11 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP, LOCK_X_REGULAR,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	if (UNIV_UNLIKELY(err == DB_SUCCESS_LOCKED_REC)) {
@@ -6388,17 +6673,11 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
-
 	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP, LOCK_X_REGULAR,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 #ifdef UNIV_DEBUG
 	{
 		mem_heap_t*	heap		= NULL;
@@ -6491,8 +6770,6 @@ lock_sec_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
@@ -6501,10 +6778,6 @@ lock_sec_rec_read_check_and_lock(
 	err = lock_rec_lock(FALSE, mode | gap_mode, x_mode,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	return(err);
@@ -6567,8 +6840,6 @@ lock_clust_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
 	ut_ad(mode != LOCK_X
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
 	ut_ad(mode != LOCK_S
@@ -6577,10 +6848,6 @@ lock_clust_rec_read_check_and_lock(
 	err = lock_rec_lock(FALSE, mode | gap_mode, x_mode,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	return(err);
@@ -6649,7 +6916,7 @@ lock_release_autoinc_last_lock(
 	ulint		last;
 	lock_t*		lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 	ut_a(!ib_vector_is_empty(autoinc_locks));
 
 	/* The lock to be release must be the last lock acquired. */
@@ -6691,7 +6958,7 @@ lock_release_autoinc_locks(
 /*=======================*/
 	trx_t*		trx)		/*!< in/out: transaction */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_table_latched());
 	/* If this is invoked for a running transaction by the thread
 	that is serving the transaction, then it is not necessary to
 	hold trx->mutex here. */
@@ -6988,11 +7255,11 @@ lock_unlock_table_autoinc(
 	necessary to hold trx->mutex here. */
 
 	if (lock_trx_holds_autoinc_locks(trx)) {
-		lock_mutex_enter();
+		ib_mutex_t*	shard = lock_table_shard_enter();
 
 		lock_release_autoinc_locks(trx);
 
-		lock_mutex_exit();
+		lock_shard_exit(shard);
 	}
 }
 
@@ -7006,6 +7273,8 @@ lock_trx_release_locks(
 /*===================*/
 	trx_t*	trx)	/*!< in/out: transaction */
 {
+	const bool	sharded = lock_sys->n_rec_shards > 1;
+
 	assert_trx_in_list(trx);
 
 	if (trx_state_eq(trx, TRX_STATE_PREPARED)) {
@@ -7022,8 +7291,22 @@ lock_trx_release_locks(
 	}
 
 	/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-	is protected by both the lock_sys->mutex and the trx->mutex. */
-	lock_mutex_enter();
+	is protected by both the lock_sys->latch and the trx->mutex. If
+	the lock system is sharded, the latch is held in shared mode, which
+	is enough to exclude the holders of lock_sys->mutex. For a
+	read-write transaction we also acquire trx_sys->mutex, because
+	the state transition must be atomic with the removal of the trx id
+	from trx_sys->descriptors. */
+	if (sharded) {
+		rw_lock_s_lock(&lock_sys->latch);
+	} else {
+		lock_mutex_enter();
+	}
+
+	if (!trx->read_only) {
+		mutex_enter(&trx_sys->mutex);
+	}
+
 	trx_mutex_enter(trx);
 
 	/* The following assignment makes the transaction committed in memory
@@ -7059,9 +7342,19 @@ lock_trx_release_locks(
 
 	trx_mutex_exit(trx);
 
+	if (!trx->read_only) {
+		trx_release_descriptor(trx);
+
+		mutex_exit(&trx_sys->mutex);
+	}
+
 	lock_release(trx);
 
-	lock_mutex_exit();
+	if (sharded) {
+		rw_lock_s_unlock(&lock_sys->latch);
+	} else {
+		lock_mutex_exit();
+	}
 }
 
 /*********************************************************************//**
@@ -494,7 +494,7 @@ lock_wait_release_thread_if_suspended(
 	que_thr_t*	thr)	/*!< in: query thread associated with the
 				user OS thread	 */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_latched());
 	ut_ad(trx_mutex_own(thr_get_trx(thr)));
 
 	/* We own both the lock mutex and the trx_t::mutex but not the
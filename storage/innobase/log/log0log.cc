@@ -90,8 +90,14 @@ UNIV_INTERN mysql_pfs_key_t	archive_lock_key;
 #ifdef UNIV_PFS_MUTEX
 UNIV_INTERN mysql_pfs_key_t	log_sys_mutex_key;
 UNIV_INTERN mysql_pfs_key_t	log_flush_order_mutex_key;
+UNIV_INTERN mysql_pfs_key_t	log_write_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
+#ifdef UNIV_PFS_THREAD
+UNIV_INTERN mysql_pfs_key_t	log_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	log_flusher_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 #ifdef UNIV_DEBUG
 UNIV_INTERN ibool	log_do_write = TRUE;
 #endif /* UNIV_DEBUG */
@@ -171,14 +177,23 @@ log_buf_pool_get_oldest_modification(void)
 /*======================================*/
 {
 	lsn_t	lsn;
+	lsn_t	written_lsn;
 
 	ut_ad(mutex_own(&(log_sys->mutex)));
 
+	/* In the concurrent write mode log_sys->lsn is advanced by the log
+	writer without the log mutex. Read it before the flush lists: a page
+	dirtied after they have been scanned was dirtied by a
+	mini-transaction which reserved its lsn range after that. */
+	written_lsn = log_sys->lsn;
+
+	os_rmb;
+
 	lsn = buf_pool_get_oldest_modification();
 
 	if (!lsn) {
 
-		lsn = log_sys->lsn;
+		lsn = written_lsn;
 	}
 
 	return(lsn);
@@ -440,45 +455,19 @@ part_loop:
 }
 
 /************************************************************//**
-Closes the log.
-@return	lsn */
-UNIV_INTERN
-lsn_t
-log_close(void)
-/*===========*/
+Checks the age of the last checkpoint after a mini-transaction log has
+been catenated to the log buffer, and requests a preflush or a checkpoint
+from log_free_check() if needed. */
+static
+void
+log_check_checkpoint_age(
+/*=====================*/
+	lsn_t	lsn)	/*!< in: end lsn of the mini-transaction log */
 {
-	byte*		log_block;
-	ulint		first_rec_group;
 	lsn_t		oldest_lsn;
-	lsn_t		lsn;
 	log_t*		log	= log_sys;
 	lsn_t		checkpoint_age;
 
-	ut_ad(mutex_own(&(log->mutex)));
-	ut_ad(!recv_no_log_write);
-
-	lsn = log->lsn;
-
-	log_block = static_cast<byte*>(
-		ut_align_down(
-			log->buf + log->buf_free, OS_FILE_LOG_BLOCK_SIZE));
-
-	first_rec_group = log_block_get_first_rec_group(log_block);
-
-	if (first_rec_group == 0) {
-		/* We initialized a new log block which was not written
-		full by the current mtr: the next mtr log record group
-		will start within this block at the offset data_len */
-
-		log_block_set_first_rec_group(
-			log_block, log_block_get_data_len(log_block));
-	}
-
-	if (log->buf_free > log->max_buf_free) {
-
-		log->check_flush_or_checkpoint = TRUE;
-	}
-
 	checkpoint_age = lsn - log->last_checkpoint_lsn;
 
 	if (checkpoint_age >= log->log_group_capacity) {
@@ -512,7 +501,7 @@ log_close(void)
 
 	if (checkpoint_age <= log->max_modified_age_sync) {
 
-		goto function_exit;
+		return;
 	}
 
 	oldest_lsn = buf_pool_get_oldest_modification();
@@ -523,7 +512,47 @@ log_close(void)
 
 		log->check_flush_or_checkpoint = TRUE;
 	}
-function_exit:
+}
+
+/************************************************************//**
+Closes the log.
+@return	lsn */
+UNIV_INTERN
+lsn_t
+log_close(void)
+/*===========*/
+{
+	byte*		log_block;
+	ulint		first_rec_group;
+	lsn_t		lsn;
+	log_t*		log	= log_sys;
+
+	ut_ad(mutex_own(&(log->mutex)));
+	ut_ad(!recv_no_log_write);
+
+	lsn = log->lsn;
+
+	log_block = static_cast<byte*>(
+		ut_align_down(
+			log->buf + log->buf_free, OS_FILE_LOG_BLOCK_SIZE));
+
+	first_rec_group = log_block_get_first_rec_group(log_block);
+
+	if (first_rec_group == 0) {
+		/* We initialized a new log block which was not written
+		full by the current mtr: the next mtr log record group
+		will start within this block at the offset data_len */
+
+		log_block_set_first_rec_group(
+			log_block, log_block_get_data_len(log_block));
+	}
+
+	if (log->buf_free > log->max_buf_free) {
+
+		log->check_flush_or_checkpoint = TRUE;
+	}
+
+	log_check_checkpoint_age(lsn);
 
 #ifdef UNIV_LOG_DEBUG
 	log_check_log_recs(log->buf + log->old_buf_free,
@@ -577,7 +606,7 @@ log_group_get_capacity(
 /*===================*/
 	const log_group_t*	group)	/*!< in: log group */
 {
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || log_write_mutex_own());
 
 	return((group->file_size - LOG_FILE_HDR_SIZE) * group->n_files);
 }
@@ -594,7 +623,7 @@ log_group_calc_size_offset(
 					log group */
 	const log_group_t*	group)	/*!< in: log group */
 {
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || log_write_mutex_own());
 
 	return(offset - LOG_FILE_HDR_SIZE * (1 + offset / group->file_size));
 }
@@ -611,7 +640,7 @@ log_group_calc_real_offset(
 					log group */
 	const log_group_t*	group)	/*!< in: log group */
 {
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || log_write_mutex_own());
 
 	return(offset + LOG_FILE_HDR_SIZE
 	       * (1 + offset / (group->file_size - LOG_FILE_HDR_SIZE)));
@@ -633,7 +662,7 @@ log_group_calc_lsn_offset(
 	lsn_t	group_size;
 	lsn_t	offset;
 
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || log_write_mutex_own());
 
 	gr_lsn = group->lsn;
 
@@ -883,6 +912,9 @@ log_init(void)
 		     &log_sys->log_flush_order_mutex,
 		     SYNC_LOG_FLUSH_ORDER);
 
+	mutex_create(log_write_mutex_key, &log_sys->write_mutex,
+		     SYNC_LOG_WRITE);
+
 	mutex_enter(&(log_sys->mutex));
 
 	/* Start the lsn from one log block from zero: this way every
@@ -909,6 +941,21 @@ log_init(void)
 	log_sys->check_flush_or_checkpoint = TRUE;
 	UT_LIST_INIT(log_sys->log_groups);
 
+	/* The concurrent write mode is enabled by
+	log_concurrent_writes_enable() after recovery */
+	log_sys->concurrent_writes = false;
+	log_sys->sn = 0;
+	log_sys->recent_written = NULL;
+	log_sys->write_buf_ptr = NULL;
+	log_sys->write_buf = NULL;
+	log_sys->writer_event = NULL;
+	log_sys->flusher_event = NULL;
+	log_sys->write_events = NULL;
+	log_sys->flush_events = NULL;
+	log_sys->n_flush_waiters = 0;
+	log_sys->writer_thread_active = false;
+	log_sys->flusher_thread_active = false;
+
 	log_sys->n_log_ios = 0;
 
 	log_sys->n_log_ios_old = log_sys->n_log_ios;
@@ -1295,7 +1342,7 @@ log_group_file_header_flush(
 	byte*	buf;
 	lsn_t	dest_offset;
 
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || log_write_mutex_own());
 	ut_ad(!recv_no_log_write);
 	ut_a(nth_file < group->n_files);
 
@@ -1369,7 +1416,7 @@ log_group_write_buf(
 	lsn_t		next_offset;
 	ulint		i;
 
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(mutex_own(&(log_sys->mutex)) || log_write_mutex_own());
 	ut_ad(!recv_no_log_write);
 	ut_a(len % OS_FILE_LOG_BLOCK_SIZE == 0);
 	ut_a(start_lsn % OS_FILE_LOG_BLOCK_SIZE == 0);
@@ -1475,6 +1522,693 @@ loop:
 	}
 }
 
+/*
+Concurrent write mode
+=====================
+
+In the concurrent write mode (innodb_log_writer_threads), mini-transactions
+do not acquire log_sys->mutex to write their log:
+
+1) A mini-transaction reserves the lsn range [start, end) for its log by
+atomically incrementing log_sys->sn, the number of log data bytes reserved
+so far. The log block headers and trailers are not counted in sn, so that
+the range can be computed without looking at the log buffer.
+
+2) It copies its log to the log buffer, which is then a ring where the log
+block holding an lsn is at offset lsn % buf_size, and stores end in the slot
+start % LOG_RECENT_WRITTEN_SIZE of log_sys->recent_written. The
+mini-transaction which fills a log block initializes the header of the next
+one.
+
+3) The log writer thread follows the chain of completed ranges from
+log_sys->lsn, writes the log up to the first range which has not been
+completed, and wakes up the threads waiting in log_write_up_to() for an lsn
+in the written part. The log flusher thread flushes the log files to disk
+when some thread waits for it.
+
+A mini-transaction which dirties a clean page holds log_flush_order_mutex
+from the reservation until it has added the page to the flush list, so that
+the flush lists stay ordered by oldest_modification. */
+
+/******************************************************//**
+Wakes up the threads waiting for an lsn in [old_lsn, new_lsn] on one of the
+event arrays of the concurrent write mode. */
+static
+void
+log_concurrent_notify(
+/*==================*/
+	os_event_t*	events,		/*!< in: log_sys->write_events or
+					log_sys->flush_events */
+	lsn_t		old_lsn,	/*!< in: previous value of the lsn */
+	lsn_t		new_lsn)	/*!< in: new value of the lsn */
+{
+	lsn_t	first = old_lsn / OS_FILE_LOG_BLOCK_SIZE;
+	lsn_t	last = new_lsn / OS_FILE_LOG_BLOCK_SIZE;
+
+	if (last - first >= LOG_N_WAIT_EVENTS) {
+		first = 0;
+		last = LOG_N_WAIT_EVENTS - 1;
+	}
+
+	for (lsn_t i = first; i <= last; i++) {
+		os_event_set(events[i % LOG_N_WAIT_EVENTS]);
+	}
+}
+
+/******************************************************//**
+Writes the log which has been completely copied to the log buffer to the
+log files in the concurrent write mode.
+@return	true if something was written */
+static
+bool
+log_concurrent_write_low(void)
+/*==========================*/
+{
+	log_t*		log	= log_sys;
+	lsn_t		lsn	= log->lsn;
+	lsn_t		old_write_lsn;
+	lsn_t		area_start;
+	ulint		area_len;
+	ulint		offset;
+	log_group_t*	group;
+
+	ut_ad(log_write_mutex_own());
+	ut_ad(!recv_no_log_write);
+
+	/* Follow the chain of the completed ranges */
+	for (;;) {
+		lsn_t*	slot = &log->recent_written[
+			lsn % LOG_RECENT_WRITTEN_SIZE];
+		lsn_t	end_lsn = *slot;
+
+		if (end_lsn == 0) {
+			break;
+		}
+
+		ut_ad(end_lsn > lsn);
+
+		*slot = 0;
+		lsn = end_lsn;
+	}
+
+	/* Read the log buffer only after the slots, and free the slots
+	before the mini-transactions can see the new log->lsn */
+	os_rmb;
+	os_wmb;
+
+	log->lsn = lsn;
+
+	old_write_lsn = log->write_lsn;
+
+	if (lsn == old_write_lsn) {
+
+		return(false);
+	}
+
+	ut_ad(lsn > old_write_lsn);
+
+	area_start = ut_uint64_align_down(old_write_lsn,
+					  OS_FILE_LOG_BLOCK_SIZE);
+	area_len = (ulint) (ut_uint64_align_up(lsn, OS_FILE_LOG_BLOCK_SIZE)
+			    - area_start);
+
+	ut_ad(area_len <= log->buf_size);
+
+	/* Copy the blocks out of the ring: the last one may still be filled
+	by mini-transactions while we write it */
+	offset = (ulint) (area_start % log->buf_size);
+
+	if (offset + area_len > log->buf_size) {
+		ulint	first_len = log->buf_size - offset;
+
+		ut_memcpy(log->write_buf, log->buf + offset, first_len);
+		ut_memcpy(log->write_buf + first_len, log->buf,
+			  area_len - first_len);
+	} else {
+		ut_memcpy(log->write_buf, log->buf + offset, area_len);
+	}
+
+	for (ulint i = 0; i < area_len; i += OS_FILE_LOG_BLOCK_SIZE) {
+		byte*	block = log->write_buf + i;
+
+		log_block_set_data_len(
+			block, i + OS_FILE_LOG_BLOCK_SIZE < area_len
+			? OS_FILE_LOG_BLOCK_SIZE
+			: (ulint) (lsn % OS_FILE_LOG_BLOCK_SIZE));
+		log_block_set_checkpoint_no(block, log->next_checkpoint_no);
+	}
+
+	log_block_set_flush_bit(log->write_buf, TRUE);
+
+	for (group = UT_LIST_GET_FIRST(log->log_groups);
+	     group != NULL;
+	     group = UT_LIST_GET_NEXT(log_groups, group)) {
+
+		log_group_write_buf(group, log->write_buf, area_len,
+				    area_start,
+				    (ulint) (old_write_lsn - area_start));
+	}
+
+	log->write_lsn = lsn;
+	log->written_to_some_lsn = lsn;
+	log->written_to_all_lsn = lsn;
+
+	if (srv_unix_file_flush_method == SRV_UNIX_O_DSYNC
+	    || srv_unix_file_flush_method == SRV_UNIX_ALL_O_DIRECT) {
+		lsn_t	old_flushed_lsn;
+
+		/* O_DSYNC and ALL_O_DIRECT means the OS did not buffer the
+		log file at all: so we have also flushed to disk what
+		we have written */
+
+		mutex_enter(&log->mutex);
+
+		old_flushed_lsn = log->flushed_to_disk_lsn;
+		log->flushed_to_disk_lsn = lsn;
+		log->n_syncs++;
+
+		mutex_exit(&log->mutex);
+
+		log_concurrent_notify(log->flush_events, old_flushed_lsn, lsn);
+	}
+
+	log_concurrent_notify(log->write_events, old_write_lsn, lsn);
+
+	if (log->n_flush_waiters > 0) {
+		os_event_set(log->flusher_event);
+	}
+
+	return(true);
+}
+
+/******************************************************//**
+Flushes the written log to disk in the concurrent write mode.
+@return	true if a flush was done */
+static
+bool
+log_concurrent_flush_low(void)
+/*==========================*/
+{
+	log_t*	log	= log_sys;
+	lsn_t	lsn	= log->write_lsn;
+	lsn_t	old_flushed_lsn;
+
+	if (srv_unix_file_flush_method == SRV_UNIX_O_DSYNC
+	    || srv_unix_file_flush_method == SRV_UNIX_ALL_O_DIRECT
+	    || lsn <= log->flushed_to_disk_lsn) {
+
+		/* The log writer has already done it */
+		return(false);
+	}
+
+	fil_flush(UT_LIST_GET_FIRST(log->log_groups)->space_id,
+		  FLUSH_FROM_LOG_WRITE_UP_TO);
+
+	mutex_enter(&log->mutex);
+
+	old_flushed_lsn = log->flushed_to_disk_lsn;
+
+	if (lsn > old_flushed_lsn) {
+		log->flushed_to_disk_lsn = lsn;
+	}
+
+	log->n_syncs++;
+
+	mutex_exit(&log->mutex);
+
+	if (lsn > old_flushed_lsn) {
+		log_concurrent_notify(log->flush_events, old_flushed_lsn, lsn);
+	}
+
+	return(true);
+}
+
+/******************************************************//**
+Waits until the log has been written to the log files up to an lsn in the
+concurrent write mode. */
+static
+void
+log_concurrent_wait_written(
+/*========================*/
+	lsn_t	lsn)	/*!< in: lsn to wait for */
+{
+	log_t*		log	= log_sys;
+	os_event_t	event	= log->write_events[
+		(lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_N_WAIT_EVENTS];
+
+	for (;;) {
+		ib_int64_t	sig_count = os_event_reset(event);
+
+		if (log->write_lsn >= lsn) {
+
+			return;
+		}
+
+		if (log->writer_thread_active) {
+			os_event_set(log->writer_event);
+		} else {
+			mutex_enter(&log->write_mutex);
+			log_concurrent_write_low();
+			mutex_exit(&log->write_mutex);
+		}
+
+		os_event_wait_time_low(event, 100000, sig_count);
+	}
+}
+
+/******************************************************//**
+Waits until the log has been flushed to disk up to an lsn in the concurrent
+write mode. The log must have been written up to the lsn. */
+static
+void
+log_concurrent_wait_flushed(
+/*========================*/
+	lsn_t	lsn)	/*!< in: lsn to wait for */
+{
+	log_t*		log	= log_sys;
+	os_event_t	event	= log->flush_events[
+		(lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_N_WAIT_EVENTS];
+
+	ut_ad(log->write_lsn >= lsn);
+
+#ifdef HAVE_ATOMIC_BUILTINS_64
+	os_atomic_increment_ulint(&log->n_flush_waiters, 1);
+#endif /* HAVE_ATOMIC_BUILTINS_64 */
+
+	for (;;) {
+		ib_int64_t	sig_count = os_event_reset(event);
+
+		if (log->flushed_to_disk_lsn >= lsn) {
+
+			break;
+		}
+
+		if (log->flusher_thread_active) {
+			os_event_set(log->flusher_event);
+		} else {
+			log_concurrent_flush_low();
+		}
+
+		os_event_wait_time_low(event, 100000, sig_count);
+	}
+
+#ifdef HAVE_ATOMIC_BUILTINS_64
+	os_atomic_decrement_ulint(&log->n_flush_waiters, 1);
+#endif /* HAVE_ATOMIC_BUILTINS_64 */
+}
+
+/******************************************************//**
+Reports the part of the log of a mini-transaction which has been copied to
+the log buffer to the log writer, in the concurrent write mode. */
+static
+void
+log_concurrent_complete(
+/*====================*/
+	log_handle_t*	handle)	/*!< in/out: reserved range */
+{
+	lsn_t	start_lsn = handle->completed_lsn;
+
+	if (start_lsn == handle->lsn) {
+
+		return;
+	}
+
+	ut_ad(start_lsn < handle->lsn);
+
+	/* The slot is free once the log writer has consumed the range
+	which used it before */
+	if (start_lsn - log_sys->lsn >= LOG_RECENT_WRITTEN_SIZE) {
+		log_concurrent_wait_written(
+			start_lsn - LOG_RECENT_WRITTEN_SIZE + 1);
+	}
+
+	/* The log writer must see the copy before the slot */
+	os_wmb;
+
+	log_sys->recent_written[start_lsn % LOG_RECENT_WRITTEN_SIZE]
+		= handle->lsn;
+
+	handle->completed_lsn = handle->lsn;
+}
+
+/************************************************************//**
+Reserves an lsn range for a mini-transaction log in the concurrent
+write mode. This does not acquire the log mutex: the range is claimed
+with an atomic increment, and the log must then be copied with
+log_concurrent_write and the range closed with log_concurrent_close. */
+UNIV_INTERN
+void
+log_concurrent_reserve(
+/*===================*/
+	ulint		len,	/*!< in: length of the log */
+	log_handle_t*	handle)	/*!< out: reserved range */
+{
+	lsn_t	start_sn;
+
+	ut_ad(log_sys->concurrent_writes);
+	ut_ad(!recv_no_log_write);
+
+#ifdef HAVE_ATOMIC_BUILTINS_64
+	start_sn = os_atomic_increment_uint64(&log_sys->sn, len) - len;
+#else /* HAVE_ATOMIC_BUILTINS_64 */
+	/* innobase_init() does not enable innodb_log_writer_threads
+	without 64-bit atomic operations */
+	start_sn = 0;
+	ut_error;
+#endif /* HAVE_ATOMIC_BUILTINS_64 */
+
+	handle->start_lsn = log_sn_to_lsn(start_sn);
+	handle->end_lsn = log_sn_to_lsn(start_sn + len);
+	handle->lsn = handle->start_lsn;
+	handle->completed_lsn = handle->start_lsn;
+}
+
+/************************************************************//**
+Copies a part of a mini-transaction log to the log buffer in the
+concurrent write mode. */
+UNIV_INTERN
+void
+log_concurrent_write(
+/*=================*/
+	log_handle_t*	handle,	/*!< in/out: reserved range */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len)/*!< in: string length */
+{
+	log_t*	log	= log_sys;
+
+	ut_ad(log->concurrent_writes);
+
+	while (str_len > 0) {
+		lsn_t	lsn		= handle->lsn;
+		lsn_t	block_lsn	= ut_uint64_align_down(
+			lsn, OS_FILE_LOG_BLOCK_SIZE);
+		ulint	len		= OS_FILE_LOG_BLOCK_SIZE
+			- LOG_BLOCK_TRL_SIZE
+			- (ulint) (lsn % OS_FILE_LOG_BLOCK_SIZE);
+		bool	fills		= len <= str_len;
+		lsn_t	need_lsn;
+
+		ut_ad(lsn < handle->end_lsn);
+
+		if (!fills) {
+			len = str_len;
+		}
+
+		/* The end of the last block we are going to touch; if we
+		fill this block, we initialize the next one */
+		need_lsn = block_lsn
+			+ (fills ? 2 : 1) * OS_FILE_LOG_BLOCK_SIZE;
+
+		if (need_lsn > ut_uint64_align_down(
+			    log->write_lsn, OS_FILE_LOG_BLOCK_SIZE)
+		    + log->buf_size) {
+
+			/* Not enough free space in the log buffer: let the
+			log writer write what we have copied so far */
+
+			log_concurrent_complete(handle);
+
+			srv_stats.log_waits.inc();
+
+			log_concurrent_wait_written(need_lsn - log->buf_size);
+		}
+
+		ut_memcpy(log->buf + (ulint) (lsn % log->buf_size),
+			  str, len);
+
+		str += len;
+		str_len -= len;
+
+		if (fills) {
+			lsn_t	next_lsn = block_lsn + OS_FILE_LOG_BLOCK_SIZE;
+			byte*	block = log->buf
+				+ (ulint) (next_lsn % log->buf_size);
+
+			log_block_set_hdr_no(
+				block, log_block_convert_lsn_to_no(next_lsn));
+			log_block_set_data_len(block, LOG_BLOCK_HDR_SIZE);
+
+			/* The next mini-transaction will start at our end,
+			if that is within the block */
+			log_block_set_first_rec_group(
+				block,
+				handle->end_lsn - next_lsn
+				< OS_FILE_LOG_BLOCK_SIZE
+				? (ulint) (handle->end_lsn % OS_FILE_LOG_BLOCK_SIZE)
+				: 0);
+
+			handle->lsn = next_lsn + LOG_BLOCK_HDR_SIZE;
+		} else {
+			handle->lsn = lsn + len;
+		}
+	}
+}
+
+/************************************************************//**
+Closes an lsn range in the concurrent write mode, after the whole log
+of the mini-transaction has been copied to the log buffer. */
+UNIV_INTERN
+void
+log_concurrent_close(
+/*=================*/
+	log_handle_t*	handle)	/*!< in/out: reserved range */
+{
+	ut_ad(handle->lsn == handle->end_lsn);
+
+	log_concurrent_complete(handle);
+
+	MONITOR_SET(MONITOR_LSN_CHECKPOINT_AGE,
+		    handle->end_lsn - log_sys->last_checkpoint_lsn);
+
+	log_check_checkpoint_age(handle->end_lsn);
+}
+
+/******************************************************************//**
+The log writer thread writes the log buffer to the log files as
+mini-transactions complete their copies to it in the concurrent write
+mode.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg __attribute__((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	log_t*	log	= log_sys;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_writer_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	while (srv_shutdown_state != SRV_SHUTDOWN_LAST_PHASE
+	       && srv_shutdown_state != SRV_SHUTDOWN_EXIT_THREADS) {
+		ib_int64_t	sig_count = os_event_reset(log->writer_event);
+		bool		written;
+
+		mutex_enter(&log->write_mutex);
+		written = log_concurrent_write_low();
+		mutex_exit(&log->write_mutex);
+
+		if (!written) {
+			/* The mini-transactions do not wake us up when they
+			complete their copies: poll while some are copying */
+			os_event_wait_time_low(
+				log->writer_event,
+				log_sn_to_lsn(log->sn) > log->lsn
+				? 100 : 1000000,
+				sig_count);
+		}
+	}
+
+	log->writer_thread_active = false;
+
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************************//**
+The log flusher thread flushes the log files to disk in the concurrent
+write mode, when some thread waits for it.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg __attribute__((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	log_t*	log	= log_sys;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_flusher_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	while (srv_shutdown_state != SRV_SHUTDOWN_LAST_PHASE
+	       && srv_shutdown_state != SRV_SHUTDOWN_EXIT_THREADS) {
+		ib_int64_t	sig_count = os_event_reset(log->flusher_event);
+
+		if (log->n_flush_waiters == 0 || !log_concurrent_flush_low()) {
+			os_event_wait_time_low(
+				log->flusher_event, 1000000, sig_count);
+		}
+	}
+
+	log->flusher_thread_active = false;
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************//**
+Switches the log to the concurrent write mode and starts the log writer
+and log flusher threads. Must be called at startup, after recovery and
+before any other thread can generate redo log. */
+UNIV_INTERN
+void
+log_concurrent_writes_enable(void)
+/*==============================*/
+{
+	log_t*	log	= log_sys;
+	lsn_t	block_lsn;
+
+	ut_ad(!srv_read_only_mode);
+	ut_a(!log->concurrent_writes);
+	ut_a(log->buf_size % OS_FILE_LOG_BLOCK_SIZE == 0);
+
+	/* Write out the log buffer, so that only the last, incomplete,
+	log block has to be moved to its place in the ring */
+	log_buffer_flush_to_disk();
+
+	mutex_enter(&log->mutex);
+
+	ut_a(log->written_to_all_lsn == log->lsn);
+	ut_a(log->n_pending_writes == 0);
+
+	block_lsn = ut_uint64_align_down(log->lsn, OS_FILE_LOG_BLOCK_SIZE);
+
+	ut_memmove(log->buf + (ulint) (block_lsn % log->buf_size),
+		   log->buf + ut_calc_align_down(log->buf_free,
+						 OS_FILE_LOG_BLOCK_SIZE),
+		   OS_FILE_LOG_BLOCK_SIZE);
+
+	log->write_buf_ptr = static_cast<byte*>(
+		mem_zalloc(log->buf_size
+			   + max((ulong) OS_FILE_LOG_BLOCK_SIZE,
+				 srv_trx_log_write_block_size)));
+
+	log->write_buf = static_cast<byte*>(
+		ut_align(log->write_buf_ptr, OS_FILE_LOG_BLOCK_SIZE));
+
+	log->recent_written = static_cast<lsn_t*>(
+		mem_zalloc(LOG_RECENT_WRITTEN_SIZE * sizeof(lsn_t)));
+
+	log->write_events = static_cast<os_event_t*>(
+		mem_alloc(LOG_N_WAIT_EVENTS * sizeof(os_event_t)));
+
+	log->flush_events = static_cast<os_event_t*>(
+		mem_alloc(LOG_N_WAIT_EVENTS * sizeof(os_event_t)));
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		log->write_events[i] = os_event_create();
+		log->flush_events[i] = os_event_create();
+	}
+
+	log->writer_event = os_event_create();
+	log->flusher_event = os_event_create();
+
+	log->sn = log_lsn_to_sn(log->lsn);
+	log->write_lsn = log->lsn;
+	log->n_flush_waiters = 0;
+	log->writer_thread_active = true;
+	log->flusher_thread_active = true;
+	log->concurrent_writes = true;
+
+	mutex_exit(&log->mutex);
+
+	os_thread_create(log_writer_thread, NULL, NULL);
+	os_thread_create(log_flusher_thread, NULL, NULL);
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Started the log writer and log flusher threads");
+}
+
+/******************************************************//**
+Makes the log writer and log flusher threads exit. Must be called at
+shutdown after srv_shutdown_state has been set to
+SRV_SHUTDOWN_LAST_PHASE. */
+UNIV_INTERN
+void
+log_concurrent_threads_exit(void)
+/*=============================*/
+{
+	log_t*	log	= log_sys;
+
+	ut_ad(srv_shutdown_state == SRV_SHUTDOWN_LAST_PHASE);
+
+	if (!log->concurrent_writes) {
+
+		return;
+	}
+
+	while (log->writer_thread_active || log->flusher_thread_active) {
+		os_event_set(log->writer_event);
+		os_event_set(log->flusher_event);
+
+		os_thread_sleep(10000);
+	}
+}
+
+/******************************************************//**
+Implements log_write_up_to() in the concurrent write mode. */
+static
+void
+log_concurrent_write_up_to(
+/*=======================*/
+	lsn_t		lsn,	/*!< in: log sequence number up to which
+				the log should be written,
+				LSN_MAX if not specified */
+	ulint		wait,	/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+				or LOG_WAIT_ALL_GROUPS */
+	ibool		flush_to_disk,
+				/*!< in: TRUE if we want the written log
+				also to be flushed to disk */
+	log_sync_type	caller)	/*!< in: identifies caller */
+{
+	log_t*	log	= log_sys;
+
+	if (lsn == LSN_MAX) {
+		lsn = log_get_lsn();
+	}
+
+	if (flush_to_disk
+	    ? log->flushed_to_disk_lsn >= lsn
+	    : log->write_lsn >= lsn) {
+
+		return;
+	}
+
+	if (wait == LOG_NO_WAIT && !flush_to_disk) {
+		os_event_set(log->writer_event);
+
+		return;
+	}
+
+	log_concurrent_wait_written(lsn);
+
+	if (flush_to_disk) {
+		log_concurrent_wait_flushed(lsn);
+
+		log->log_sync_syncers[caller]++;
+	}
+}
+
 /******************************************************//**
 This function is called, e.g., when a transaction wants to commit. It checks
 that the log has been written to the log file up to the last log entry written
@@ -1515,6 +2249,12 @@ log_write_up_to(
 		return;
 	}
 
+	if (log_sys->concurrent_writes) {
+		log_concurrent_write_up_to(lsn, wait, flush_to_disk, caller);
+
+		return;
+	}
+
 loop:
 #ifdef UNIV_DEBUG
 	loop_count++;
@@ -1726,11 +2466,8 @@ log_buffer_flush_to_disk(void)
 	lsn_t	lsn;
 
 	ut_ad(!srv_read_only_mode);
-	mutex_enter(&(log_sys->mutex));
 
-	lsn = log_sys->lsn;
-
-	mutex_exit(&(log_sys->mutex));
+	lsn = log_get_lsn();
 
 	log_write_up_to(lsn, LOG_WAIT_ALL_GROUPS, TRUE,
 			LOG_WRITE_FROM_BACKGROUND_SYNC);
@@ -1749,11 +2486,7 @@ log_buffer_sync_in_background(
 {
 	lsn_t	lsn;
 
-	mutex_enter(&(log_sys->mutex));
-
-	lsn = log_sys->lsn;
-
-	mutex_exit(&(log_sys->mutex));
+	lsn = log_get_lsn();
 
 	log_write_up_to(lsn, LOG_NO_WAIT, flush,
 			flush ? LOG_WRITE_FROM_BACKGROUND_SYNC :
@@ -3381,6 +4114,9 @@ loop:
 
 	wait_for_buf_lru_manager_to_complete();
 
+	/* The page_cleaner runs its last batches without the workers */
+	buf_flush_page_cleaner_workers_exit();
+
 	/* At this point only page_cleaner should be active. We wait
 	here to let it complete the flushing of the buffer pools
 	before proceeding further. */
@@ -3465,6 +4201,8 @@ loop:
 
 		srv_shutdown_state = SRV_SHUTDOWN_LAST_PHASE;
 
+		log_concurrent_threads_exit();
+
 		fil_close_all_files();
 
 		thread_name = srv_any_background_threads_are_active();
@@ -3483,6 +4221,8 @@ loop:
 	lsn = log_sys->lsn;
 
 	if (lsn != log_sys->last_checkpoint_lsn
+	    || (log_sys->concurrent_writes
+		&& lsn != log_sn_to_lsn(log_sys->sn))
 #ifdef UNIV_LOG_ARCHIVE
 	    || (srv_log_archive_on
 		&& lsn != log_sys->archived_lsn + LOG_BLOCK_HDR_SIZE)
@@ -3542,6 +4282,8 @@ loop:
 
 	srv_shutdown_state = SRV_SHUTDOWN_LAST_PHASE;
 
+	log_concurrent_threads_exit();
+
 	/* Make some checks that the server really is quiet */
 	srv_thread_type	type = srv_get_active_thread_type();
 	ut_a(type == SRV_NONE);
@@ -3639,6 +4381,12 @@ log_peek_lsn(
 /*=========*/
 	lsn_t*	lsn)	/*!< out: if returns TRUE, current lsn is here */
 {
+	if (log_sys->concurrent_writes) {
+		*lsn = log_get_lsn_low();
+
+		return(TRUE);
+	}
+
 	if (0 == mutex_enter_nowait(&(log_sys->mutex))) {
 		*lsn = log_sys->lsn;
 
@@ -3670,7 +4418,7 @@ log_print(
 		"Log flushed up to   " LSN_PF "\n"
 		"Pages flushed up to " LSN_PF "\n"
 		"Last checkpoint at  " LSN_PF "\n",
-		log_sys->lsn,
+		log_get_lsn_low(),
 		log_sys->flushed_to_disk_lsn,
 		log_buf_pool_get_oldest_modification(),
 		log_sys->last_checkpoint_lsn);
@@ -3839,9 +4587,33 @@ log_shutdown(void)
 	os_event_free(log_sys->no_flush_event);
 	os_event_free(log_sys->one_flushed_event);
 
+	if (log_sys->concurrent_writes) {
+		ut_ad(!log_sys->writer_thread_active);
+		ut_ad(!log_sys->flusher_thread_active);
+
+		mem_free(log_sys->write_buf_ptr);
+		log_sys->write_buf_ptr = NULL;
+		log_sys->write_buf = NULL;
+		mem_free(log_sys->recent_written);
+		log_sys->recent_written = NULL;
+
+		for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+			os_event_free(log_sys->write_events[i]);
+			os_event_free(log_sys->flush_events[i]);
+		}
+
+		mem_free(log_sys->write_events);
+		mem_free(log_sys->flush_events);
+		os_event_free(log_sys->writer_event);
+		os_event_free(log_sys->flusher_event);
+
+		log_sys->concurrent_writes = false;
+	}
+
 	rw_lock_free(&log_sys->checkpoint_lock);
 
 	mutex_free(&log_sys->mutex);
+	mutex_free(&log_sys->write_mutex);
 
 #ifdef UNIV_LOG_ARCHIVE
 	rw_lock_free(&log_sys->archive_lock);
@@ -165,6 +165,7 @@ UNIV_INTERN mysql_pfs_key_t	recv_sys_mutex_key;
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
 UNIV_INTERN mysql_pfs_key_t	recv_writer_thread_key;
+UNIV_INTERN mysql_pfs_key_t	recv_apply_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
 # ifdef UNIV_PFS_MUTEX
@@ -207,6 +208,8 @@ recv_sys_create(void)
 #ifndef UNIV_HOTBACKUP
 	mutex_create(recv_writer_mutex_key, &recv_sys->writer_mutex,
 		     SYNC_LEVEL_VARYING);
+
+	recv_sys->apply_event = os_event_create();
 #endif /* !UNIV_HOTBACKUP */
 
 	recv_sys->heap = NULL;
@@ -240,6 +243,9 @@ recv_sys_close(void)
 #ifndef UNIV_HOTBACKUP
 		ut_ad(!recv_writer_thread_active);
 		mutex_free(&recv_sys->writer_mutex);
+
+		ut_ad(recv_sys->n_apply_threads_active == 0);
+		os_event_free(recv_sys->apply_event);
 #endif /* !UNIV_HOTBACKUP */
 
 		mutex_free(&recv_sys->mutex);
@@ -1791,6 +1797,12 @@ recv_recover_page_func(
 	ut_a(recv_sys->n_addrs);
 	recv_sys->n_addrs--;
 
+#ifndef UNIV_HOTBACKUP
+	if (recv_sys->n_addrs == 0) {
+		os_event_set(recv_sys->apply_event);
+	}
+#endif /* !UNIV_HOTBACKUP */
+
 	mutex_exit(&(recv_sys->mutex));
 
 }
@@ -1844,6 +1856,226 @@ recv_read_in_area(
 	return(n);
 }
 
+/*******************************************************************//**
+Applies the hashed log records of a page. If the page is in the buffer
+pool, the records are applied right away; otherwise the page is read in
+together with the pages around it that have log records, and the i/o
+handler applies them when the read completes. The caller must not own
+recv_sys->mutex. */
+static
+void
+recv_apply_page(
+/*============*/
+	ulint	space,	/*!< in: space */
+	ulint	zip_size,/*!< in: compressed page size in bytes, or 0 */
+	ulint	page_no)/*!< in: page number */
+{
+	ut_ad(!mutex_own(&recv_sys->mutex));
+
+	if (buf_page_peek(space, page_no)) {
+		buf_block_t*	block;
+		mtr_t		mtr;
+
+		mtr_start(&mtr);
+
+		block = buf_page_get(space, zip_size, page_no,
+				     RW_X_LATCH, &mtr);
+		buf_block_dbg_add_level(block, SYNC_NO_ORDER_CHECK);
+
+		recv_recover_page(FALSE, block);
+		mtr_commit(&mtr);
+	} else {
+		recv_read_in_area(space, zip_size, page_no);
+	}
+}
+
+/*******************************************************************//**
+Determines which recv_apply_thread applies the log records of a page.
+All the pages of a read-ahead area go to the same thread, so that
+recv_read_in_area() can read them in one batch.
+@return	thread number, less than recv_sys->n_apply_threads */
+UNIV_INLINE
+ulint
+recv_apply_thread_no(
+/*=================*/
+	ulint	space,	/*!< in: space */
+	ulint	page_no)/*!< in: page number */
+{
+	return(ut_fold_ulint_pair(space, page_no / RECV_READ_AHEAD_AREA)
+	       % recv_sys->n_apply_threads);
+}
+
+/******************************************************************//**
+Applies the part of the current apply batch that recv_apply_thread_no()
+assigns to this thread. The hash table is not modified while a batch is
+running, so the threads scan it concurrently, and recv_sys->mutex only
+protects the state of each file address.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: pointer to the thread number */
+{
+	ulint	thread_no = *static_cast<ulint*>(arg);
+	ulint	n_cells;
+	ulint	i;
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&recv_sys->mutex);
+
+	ut_ad(recv_sys->apply_batch_on);
+	ut_ad(thread_no < recv_sys->n_apply_threads);
+
+	n_cells = hash_get_n_cells(recv_sys->addr_hash);
+
+	for (i = 0; i < n_cells; i++) {
+		recv_addr_t*	recv_addr;
+
+		for (recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_FIRST(recv_sys->addr_hash, i));
+		     recv_addr != 0;
+		     recv_addr = static_cast<recv_addr_t*>(
+				HASH_GET_NEXT(addr_hash, recv_addr))) {
+
+			ulint	space = recv_addr->space;
+			ulint	page_no = recv_addr->page_no;
+			ulint	zip_size;
+
+			if (recv_addr->state != RECV_NOT_PROCESSED
+			    || recv_apply_thread_no(space, page_no)
+			    != thread_no) {
+
+				continue;
+			}
+
+			zip_size = fil_space_get_zip_size(space);
+
+			mutex_exit(&recv_sys->mutex);
+
+			recv_apply_page(space, zip_size, page_no);
+
+			mutex_enter(&recv_sys->mutex);
+		}
+	}
+
+	ut_a(recv_sys->n_apply_threads_active > 0);
+	recv_sys->n_apply_threads_active--;
+	os_event_set(recv_sys->apply_event);
+
+	mutex_exit(&recv_sys->mutex);
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*******************************************************************//**
+Applies the hashed log records with srv_n_recv_apply_threads threads,
+partitioned by recv_apply_thread_no(), and waits until all the pages
+have been processed. The caller must own recv_sys->mutex, and it is
+released while waiting.
+@return	TRUE if there were log records to apply */
+static
+ibool
+recv_apply_batch_in_threads(void)
+/*=============================*/
+{
+	ulint*		thread_nos;
+	ulint		n_threads = srv_n_recv_apply_threads;
+	ulint		n_total = recv_sys->n_addrs;
+	ulint		n_printed = 0;
+	ib_time_t	start_time;
+	ulint		i;
+
+	ut_ad(mutex_own(&recv_sys->mutex));
+	ut_ad(recv_sys->apply_batch_on);
+	ut_ad(recv_sys->n_apply_threads_active == 0);
+
+	if (n_total == 0) {
+
+		return(FALSE);
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Starting an apply batch of log records to %lu pages"
+		" with %lu threads...", (ulong) n_total, (ulong) n_threads);
+	fputs("InnoDB: Progress in percent: ", stderr);
+
+	start_time = ut_time();
+
+	thread_nos = static_cast<ulint*>(
+		mem_alloc(n_threads * sizeof *thread_nos));
+
+	recv_sys->n_apply_threads = n_threads;
+	recv_sys->n_apply_threads_active = n_threads;
+
+	for (i = 0; i < n_threads; i++) {
+		thread_nos[i] = i;
+		os_thread_create(recv_apply_thread, thread_nos + i, NULL);
+	}
+
+	/* The pages read in by the threads are applied by the i/o
+	handler threads, so wait for both the threads to finish and
+	all the pages to have been processed */
+
+	while (recv_sys->n_addrs != 0
+	       || recv_sys->n_apply_threads_active != 0) {
+
+		ulint		percent;
+		ib_int64_t	sig_count;
+
+		percent = (n_total - recv_sys->n_addrs) * 100 / n_total;
+
+		for (; n_printed < percent; n_printed++) {
+			fprintf(stderr, "%lu ", (ulong) n_printed);
+		}
+
+		sig_count = os_event_reset(recv_sys->apply_event);
+
+		mutex_exit(&recv_sys->mutex);
+
+		os_event_wait_time_low(recv_sys->apply_event, 100000,
+				       sig_count);
+
+		mutex_enter(&recv_sys->mutex);
+	}
+
+	/* The i/o handler applies the log records of a page read in by
+	recv_read_in_area() before the read completes, so the last pages
+	can still be io-fixed here. Wait for the reads, or the caller
+	could not flush those pages. */
+
+	mutex_exit(&recv_sys->mutex);
+
+	while (buf_get_n_pending_read_ios()) {
+
+		os_thread_sleep(10000);
+	}
+
+	mutex_enter(&recv_sys->mutex);
+
+	for (; n_printed < 100; n_printed++) {
+		fprintf(stderr, "%lu ", (ulong) n_printed);
+	}
+
+	fprintf(stderr, "\n");
+
+	mem_free(thread_nos);
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Applied log records to %lu pages in %.0f seconds",
+		(ulong) n_total, ut_difftime(ut_time(), start_time));
+
+	return(TRUE);
+}
+
 /*******************************************************************//**
 Empties the hash table of stored log records, applying them to appropriate
 pages. */
@@ -1864,7 +2096,6 @@ recv_apply_hashed_log_recs(
 	recv_addr_t* recv_addr;
 	ulint	i;
 	ibool	has_printed	= FALSE;
-	mtr_t	mtr;
 #ifdef XTRABACKUP
 	ulint	last_n_addrs = ULINT_MAX;
 	ulint	loops_since_change = 0;
@@ -1890,6 +2121,12 @@ loop:
 	recv_sys->apply_log_recs = TRUE;
 	recv_sys->apply_batch_on = TRUE;
 
+	if (srv_n_recv_apply_threads > 1) {
+		has_printed = recv_apply_batch_in_threads();
+
+		goto batch_applied;
+	}
+
 	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
 
 		for (recv_addr = static_cast<recv_addr_t*>(
@@ -1915,23 +2152,7 @@ loop:
 
 				mutex_exit(&(recv_sys->mutex));
 
-				if (buf_page_peek(space, page_no)) {
-					buf_block_t*	block;
-
-					mtr_start(&mtr);
-
-					block = buf_page_get(
-						space, zip_size, page_no,
-						RW_X_LATCH, &mtr);
-					buf_block_dbg_add_level(
-						block, SYNC_NO_ORDER_CHECK);
-
-					recv_recover_page(FALSE, block);
-					mtr_commit(&mtr);
-				} else {
-					recv_read_in_area(space, zip_size,
-							  page_no);
-				}
+				recv_apply_page(space, zip_size, page_no);
 
 				mutex_enter(&(recv_sys->mutex));
 			}
@@ -1982,6 +2203,7 @@ loop:
 		fprintf(stderr, "\n");
 	}
 
+batch_applied:
 	if (!allow_ibuf) {
 		bool	success;
 
@@ -229,6 +229,60 @@ mtr_add_dirtied_pages_to_flush_list(
 	}
 }
 
+/************************************************************//**
+Writes the contents of a mini-transaction log to the database log in the
+concurrent write mode, without acquiring the log mutex. */
+static
+void
+mtr_log_reserve_and_write_concurrent(
+/*=================================*/
+	mtr_t*	mtr)	/*!< in/out: mtr */
+{
+	dyn_array_t*	mlog = &(mtr->log);
+	log_handle_t	handle;
+
+	/* The pages which this mtr dirtied must be added to the flush
+	list in the order of the reserved lsn ranges */
+	if (mtr->made_dirty) {
+		log_flush_order_mutex_enter();
+	}
+
+	log_concurrent_reserve(mtr->log_mode == MTR_LOG_ALL
+			       ? dyn_array_get_data_size(mlog) : 0,
+			       &handle);
+
+	mtr->start_lsn = handle.start_lsn;
+	mtr->end_lsn = handle.end_lsn;
+
+	/* The pages stay latched until we have copied the log: they
+	cannot be flushed before that */
+	if (mtr->modifications) {
+		mtr_memo_note_modifications(mtr);
+	}
+
+	if (mtr->made_dirty) {
+		log_flush_order_mutex_exit();
+	}
+
+	if (mtr->log_mode == MTR_LOG_ALL) {
+
+		for (dyn_block_t* block = mlog;
+		     block != 0;
+		     block = dyn_array_get_next_block(mlog, block)) {
+
+			log_concurrent_write(
+				&handle,
+				dyn_block_get_data(block),
+				dyn_block_get_used(block));
+		}
+	} else {
+		ut_ad(mtr->log_mode == MTR_LOG_NONE
+		      || mtr->log_mode == MTR_LOG_NO_REDO);
+	}
+
+	log_concurrent_close(&handle);
+}
+
 /************************************************************//**
 Writes the contents of a mini-transaction log, if any, to the database log. */
 static
@@ -254,6 +308,12 @@ mtr_log_reserve_and_write(
 				     | MLOG_SINGLE_REC_FLAG);
 	}
 
+	if (log_sys->concurrent_writes) {
+		mtr_log_reserve_and_write_concurrent(mtr);
+
+		return;
+	}
+
 	if (mlog->heap == NULL) {
 		ulint	len;
 
@@ -172,6 +172,23 @@ In which order will the views be opened? Should it matter? If no, why?
 
 The order does not matter. No new transactions can be created and no running
 transaction can commit or rollback (or free views).
+
+-------------------------------------------------------------------------------
+FACT D: A view cached by a non-locking autocommit read-only transaction can be
+-------
+reopened without trx_sys->mutex if it is empty and no transaction has been
+assigned a trx id or a serialisation number since it was created.
+PROOF: A closed view stays on trx_sys->view_list until it is either reopened
+by its creator or removed from the list by purge, and the state change that
+decides between the two is done with an atomic compare and swap. A reopened
+view has thus been on the list all the time, and no purge view can be newer
+than it. The view is empty, so no read-write transaction was active when it
+was created. Every read-write transaction is assigned a trx id from
+trx_sys->max_trx_id when it starts, so if trx_sys->max_trx_id is unchanged,
+no read-write transaction has started, and no transaction has committed its
+changes since the view was created. A new view would thus be identical to
+the cached one. Q. E. D.
+-------------------------------------------------------------------------------
 */
 
 /*********************************************************************//**
@@ -192,6 +209,7 @@ read_view_create_low(
 
 	view->n_trx_ids = n;
 	view->trx_ids = (trx_id_t*) &view[1];
+	view->state = VIEW_OPEN;
 
 	return(view);
 }
@@ -273,52 +291,84 @@ read_view_add(
 	ut_ad(read_view_list_validate());
 }
 
-/** Functor to create thew view trx_ids array. */
-struct	CreateView {
+/*********************************************************************//**
+Removes a view closed by a non-locking autocommit read-only transaction from
+trx_sys->view_list, unless the transaction has already reopened it.
+@return	true if the view was removed */
+static
+bool
+read_view_detach_if_closed(
+/*=======================*/
+	read_view_t*	view)	/*!< in/out: view on trx_sys->view_list */
+{
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+#ifdef HAVE_ATOMIC_BUILTINS
+	if (view->state == VIEW_CLOSED
+	    && os_compare_and_swap_ulint(
+		    &view->state, VIEW_CLOSED, VIEW_DETACHED)) {
 
-	CreateView(read_view_t*	view)
-		: m_view(view)
-	{
-		  m_n_trx = m_view->n_trx_ids;
-		  m_view->n_trx_ids = 0;
+		UT_LIST_REMOVE(view_list, trx_sys->view_list, view);
+
+		return(true);
 	}
+#endif /* HAVE_ATOMIC_BUILTINS */
 
-	void	operator()(const trx_t* trx)
-	{
-		ut_ad(mutex_own(&trx_sys->mutex));
-		ut_ad(trx->in_rw_trx_list);
+	return(false);
+}
 
-		/* trx->state cannot change from or to NOT_STARTED
-		while we are holding the trx_sys->mutex. It may change
-		from ACTIVE to PREPARED or COMMITTED. */
+/*********************************************************************//**
+Fills the trx_ids array of a view from trx_sys->descriptors and sets the
+limits of the view. The creator of the view is excluded from the array. */
+static
+void
+read_view_copy_descriptors(
+/*=======================*/
+	read_view_t*	view)	/*!< in/out: view with space for
+				trx_sys->descr_n_used trx ids */
+{
+	const trx_id_t*	descr = trx_sys->descriptors;
+	ulint		n_descr = trx_sys->descr_n_used;
+	ulint		n_ids = 0;
+	const trx_t*	trx;
 
-		if (trx->id != m_view->creator_trx_id
-		    && !trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY)) {
+	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(view->n_trx_ids >= n_descr);
 
-			ut_ad(m_n_trx > m_view->n_trx_ids);
+	/* No future transactions should be visible in the view */
 
-			m_view->trx_ids[m_view->n_trx_ids++] = trx->id;
+	view->low_limit_id = trx_sys->max_trx_id;
 
-			/* NOTE that a transaction whose trx number is <
-			trx_sys->max_trx_id can still be active, if it is
-			in the middle of its commit! Note that when a
-			transaction starts, we initialize trx->no to
-			TRX_ID_MAX. */
+	/* NOTE that a transaction whose trx number is <
+	trx_sys->max_trx_id can still be active, if it is in the middle
+	of its commit! Such transactions are on the serialisation_list,
+	smallest trx number first. */
 
-			/* trx->no is protected by trx_sys->mutex, which
-			we are holding. It is assigned by trx_commit()
-			before lock_trx_release_locks() assigns
-			trx->state = TRX_STATE_COMMITTED_IN_MEMORY. */
+	trx = UT_LIST_GET_FIRST(trx_sys->serialisation_list);
 
-			if (m_view->low_limit_no > trx->no) {
-				m_view->low_limit_no = trx->no;
-			}
+	view->low_limit_no = (trx != NULL) ? trx->no : view->low_limit_id;
+
+	/* No active transaction should be visible, except the creator.
+	The descriptors are in ascending order, the view needs them in
+	descending order. */
+
+	while (n_descr > 0) {
+		trx_id_t	id = descr[--n_descr];
+
+		if (id != view->creator_trx_id) {
+			view->trx_ids[n_ids++] = id;
 		}
 	}
 
-	read_view_t*	m_view;
-	ulint		m_n_trx;
-};
+	view->n_trx_ids = n_ids;
+
+	if (n_ids > 0) {
+		/* The last active transaction has the smallest id: */
+		view->up_limit_id = view->trx_ids[n_ids - 1];
+	} else {
+		view->up_limit_id = view->low_limit_id;
+	}
+}
 
 /*********************************************************************//**
 Opens a read view where exactly the transactions serialized before this
@@ -334,31 +384,16 @@ read_view_open_now_low(
 					allocated */
 {
 	read_view_t*	view;
-	ulint		n_trx = UT_LIST_GET_LEN(trx_sys->rw_trx_list);
 
 	ut_ad(mutex_own(&trx_sys->mutex));
 
-	view = read_view_create_low(n_trx, heap);
+	view = read_view_create_low(trx_sys->descr_n_used, heap);
 
 	view->undo_no = 0;
 	view->type = VIEW_NORMAL;
 	view->creator_trx_id = cr_trx_id;
 
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
-
-	/* No active transaction should be visible, except cr_trx */
-
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
-
-	if (view->n_trx_ids > 0) {
-		/* The last active transaction has the smallest id: */
-		view->up_limit_id = view->trx_ids[view->n_trx_ids - 1];
-	} else {
-		view->up_limit_id = view->low_limit_id;
-	}
+	read_view_copy_descriptors(view);
 
 	/* Purge views are not added to the view list. */
 	if (cr_trx_id > 0) {
@@ -392,6 +427,147 @@ read_view_open_now(
 	return(view);
 }
 
+/*********************************************************************//**
+Frees the read view cached in trx->cached_read_view, if any. The caller
+must own trx_sys->mutex. */
+static
+void
+read_view_free_cached_low(
+/*======================*/
+	trx_t*		trx)	/*!< in/out: transaction */
+{
+	read_view_t*	view = trx->cached_read_view;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	if (view != NULL) {
+
+		trx->cached_read_view = NULL;
+
+		/* Purge detaches closed views only while holding
+		trx_sys->mutex, and only the creator can reopen a
+		closed view. */
+
+		if (view->state != VIEW_DETACHED) {
+			UT_LIST_REMOVE(view_list, trx_sys->view_list, view);
+		}
+
+		mem_heap_empty(trx->global_read_view_heap);
+	}
+}
+
+/*********************************************************************//**
+Frees the read view cached in trx->cached_read_view, if any. */
+UNIV_INTERN
+void
+read_view_free_cached(
+/*==================*/
+	trx_t*		trx)	/*!< in/out: transaction */
+{
+	if (trx->cached_read_view != NULL) {
+
+		mutex_enter(&trx_sys->mutex);
+
+		read_view_free_cached_low(trx);
+
+		mutex_exit(&trx_sys->mutex);
+	}
+}
+
+/*********************************************************************//**
+Opens a read view for a non-locking autocommit read-only transaction. The
+view cached by the previous such transaction of the same trx object is
+reopened without acquiring trx_sys->mutex if it is still an exact snapshot
+of the current state; otherwise a new view is created.
+@return	own: read view struct */
+UNIV_INTERN
+read_view_t*
+read_view_open_for_autocommit(
+/*==========================*/
+	trx_t*		trx)	/*!< in/out: non-locking autocommit
+				read-only transaction */
+{
+	read_view_t*	view;
+
+	ut_ad(trx_is_autocommit_non_locking(trx));
+	ut_ad(trx->global_read_view == NULL);
+
+#ifdef HAVE_ATOMIC_BUILTINS
+	view = trx->cached_read_view;
+
+	/* See FACT D above. The compare and swap acts as a full memory
+	barrier, so that trx_sys->max_trx_id is read after purge can no
+	longer remove the view from the list. */
+
+	if (view != NULL
+	    && os_compare_and_swap_ulint(&view->state, VIEW_CLOSED, VIEW_OPEN)
+	    && view->low_limit_id == trx_sys_get_max_trx_id()) {
+
+		ut_ad(view->n_trx_ids == 0);
+
+		trx->cached_read_view = NULL;
+
+		return(view);
+	}
+#endif /* HAVE_ATOMIC_BUILTINS */
+
+	mutex_enter(&trx_sys->mutex);
+
+	read_view_free_cached_low(trx);
+
+	/* The transaction did not consume a trx id of its own, see
+	trx_start_low(). Use an id that no read-write transaction can
+	have, so that no active transaction is excluded from the view. */
+
+	view = read_view_open_now_low(TRX_ID_MAX, trx->global_read_view_heap);
+
+	mutex_exit(&trx_sys->mutex);
+
+	return(view);
+}
+
+/*********************************************************************//**
+Closes the read view of a non-locking autocommit read-only transaction at
+commit. A view that can be reopened is left on trx_sys->view_list marked
+as VIEW_CLOSED and cached in trx->cached_read_view; other views are
+removed from the list. */
+UNIV_INTERN
+void
+read_view_close_for_autocommit(
+/*===========================*/
+	trx_t*		trx)	/*!< in/out: non-locking autocommit
+				read-only transaction */
+{
+	read_view_t*	view = trx->global_read_view;
+
+	ut_ad(trx_is_autocommit_non_locking(trx));
+
+	if (view == NULL) {
+		return;
+	}
+
+	ut_ad(trx->cached_read_view == NULL);
+	ut_ad(view->state == VIEW_OPEN);
+
+#ifdef HAVE_ATOMIC_BUILTINS
+	if (view->n_trx_ids == 0) {
+
+		/* Only an empty view can be reopened, see FACT D above.
+		Purge removes the view from the list if it becomes the
+		oldest one before it is reopened. */
+
+		view->state = VIEW_CLOSED;
+
+		trx->cached_read_view = view;
+		trx->global_read_view = NULL;
+
+		return;
+	}
+#endif /* HAVE_ATOMIC_BUILTINS */
+
+	read_view_remove(view, false);
+}
+
 /*********************************************************************//**
 Makes a copy of the oldest existing read view, with the exception that also
 the creating trx of the oldest view is set as not visible in the 'copied'
@@ -413,7 +589,13 @@ read_view_purge_open(
 
 	mutex_enter(&trx_sys->mutex);
 
-	oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
+	/* Views closed by non-locking autocommit read-only transactions
+	must not hold back purge. */
+
+	do {
+		oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
+	} while (oldest_view != NULL
+		 && read_view_detach_if_closed(oldest_view));
 
 	if (oldest_view == NULL) {
 
@@ -437,30 +619,43 @@ read_view_purge_open(
 
 	view = (read_view_t*) &oldest_view->trx_ids[oldest_view->n_trx_ids];
 
-	/* Add the creator transaction id in the trx_ids array in the
-	correct slot. */
+	if (creator_trx_id >= oldest_view->low_limit_id) {
 
-	for (i = 0; i < oldest_view->n_trx_ids; ++i) {
-		trx_id_t	id;
+		/* The view was created by a non-locking autocommit
+		read-only transaction, which has not modified anything. */
 
-		id = oldest_view->trx_ids[i - insert_done];
+		view->n_trx_ids = oldest_view->n_trx_ids;
 
-		if (insert_done == 0 && creator_trx_id > id) {
-			id = creator_trx_id;
-			insert_done = 1;
-		}
+		memcpy(view->trx_ids, oldest_view->trx_ids,
+		       view->n_trx_ids * sizeof(*view->trx_ids));
+	} else {
 
-		view->trx_ids[i] = id;
-	}
+		/* Add the creator transaction id in the trx_ids array in
+		the correct slot. */
 
-	if (insert_done == 0) {
-		view->trx_ids[i] = creator_trx_id;
-	} else {
-		ut_a(i > 0);
-		view->trx_ids[i] = oldest_view->trx_ids[i - 1];
+		for (i = 0; i < oldest_view->n_trx_ids; ++i) {
+			trx_id_t	id;
+
+			id = oldest_view->trx_ids[i - insert_done];
+
+			if (insert_done == 0 && creator_trx_id > id) {
+				id = creator_trx_id;
+				insert_done = 1;
+			}
+
+			view->trx_ids[i] = id;
+		}
+
+		if (insert_done == 0) {
+			view->trx_ids[i] = creator_trx_id;
+		} else {
+			ut_a(i > 0);
+			view->trx_ids[i] = oldest_view->trx_ids[i - 1];
+		}
 	}
 
 	view->creator_trx_id = 0;
+	view->state = VIEW_OPEN;
 
 	view->low_limit_no = oldest_view->low_limit_no;
 	view->low_limit_id = oldest_view->low_limit_id;
@@ -546,7 +741,6 @@ read_cursor_view_create_for_mysql(
 {
 	read_view_t*	view;
 	mem_heap_t*	heap;
-	ulint		n_trx;
 	cursor_view_t*	curview;
 
 	/* Use larger heap than in trx_create when creating a read_view
@@ -567,34 +761,20 @@ read_cursor_view_create_for_mysql(
 
 	mutex_enter(&trx_sys->mutex);
 
-	n_trx = UT_LIST_GET_LEN(trx_sys->rw_trx_list);
-
-	curview->read_view = read_view_create_low(n_trx, curview->heap);
+	curview->read_view = read_view_create_low(
+		trx_sys->descr_n_used, curview->heap);
 
 	view = curview->read_view;
 	view->undo_no = cr_trx->undo_no;
 	view->type = VIEW_HIGH_GRANULARITY;
 	view->creator_trx_id = UINT64_UNDEFINED;
 
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
-
-	/* No active transaction should be visible */
+	/* No active transaction should be visible, not even cr_trx */
 
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
+	read_view_copy_descriptors(view);
 
 	view->creator_trx_id = cr_trx->id;
 
-	if (view->n_trx_ids > 0) {
-		/* The last active transaction has the smallest id: */
-
-		view->up_limit_id = view->trx_ids[view->n_trx_ids - 1];
-	} else {
-		view->up_limit_id = view->low_limit_id;
-	}
-
 	read_view_add(view);
 
 	mutex_exit(&trx_sys->mutex);
@@ -1854,7 +1854,7 @@ srv_mon_process_existing_counter(
 		break;
 
 	case MONITOR_OVLD_LSN_CURRENT:
-		value = (mon_type_t) log_sys->lsn;
+		value = (mon_type_t) log_get_lsn_low();
 		break;
 
 	case MONITOR_OVLD_BUF_OLDEST_LSN:
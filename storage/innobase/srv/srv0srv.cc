@@ -195,6 +195,9 @@ UNIV_INTERN ib_uint64_t	srv_log_file_size	= IB_UINT64_MAX;
 UNIV_INTERN ib_uint64_t	srv_log_file_size_requested;
 /* size in database pages */
 UNIV_INTERN ulint	srv_log_buffer_size	= ULINT_MAX;
+/* If TRUE, mini-transactions write the redo log concurrently, and dedicated
+log writer and log flusher threads write and flush it */
+UNIV_INTERN my_bool	srv_log_writer_threads	= FALSE;
 UNIV_INTERN ulong	srv_flush_log_at_trx_commit = 1;
 UNIV_INTERN uint	srv_flush_log_at_timeout = 1;
 UNIV_INTERN ulong	srv_page_size		= UNIV_PAGE_SIZE_DEF;
@@ -230,8 +233,15 @@ UNIV_INTERN my_bool	srv_buf_pool_populate	= FALSE;
 UNIV_INTERN ulint       srv_buf_pool_instances  = 1;
 /* number of locks to protect buf_pool->page_hash */
 UNIV_INTERN ulong	srv_n_page_hash_locks = 16;
+/* whether buf_page_get_gen() looks up resident pages without
+acquiring the page_hash locks */
+UNIV_INTERN my_bool	srv_page_hash_optimistic_lookup = TRUE;
 /** Scan depth for LRU flush batch i.e.: number of blocks scanned*/
 UNIV_INTERN ulong	srv_LRU_scan_depth	= 1024;
+/** Number of threads running the LRU and flush list batches of the
+buffer pool instances: the page_cleaner and lru_manager threads
+coordinate srv_n_page_cleaners - 1 page cleaner workers */
+UNIV_INTERN ulong	srv_n_page_cleaners	= 4;
 /** whether or not to flush neighbors of a block */
 UNIV_INTERN ulong	srv_flush_neighbors	= 1;
 /* previously requested size */
@@ -378,6 +388,9 @@ tasks. The effect is that of srv_force_recovery=SRV_FORCE_NO_BACKGROUND
 without srv_force_recovery=SRV_FORCE_IGNORE_CORRUPT. */
 extern my_bool		xtrabackup_no_background;
 #endif // ifdef XTRABACKUP
+/** Number of threads applying the hashed redo log records during crash
+recovery; if 1, the recovery thread applies them alone */
+UNIV_INTERN ulong	srv_n_recv_apply_threads = 4;
 #ifndef DBUG_OFF
 /** Inject a crash at different steps of the recovery process.
 This is for testing and debugging only. */
@@ -427,6 +440,12 @@ UNIV_INTERN my_bool	srv_print_all_deadlocks = FALSE;
 /** Perform deadlock detection check. */
 UNIV_INTERN my_bool	srv_deadlock_detect = TRUE;
 
+/** Number of shards of the record lock hash table of lock_sys. Record
+lock requests that are granted at once, and the release of the locks at
+commit, only latch the shard of the page; with 1 every lock operation is
+serialized by lock_sys->mutex. */
+UNIV_INTERN ulong	srv_lock_sys_shards = 16;
+
 /** Enable INFORMATION_SCHEMA.innodb_cmp_per_index */
 UNIV_INTERN my_bool	srv_cmp_per_index_enabled = FALSE;
 
@@ -478,6 +497,11 @@ batch flushing i.e.: LRU flushing and flush_list flushing. The rest
 of the pages are used for single page flushing. */
 UNIV_INTERN ulong	srv_doublewrite_batch_size	= 120;
 
+/** If true, batch flushes of each buffer pool instance use their own
+doublewrite file, so that they are not serialized on one doublewrite
+buffer in the system tablespace. */
+UNIV_INTERN my_bool	srv_parallel_doublewrite	= FALSE;
+
 UNIV_INTERN ulong	srv_replication_delay		= 0;
 
 #ifdef XTRABACKUP
@@ -1436,7 +1460,9 @@ srv_printf_innodb_monitor(
 		      "-------------------------------------\n", file);
 		ibuf_print(file);
 
-		ha_print_info(file, btr_search_sys->hash_index);
+		for (ulint i = 0; i < btr_ahi_parts; ++i) {
+			ha_print_info(file, btr_search_sys->hash_tables[i]);
+		}
 
 		fprintf(file,
 			"%.2f hash searches/s, %.2f non-hash searches/s\n",
@@ -1470,6 +1496,8 @@ srv_printf_innodb_monitor(
 			dict_sys->size);
 
 		buf_print_io(file);
+
+		buf_dblwr_print(file);
 	}
 
 	if (status_type.row_operations) {
@@ -1631,7 +1659,7 @@ srv_export_innodb_status(void)
 	ulint			unzip_LRU_len;
 	uint i;
 	ib_uint64_t lsn_oldest = buf_pool_get_oldest_modification();
-	ib_uint64_t lsn_current = log_sys->lsn;
+	ib_uint64_t lsn_current = log_get_lsn_low();
 	ib_uint64_t lsn_gap = lsn_current - lsn_oldest;
 	ib_uint64_t lsn_checkpoint = log_sys->last_checkpoint_lsn;
 
@@ -1889,6 +1889,8 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
 			    + 1 /* buf_flush_page_cleaner_thread */
+			    + srv_n_page_cleaners /* lru_manager and
+						page cleaner workers */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -1906,6 +1908,11 @@ innobase_start_or_create_for_mysql(void)
 		srv_buf_pool_instances = 1;
 	}
 
+	if (srv_n_page_cleaners > srv_buf_pool_instances) {
+		/* A page cleaner per buffer pool instance is enough */
+		srv_n_page_cleaners = srv_buf_pool_instances;
+	}
+
 	/* each buffer pool instance contains at least one chunk unit */
 	if (srv_buf_pool_chunk_unit > 0) {
 		srv_buf_pool_size
@@ -1925,8 +1932,10 @@ innobase_start_or_create_for_mysql(void)
 	btr_defragment_init_mutex();
 
 	ib_logf(IB_LOG_LEVEL_INFO,
-		"%s CPU crc32 instructions",
-		ut_crc32_sse2_enabled ? "Using" : "Not using");
+		"%s CPU crc32 instructions%s",
+		ut_crc32_sse2_enabled ? "Using" : "Not using",
+		ut_crc32_sse2_enabled && ut_crc32_pclmul_enabled
+		? ", with carry-less multiplication" : "");
 
 	mutex_create(srv_monitor_gaplock_query_mutex_key,
 		&srv_monitor_gaplock_query_mutex, SYNC_NO_ORDER_CHECK);
@@ -2471,6 +2480,10 @@ files_checked:
 
 		create_log_files_rename(logfilename, dirnamelen,
 					max_flushed_lsn, logfile0);
+
+		if (srv_log_writer_threads) {
+			log_concurrent_writes_enable();
+		}
 #ifdef UNIV_LOG_ARCHIVE
 	} else if (srv_archive_recovery) {
 
@@ -2690,6 +2703,12 @@ files_checked:
 						max_flushed_lsn, logfile0);
 		}
 
+		/* Switch the redo log to concurrent writes before the
+		rollback of recovered transactions can generate any */
+		if (srv_log_writer_threads && !srv_read_only_mode) {
+			log_concurrent_writes_enable();
+		}
+
 		srv_startup_is_before_trx_rollback_phase = FALSE;
 		recv_recovery_rollback_active();
 
@@ -2851,6 +2870,8 @@ files_checked:
 		purge_sys->state = PURGE_STATE_DISABLED;
 	}
 
+	buf_flush_page_cleaner_init();
+
 	if (!srv_read_only_mode) {
 		os_thread_create(buf_flush_page_cleaner_thread, NULL, NULL);
 	}
@@ -3198,6 +3219,8 @@ innobase_shutdown_for_mysql(void)
 
 	buf_pool_free_resized_event();
 
+	buf_flush_page_cleaner_close();
+
 	/* This must be disabled before closing the buffer pool
 	and closing the data dictionary.  */
 	btr_search_disable();
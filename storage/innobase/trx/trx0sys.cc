@@ -633,6 +633,14 @@ trx_sys_create(void)
 
 	mutex_create(trx_sys_mutex_key, &trx_sys->mutex, SYNC_TRX_SYS);
 	mutex_create(trx_sys_mutex_key, &trx_sys->trx_memory_mutex, SYNC_TRX);
+
+	trx_sys->descr_n_max = TRX_DESCR_ARRAY_INITIAL_SIZE;
+	trx_sys->descr_n_used = 0;
+	trx_sys->descriptors = static_cast<trx_id_t*>(
+		ut_malloc(trx_sys->descr_n_max
+			  * sizeof(*trx_sys->descriptors)));
+
+	UT_LIST_INIT(trx_sys->serialisation_list);
 }
 
 /*****************************************************************//**
@@ -1272,10 +1280,14 @@ trx_sys_close(void)
 	ut_a(UT_LIST_GET_LEN(trx_sys->ro_trx_list) == 0);
 	ut_a(UT_LIST_GET_LEN(trx_sys->rw_trx_list) == 0);
 	ut_a(UT_LIST_GET_LEN(trx_sys->mysql_trx_list) == 0);
+	ut_a(UT_LIST_GET_LEN(trx_sys->serialisation_list) == 0);
+	ut_a(trx_sys->descr_n_used == 0);
 #ifdef XTRABACKUP
 	}
 #endif /* XTRABACKUP */
 
+	ut_free(trx_sys->descriptors);
+
 	mutex_free(&trx_sys->mutex);
 	mutex_free(&trx_sys->trx_memory_mutex);
 
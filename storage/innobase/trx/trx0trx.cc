@@ -517,6 +517,8 @@ trx_free(
 
 	ut_a(UT_LIST_GET_LEN(trx->lock.trx_locks) == 0);
 
+	read_view_free_cached(trx);
+
 	if (trx->global_read_view_heap) {
 		mem_heap_free(trx->global_read_view_heap);
 	}
@@ -629,6 +631,93 @@ trx_free_for_mysql(
 	trx_free_for_background(trx);
 }
 
+/****************************************************************//**
+Adds the id of a read-write transaction to trx_sys->descriptors. The caller
+must own trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_reserve_descriptor(
+/*===================*/
+	const trx_t*	trx)	/*!< in: transaction */
+{
+	trx_id_t*	descr;
+	ulint		i;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(!trx->read_only);
+
+	if (trx_sys->descr_n_used == trx_sys->descr_n_max) {
+
+		trx_sys->descr_n_max *= 2;
+
+		trx_sys->descriptors = static_cast<trx_id_t*>(
+			ut_realloc(trx_sys->descriptors,
+				   trx_sys->descr_n_max
+				   * sizeof(*trx_sys->descriptors)));
+	}
+
+	descr = trx_sys->descriptors;
+
+	/* A transaction started by trx_start_low() has the biggest id
+	assigned so far, so that the loop below terminates immediately
+	for it. */
+
+	for (i = trx_sys->descr_n_used; i > 0 && descr[i - 1] > trx->id; --i) {
+		descr[i] = descr[i - 1];
+	}
+
+	ut_ad(i == 0 || descr[i - 1] < trx->id);
+
+	descr[i] = trx->id;
+
+	++trx_sys->descr_n_used;
+}
+
+/****************************************************************//**
+Removes the id of a read-write transaction from trx_sys->descriptors and
+the transaction from trx_sys->serialisation_list. The caller must own
+trx_sys->mutex. */
+UNIV_INTERN
+void
+trx_release_descriptor(
+/*===================*/
+	trx_t*	trx)	/*!< in/out: transaction */
+{
+	trx_id_t*	descr;
+	ulint		lower;
+	ulint		upper;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+	ut_ad(!trx->read_only);
+
+	descr = trx_sys->descriptors;
+	lower = 0;
+	upper = trx_sys->descr_n_used;
+
+	while (lower < upper) {
+		ulint	mid = (lower + upper) >> 1;
+
+		if (descr[mid] < trx->id) {
+			lower = mid + 1;
+		} else {
+			upper = mid;
+		}
+	}
+
+	ut_a(lower < trx_sys->descr_n_used);
+	ut_a(descr[lower] == trx->id);
+
+	--trx_sys->descr_n_used;
+
+	memmove(descr + lower, descr + lower + 1,
+		(trx_sys->descr_n_used - lower) * sizeof(*descr));
+
+	if (trx->in_serialisation_list) {
+		UT_LIST_REMOVE(no_list, trx_sys->serialisation_list, trx);
+		trx->in_serialisation_list = FALSE;
+	}
+}
+
 /****************************************************************//**
 Inserts the trx handle in the trx system trx list in the right position.
 The list is sorted on the trx id so that the biggest id is at the list
@@ -1030,6 +1119,24 @@ trx_lists_init_at_db_start(void)
 			trx_resurrect_table_locks(trx, undo);
 		}
 	}
+
+	/* Create the descriptors of the recovered transactions that are
+	not committed. The state of a transaction can still change while
+	its update undo logs are being resurrected, therefore this is done
+	only after all the undo log lists have been scanned. */
+
+	mutex_enter(&trx_sys->mutex);
+
+	for (trx_t* trx = UT_LIST_GET_LAST(trx_sys->rw_trx_list);
+	     trx != NULL;
+	     trx = UT_LIST_GET_PREV(trx_list, trx)) {
+
+		if (!trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY)) {
+			trx_reserve_descriptor(trx);
+		}
+	}
+
+	mutex_exit(&trx_sys->mutex);
 }
 
 /******************************************************************//**
@@ -1166,48 +1273,67 @@ trx_start_low(
 	ut_a(ib_vector_is_empty(trx->autoinc_locks));
 	ut_a(ib_vector_is_empty(trx->lock.table_locks));
 
-	mutex_enter(&trx_sys->mutex);
+	ut_ad(!trx->in_rw_trx_list);
+	ut_ad(!trx->in_ro_trx_list);
+
+	if (trx_is_autocommit_non_locking(trx)) {
 
-	/* If this transaction came from trx_allocate_for_mysql(),
-	trx->in_mysql_trx_list would hold. In that case, the trx->state
-	change must be protected by the trx_sys->mutex, so that
-	lock_print_info_all_transactions() will have a consistent view. */
+		/* A non-locking autocommit read-only transaction is not
+		put on any trx_sys list and never writes an undo log, so it
+		does not consume a trx id of its own. It is given the current
+		value of the trx id counter, which keeps the query cache check
+		in row_search_check_if_query_cache_permitted() working, and it
+		is started without acquiring trx_sys->mutex. As in
+		trx_commit_in_memory(), the state change of this kind of
+		transaction is not protected by any mutex. */
 
-	trx->state = TRX_STATE_ACTIVE;
+		ut_ad(trx->read_only);
 
-	trx->id = trx_sys_get_new_trx_id();
+		trx->id = trx_sys_get_max_trx_id();
 
-	ut_ad(!trx->in_rw_trx_list);
-	ut_ad(!trx->in_ro_trx_list);
+		trx->state = TRX_STATE_ACTIVE;
+	} else {
+		mutex_enter(&trx_sys->mutex);
+
+		/* If this transaction came from trx_allocate_for_mysql(),
+		trx->in_mysql_trx_list would hold. In that case, the
+		trx->state change must be protected by the trx_sys->mutex,
+		so that lock_print_info_all_transactions() will have a
+		consistent view. */
+
+		trx->state = TRX_STATE_ACTIVE;
 
-	if (trx->read_only) {
+		trx->id = trx_sys_get_new_trx_id();
 
-		/* Note: The trx_sys_t::ro_trx_list doesn't really need to
-		be ordered, we should exploit this using a list type that
-		doesn't need a list wide lock to increase concurrency. */
+		if (trx->read_only) {
+
+			/* Note: The trx_sys_t::ro_trx_list doesn't really
+			need to be ordered, we should exploit this using a
+			list type that doesn't need a list wide lock to
+			increase concurrency. */
 
-		if (!trx_is_autocommit_non_locking(trx)) {
 			UT_LIST_ADD_FIRST(trx_list, trx_sys->ro_trx_list, trx);
 			ut_d(trx->in_ro_trx_list = TRUE);
-		}
-	} else {
+		} else {
+
+			ut_ad(trx->rseg != NULL
+			      || srv_force_recovery >= SRV_FORCE_NO_TRX_UNDO);
 
-		ut_ad(trx->rseg != NULL
-		      || srv_force_recovery >= SRV_FORCE_NO_TRX_UNDO);
+			UT_LIST_ADD_FIRST(trx_list, trx_sys->rw_trx_list, trx);
+			ut_d(trx->in_rw_trx_list = TRUE);
 
-		ut_ad(!trx_is_autocommit_non_locking(trx));
-		UT_LIST_ADD_FIRST(trx_list, trx_sys->rw_trx_list, trx);
-		ut_d(trx->in_rw_trx_list = TRUE);
+			trx_reserve_descriptor(trx);
 #ifdef UNIV_DEBUG
-		if (trx->id > trx_sys->rw_max_trx_id) {
-			trx_sys->rw_max_trx_id = trx->id;
-		}
+			if (trx->id > trx_sys->rw_max_trx_id) {
+				trx_sys->rw_max_trx_id = trx->id;
+			}
 #endif /* UNIV_DEBUG */
-	}
+		}
 
-	ut_ad(trx_sys_validate_trx_list());
+		ut_ad(trx_sys_validate_trx_list());
 
-	mutex_exit(&trx_sys->mutex);
+		mutex_exit(&trx_sys->mutex);
+	}
 
 	if (trx->is_primary
 	    && trx->buf_pool_reference == 0) {
@@ -1240,6 +1366,14 @@ trx_serialisation_number_get(
 
 	trx->no = trx_sys_get_new_trx_id();
 
+	/* The serialisation numbers are assigned in ascending order, so
+	the list stays sorted on trx->no. The transaction is removed from
+	the list by trx_release_descriptor(). */
+
+	ut_ad(!trx->in_serialisation_list);
+	UT_LIST_ADD_LAST(no_list, trx_sys->serialisation_list, trx);
+	trx->in_serialisation_list = TRUE;
+
 	/* If the rollack segment is not empty then the
 	new trx_t::no can't be less than any trx_t::no
 	already in the rollback segment. User threads only
@@ -1514,7 +1648,7 @@ trx_commit_in_memory(
 
 		trx->state = TRX_STATE_NOT_STARTED;
 
-		read_view_remove(trx->global_read_view, false);
+		read_view_close_for_autocommit(trx);
 
 		MONITOR_INC(MONITOR_TRX_NL_RO_COMMIT);
 		if(for_commit) {
@@ -1818,14 +1952,19 @@ trx_assign_read_view(
 		return(trx->read_view);
 	}
 
-	if (!trx->read_view) {
+	if (trx_is_autocommit_non_locking(trx)) {
+
+		trx->read_view = read_view_open_for_autocommit(trx);
+	} else {
+
+		read_view_free_cached(trx);
 
 		trx->read_view = read_view_open_now(
 			trx->id, trx->global_read_view_heap);
-
-		trx->global_read_view = trx->read_view;
 	}
 
+	trx->global_read_view = trx->read_view;
+
 	return(trx->read_view);
 }
 
@@ -94,6 +94,27 @@ static ibool		ut_crc32_slice8_table_initialized = FALSE;
 /* Flag that tells whether the CPU supports CRC32 or not */
 UNIV_INTERN bool	ut_crc32_sse2_enabled = false;
 
+/* Flag that tells whether the CPU supports carry-less multiplication
+(PCLMULQDQ) or not */
+UNIV_INTERN bool	ut_crc32_pclmul_enabled = false;
+
+/** Number of bytes in each of the three streams of a long block of
+ut_crc32_sse42(). Buffers of 3 * UT_CRC32_LONG bytes and more are
+processed in long blocks. */
+#define UT_CRC32_LONG	4096
+
+/** Number of bytes in each of the three streams of a short block of
+ut_crc32_sse42() */
+#define UT_CRC32_SHORT	256
+
+/** Constants for shifting the CRC of one stream of a block over the
+streams that follow it. With carry-less multiplication, [0] and [1]
+are x^(8 * n - 33) and x^(16 * n - 33) modulo the CRC polynomial, for
+n = UT_CRC32_LONG or UT_CRC32_SHORT. Otherwise they are x^(8 * n) and
+x^(16 * n), for ut_crc32_multiply(). */
+static ib_uint32_t	ut_crc32_long_shift[2];
+static ib_uint32_t	ut_crc32_short_shift[2];
+
 /********************************************************************//**
 Initializes the table that is used to generate the CRC32 if the CPU does
 not have support for it. */
@@ -127,6 +148,76 @@ ut_crc32_slice8_table_init()
 	ut_crc32_slice8_table_initialized = TRUE;
 }
 
+/********************************************************************//**
+Multiplies two polynomials modulo the CRC-32C polynomial. Both are in
+the bit-reversed representation of the CRC, in which x^0 is the most
+significant bit.
+@return a * b modulo the CRC-32C polynomial */
+static
+ib_uint32_t
+ut_crc32_multiply(
+/*==============*/
+	ib_uint32_t	a,	/*!< in: multiplier */
+	ib_uint32_t	b)	/*!< in: multiplicand */
+{
+	/* bit-reversed poly 0x1EDC6F41 (from SSE42 crc32 instruction) */
+	static const ib_uint32_t	poly = 0x82f63b78;
+	ib_uint32_t			product = 0;
+
+	for (ib_uint32_t m = 1U << 31; m != 0; m >>= 1) {
+		if (a & m) {
+			product ^= b;
+		}
+
+		b = (b & 1) ? (poly ^ (b >> 1)) : (b >> 1);
+	}
+
+	return(product);
+}
+
+/********************************************************************//**
+Computes x^n modulo the CRC-32C polynomial, in the bit-reversed
+representation.
+@return x^n modulo the CRC-32C polynomial */
+static
+ib_uint32_t
+ut_crc32_x_pow(
+/*===========*/
+	ulint	n)	/*!< in: exponent */
+{
+	ib_uint32_t	x_pow = 1U << 31;	/* x^0 */
+	ib_uint32_t	x_pow_2k = 1U << 30;	/* x^(2^k) for k = 0 */
+
+	for (; n != 0; n >>= 1) {
+		if (n & 1) {
+			x_pow = ut_crc32_multiply(x_pow, x_pow_2k);
+		}
+
+		x_pow_2k = ut_crc32_multiply(x_pow_2k, x_pow_2k);
+	}
+
+	return(x_pow);
+}
+
+/********************************************************************//**
+Initializes the constants that ut_crc32_sse42() uses to combine the CRCs
+of the streams of a block. */
+static
+void
+ut_crc32_shift_init()
+/*=================*/
+{
+	/* Carry-less multiplication of two bit-reversed 32-bit
+	polynomials yields their product times x, and the crc32
+	instruction then multiplies it by x^32 while reducing it. */
+	const ulint	bias = ut_crc32_pclmul_enabled ? 33 : 0;
+
+	ut_crc32_long_shift[0] = ut_crc32_x_pow(8 * UT_CRC32_LONG - bias);
+	ut_crc32_long_shift[1] = ut_crc32_x_pow(16 * UT_CRC32_LONG - bias);
+	ut_crc32_short_shift[0] = ut_crc32_x_pow(8 * UT_CRC32_SHORT - bias);
+	ut_crc32_short_shift[1] = ut_crc32_x_pow(16 * UT_CRC32_SHORT - bias);
+}
+
 #if defined(__GNUC__) && defined(__x86_64__)
 /********************************************************************//**
 Fetches CPU info */
@@ -172,6 +263,94 @@ for RHEL4 support (GCC 3 doesn't support this instruction) */
 	asm(".byte 0xf2, 0x48, 0x0f, 0x38, 0xf1, 0x0a" \
 	    : "=c"(crc) : "c"(crc), "d"(buf)); \
 	len -= 8, buf += 8
+
+/********************************************************************//**
+Updates a CRC32 with 8 bytes using the crc32 instruction.
+@return updated CRC */
+UNIV_INLINE
+ib_uint64_t
+ut_crc32_sse42_u64(
+/*===============*/
+	ib_uint64_t	crc,	/*!< in: CRC */
+	ib_uint64_t	data)	/*!< in: 8 bytes of data */
+{
+	asm("crc32q %1, %0" : "+r"(crc) : "rm"(data));
+
+	return(crc);
+}
+
+/********************************************************************//**
+Multiplies the CRC of a stream by x^(8 * n), where n is the number of
+bytes that follow the stream, so that it can be XORed with the CRC of
+those bytes.
+@return shifted CRC */
+UNIV_INLINE
+ib_uint64_t
+ut_crc32_sse42_shift(
+/*=================*/
+	ib_uint64_t	crc,	/*!< in: CRC of the stream */
+	ib_uint32_t	shift)	/*!< in: shift constant for n,
+				see ut_crc32_long_shift */
+{
+	if (!ut_crc32_pclmul_enabled) {
+		return(ut_crc32_multiply((ib_uint32_t) crc, shift));
+	}
+
+	ib_uint64_t	product;
+
+	asm("movq %1, %%xmm0\n\t"
+	    "movq %2, %%xmm1\n\t"
+	    "pclmulqdq $0x00, %%xmm1, %%xmm0\n\t"
+	    "movq %%xmm0, %0"
+	    : "=r"(product)
+	    : "r"(crc), "r"((ib_uint64_t) shift)
+	    : "xmm0", "xmm1");
+
+	return(ut_crc32_sse42_u64(0, product));
+}
+
+/********************************************************************//**
+Updates a CRC32 with blocks of 3 * n bytes using the crc32 instruction.
+Each block is split into three streams of n bytes whose CRCs are computed
+in an interleaved way, because the latency of the crc32 instruction is
+three times its throughput. The CRCs of the streams are then combined by
+shifting the first two over the streams that follow them.
+@return updated CRC */
+UNIV_INLINE
+ib_uint64_t
+ut_crc32_sse42_3way(
+/*================*/
+	ib_uint64_t		crc,	/*!< in: CRC */
+	const byte**		buf,	/*!< in/out: 8-byte aligned data */
+	ulint*			len,	/*!< in/out: data length */
+	ulint			n,	/*!< in: bytes in each stream */
+	const ib_uint32_t*	shift)	/*!< in: shift constants for n */
+{
+	while (*len >= 3 * n) {
+		const ib_uint64_t*	p0 = reinterpret_cast<
+			const ib_uint64_t*>(*buf);
+		const ib_uint64_t*	p1 = p0 + n / 8;
+		const ib_uint64_t*	p2 = p1 + n / 8;
+		ib_uint64_t		crc0 = crc;
+		ib_uint64_t		crc1 = 0;
+		ib_uint64_t		crc2 = 0;
+
+		for (ulint i = 0; i < n / 8; i++) {
+			crc0 = ut_crc32_sse42_u64(crc0, p0[i]);
+			crc1 = ut_crc32_sse42_u64(crc1, p1[i]);
+			crc2 = ut_crc32_sse42_u64(crc2, p2[i]);
+		}
+
+		crc = ut_crc32_sse42_shift(crc0, shift[1])
+			^ ut_crc32_sse42_shift(crc1, shift[0])
+			^ crc2;
+
+		*buf += 3 * n;
+		*len -= 3 * n;
+	}
+
+	return(crc);
+}
 #endif /* defined(__GNUC__) && defined(__x86_64__) */
 
 /********************************************************************//**
@@ -193,6 +372,11 @@ ut_crc32_sse42(
 		ut_crc32_sse42_byte;
 	}
 
+	crc = ut_crc32_sse42_3way(crc, &buf, &len,
+				  UT_CRC32_LONG, ut_crc32_long_shift);
+	crc = ut_crc32_sse42_3way(crc, &buf, &len,
+				  UT_CRC32_SHORT, ut_crc32_short_shift);
+
 	while (len >= 32) {
 		ut_crc32_sse42_quadword;
 		ut_crc32_sse42_quadword;
@@ -305,11 +489,13 @@ ut_crc32_init()
 	*/
 #ifndef UNIV_DEBUG_VALGRIND
 	ut_crc32_sse2_enabled = (features_ecx >> 20) & 1;
+	ut_crc32_pclmul_enabled = (features_ecx >> 1) & 1;
 #endif /* UNIV_DEBUG_VALGRIND */
 
 #endif /* defined(__GNUC__) && defined(__x86_64__) */
 
 	if (ut_crc32_sse2_enabled) {
+		ut_crc32_shift_init();
 		ut_crc32 = ut_crc32_sse42;
 	} else {
 		ut_crc32_slice8_table_init();
@@ -4477,6 +4477,13 @@ get_thread_statement_locker_v1(PSI_statement_locker_state *state,
       pfs->m_sort_scan= 0;
       pfs->m_no_index_used= 0;
       pfs->m_no_good_index_used= 0;
+      pfs->m_keys_skipped= 0;
+      pfs->m_deletes_skipped= 0;
+      pfs->m_block_cache_hits= 0;
+      pfs->m_block_reads= 0;
+      pfs->m_bloom_filter_useful= 0;
+      pfs->m_key_comparisons= 0;
+      pfs->m_bytes_read= 0;
       pfs->m_digest_storage.reset();
 
       /* New stages will have this statement as parent */
@@ -4529,6 +4536,13 @@ get_thread_statement_locker_v1(PSI_statement_locker_state *state,
   state->m_sort_scan= 0;
   state->m_no_index_used= 0;
   state->m_no_good_index_used= 0;
+  state->m_keys_skipped= 0;
+  state->m_deletes_skipped= 0;
+  state->m_block_cache_hits= 0;
+  state->m_block_reads= 0;
+  state->m_bloom_filter_useful= 0;
+  state->m_key_comparisons= 0;
+  state->m_bytes_read= 0;
 
   state->m_digest= NULL;
 
@@ -4770,6 +4784,48 @@ static void inc_statement_sort_scan_v1(PSI_statement_locker *locker,
   INC_STATEMENT_ATTR_BODY(locker, m_sort_scan, count);
 }
 
+static void inc_statement_keys_skipped_v1(PSI_statement_locker *locker,
+                                          ulonglong count)
+{
+  INC_STATEMENT_ATTR_BODY(locker, m_keys_skipped, count);
+}
+
+static void inc_statement_deletes_skipped_v1(PSI_statement_locker *locker,
+                                             ulonglong count)
+{
+  INC_STATEMENT_ATTR_BODY(locker, m_deletes_skipped, count);
+}
+
+static void inc_statement_block_cache_hits_v1(PSI_statement_locker *locker,
+                                              ulonglong count)
+{
+  INC_STATEMENT_ATTR_BODY(locker, m_block_cache_hits, count);
+}
+
+static void inc_statement_block_reads_v1(PSI_statement_locker *locker,
+                                         ulonglong count)
+{
+  INC_STATEMENT_ATTR_BODY(locker, m_block_reads, count);
+}
+
+static void inc_statement_bloom_filter_useful_v1(PSI_statement_locker *locker,
+                                                 ulonglong count)
+{
+  INC_STATEMENT_ATTR_BODY(locker, m_bloom_filter_useful, count);
+}
+
+static void inc_statement_key_comparisons_v1(PSI_statement_locker *locker,
+                                             ulonglong count)
+{
+  INC_STATEMENT_ATTR_BODY(locker, m_key_comparisons, count);
+}
+
+static void inc_statement_bytes_read_v1(PSI_statement_locker *locker,
+                                        ulonglong count)
+{
+  INC_STATEMENT_ATTR_BODY(locker, m_bytes_read, count);
+}
+
 static void set_statement_no_index_used_v1(PSI_statement_locker *locker)
 {
   SET_STATEMENT_ATTR_BODY(locker, m_no_index_used, 1);
@@ -5314,6 +5370,13 @@ PSI_v1 PFS_v1=
   pfs_digest_start_v1,
   pfs_digest_end_v1,
   set_thread_connect_attrs_v1,
+  inc_statement_keys_skipped_v1,
+  inc_statement_deletes_skipped_v1,
+  inc_statement_block_cache_hits_v1,
+  inc_statement_block_reads_v1,
+  inc_statement_bloom_filter_useful_v1,
+  inc_statement_key_comparisons_v1,
+  inc_statement_bytes_read_v1,
 };
 
 static void* get_interface(int version)
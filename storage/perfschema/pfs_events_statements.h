@@ -88,6 +88,20 @@ struct PFS_events_statements : public PFS_events
   ulonglong m_no_index_used;
   /** Optimizer metric, number of 'no good index used'. */
   ulonglong m_no_good_index_used;
+  /** Storage engine metric, number of keys skipped. */
+  ulonglong m_keys_skipped;
+  /** Storage engine metric, number of deletes skipped. */
+  ulonglong m_deletes_skipped;
+  /** Storage engine metric, number of block cache hits. */
+  ulonglong m_block_cache_hits;
+  /** Storage engine metric, number of blocks read. */
+  ulonglong m_block_reads;
+  /** Storage engine metric, number of reads a bloom filter avoided. */
+  ulonglong m_bloom_filter_useful;
+  /** Storage engine metric, number of key comparisons. */
+  ulonglong m_key_comparisons;
+  /** Storage engine metric, number of bytes read. */
+  ulonglong m_bytes_read;
 
   /** True if sqltext was truncated. */
   bool m_sqltext_truncated;
@@ -1049,6 +1049,13 @@ PFS_thread* create_thread(PFS_thread_class *klass, const void *identity,
           child_statement->m_sort_scan= 0;
           child_statement->m_no_index_used= 0;
           child_statement->m_no_good_index_used= 0;
+          child_statement->m_keys_skipped= 0;
+          child_statement->m_deletes_skipped= 0;
+          child_statement->m_block_cache_hits= 0;
+          child_statement->m_block_reads= 0;
+          child_statement->m_bloom_filter_useful= 0;
+          child_statement->m_key_comparisons= 0;
+          child_statement->m_bytes_read= 0;
         }
         pfs->m_events_statements_count= 0;
 
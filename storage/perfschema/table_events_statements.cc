@@ -232,12 +232,47 @@ static const TABLE_FIELD_TYPE field_types[]=
     { C_STRING_WITH_LEN("NESTING_EVENT_TYPE") },
     { C_STRING_WITH_LEN("enum(\'STATEMENT\',\'STAGE\',\'WAIT\'") },
     { NULL, 0}
+  },
+  {
+    { C_STRING_WITH_LEN("KEYS_SKIPPED") },
+    { C_STRING_WITH_LEN("bigint") },
+    { NULL, 0}
+  },
+  {
+    { C_STRING_WITH_LEN("DELETES_SKIPPED") },
+    { C_STRING_WITH_LEN("bigint") },
+    { NULL, 0}
+  },
+  {
+    { C_STRING_WITH_LEN("BLOCK_CACHE_HITS") },
+    { C_STRING_WITH_LEN("bigint") },
+    { NULL, 0}
+  },
+  {
+    { C_STRING_WITH_LEN("BLOCK_READS") },
+    { C_STRING_WITH_LEN("bigint") },
+    { NULL, 0}
+  },
+  {
+    { C_STRING_WITH_LEN("BLOOM_FILTER_USEFUL") },
+    { C_STRING_WITH_LEN("bigint") },
+    { NULL, 0}
+  },
+  {
+    { C_STRING_WITH_LEN("KEY_COMPARISONS") },
+    { C_STRING_WITH_LEN("bigint") },
+    { NULL, 0}
+  },
+  {
+    { C_STRING_WITH_LEN("BYTES_READ") },
+    { C_STRING_WITH_LEN("bigint") },
+    { NULL, 0}
   }
 };
 
 TABLE_FIELD_DEF
 table_events_statements_current::m_field_def=
-{40 , field_types };
+{47 , field_types };
 
 PFS_engine_table_share
 table_events_statements_current::m_share=
@@ -406,6 +441,13 @@ void table_events_statements_common::make_row_part_1(PFS_events_statements *stat
   m_row.m_sort_scan= statement->m_sort_scan;
   m_row.m_no_index_used= statement->m_no_index_used;
   m_row.m_no_good_index_used= statement->m_no_good_index_used;
+  m_row.m_keys_skipped= statement->m_keys_skipped;
+  m_row.m_deletes_skipped= statement->m_deletes_skipped;
+  m_row.m_block_cache_hits= statement->m_block_cache_hits;
+  m_row.m_block_reads= statement->m_block_reads;
+  m_row.m_bloom_filter_useful= statement->m_bloom_filter_useful;
+  m_row.m_key_comparisons= statement->m_key_comparisons;
+  m_row.m_bytes_read= statement->m_bytes_read;
   /*
     Making a copy of digest storage.
   */
@@ -630,6 +672,27 @@ int table_events_statements_common::read_row_values(TABLE *table,
         else
           f->set_null();
         break;
+      case 40: /* KEYS_SKIPPED */
+        set_field_ulonglong(f, m_row.m_keys_skipped);
+        break;
+      case 41: /* DELETES_SKIPPED */
+        set_field_ulonglong(f, m_row.m_deletes_skipped);
+        break;
+      case 42: /* BLOCK_CACHE_HITS */
+        set_field_ulonglong(f, m_row.m_block_cache_hits);
+        break;
+      case 43: /* BLOCK_READS */
+        set_field_ulonglong(f, m_row.m_block_reads);
+        break;
+      case 44: /* BLOOM_FILTER_USEFUL */
+        set_field_ulonglong(f, m_row.m_bloom_filter_useful);
+        break;
+      case 45: /* KEY_COMPARISONS */
+        set_field_ulonglong(f, m_row.m_key_comparisons);
+        break;
+      case 46: /* BYTES_READ */
+        set_field_ulonglong(f, m_row.m_bytes_read);
+        break;
       default:
         DBUG_ASSERT(false);
       }
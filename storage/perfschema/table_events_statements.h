@@ -113,6 +113,20 @@ struct row_events_statements
   ulonglong m_no_index_used;
   /** Column NO_GOOD_INDEX_USED. */
   ulonglong m_no_good_index_used;
+  /** Column KEYS_SKIPPED. */
+  ulonglong m_keys_skipped;
+  /** Column DELETES_SKIPPED. */
+  ulonglong m_deletes_skipped;
+  /** Column BLOCK_CACHE_HITS. */
+  ulonglong m_block_cache_hits;
+  /** Column BLOCK_READS. */
+  ulonglong m_block_reads;
+  /** Column BLOOM_FILTER_USEFUL. */
+  ulonglong m_bloom_filter_useful;
+  /** Column KEY_COMPARISONS. */
+  ulonglong m_key_comparisons;
+  /** Column BYTES_READ. */
+  ulonglong m_bytes_read;
 };
 
 /** Position of a cursor on PERFORMANCE_SCHEMA.EVENTS_STATEMENTS_CURRENT. */
@@ -25,11 +25,14 @@
 
 /* C++ standard header files */
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <map>
 #include <queue>
 #include <set>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 /* MySQL includes */
@@ -71,6 +74,7 @@
 #include "./rdb_i_s.h"
 #include "./rdb_index_merge.h"
 #include "./rdb_mutex_wrapper.h"
+#include "./rdb_parallel_scan.h"
 #include "./rdb_psi.h"
 #include "./rdb_threads.h"
 
@@ -110,15 +114,17 @@ const std::string DEFAULT_SYSTEM_CF_NAME("__system__");
 const std::string PER_INDEX_CF_NAME("$per_index_cf");
 
 /**
-  Updates row counters based on the table type and operation type.
+  Updates row counters based on the table type and operation type, for n
+  rows.
 */
-void ha_rocksdb::update_row_stats(const operation_type &type) {
+void ha_rocksdb::update_row_stats(const operation_type &type,
+                                  const ha_rows n) {
   DBUG_ASSERT(type < ROWS_MAX);
   // Find if we are modifying system databases.
   if (table->s && m_tbl_def->m_is_mysql_system_table)
-    global_stats.system_rows[type].inc();
+    global_stats.system_rows[type].add(n);
   else
-    global_stats.rows[type].inc();
+    global_stats.rows[type].add(n);
 }
 
 void dbug_dump_database(rocksdb::DB *db);
@@ -149,6 +155,10 @@ handlerton *rocksdb_hton;
 rocksdb::TransactionDB *rdb = nullptr;
 rocksdb::HistogramImpl *commit_latency_stats = nullptr;
 
+/* Latencies since the last adjustment of the compaction controller */
+static rocksdb::HistogramImpl *commit_latency_window = nullptr;
+static rocksdb::HistogramImpl *read_latency_window = nullptr;
+
 static std::shared_ptr<rocksdb::Statistics> rocksdb_stats;
 static std::unique_ptr<rocksdb::Env> flashcache_aware_env;
 static std::shared_ptr<Rdb_tbl_prop_coll_factory> properties_collector_factory;
@@ -469,6 +479,7 @@ static my_bool rocksdb_force_flush_memtable_now_var = 0;
 static my_bool rocksdb_force_flush_memtable_and_lzero_now_var = 0;
 static my_bool rocksdb_enable_ttl = 1;
 static my_bool rocksdb_enable_ttl_read_filtering = 1;
+static uint32_t rocksdb_drop_expired_ttl_files_period_sec = 0;
 static int rocksdb_debug_ttl_rec_ts = 0;
 static int rocksdb_debug_ttl_snapshot_ts = 0;
 static int rocksdb_debug_ttl_read_filter_ts = 0;
@@ -480,6 +491,12 @@ static uint32_t rocksdb_seconds_between_stat_computes = 3600;
 static long long rocksdb_compaction_sequential_deletes = 0l;
 static long long rocksdb_compaction_sequential_deletes_window = 0l;
 static long long rocksdb_compaction_sequential_deletes_file_size = 0l;
+static ulonglong rocksdb_tombstone_compaction_threshold = 0;
+static uint32_t rocksdb_tombstone_compaction_density = 50;
+static my_bool rocksdb_enable_delete_range_for_truncate = 0;
+static ulonglong rocksdb_compaction_controller_read_latency_us = 0;
+static ulonglong rocksdb_compaction_controller_commit_latency_us = 0;
+static ulonglong rocksdb_compaction_controller_pending_bytes = 32ULL << 30;
 static uint32_t rocksdb_validate_tables = 1;
 static char *rocksdb_datadir;
 static uint32_t rocksdb_table_stats_sampling_pct;
@@ -623,6 +640,13 @@ const size_t RDB_DEFAULT_MERGE_COMBINE_READ_SIZE = 1024 * 1024 * 1024;
 const size_t RDB_MIN_MERGE_COMBINE_READ_SIZE = 100;
 const size_t RDB_DEFAULT_MERGE_TMP_FILE_REMOVAL_DELAY = 0;
 const size_t RDB_MIN_MERGE_TMP_FILE_REMOVAL_DELAY = 0;
+const uint RDB_DEFAULT_INDEX_BUILD_THREADS = 1;
+const uint RDB_MAX_INDEX_BUILD_THREADS = 256;
+const uint RDB_DEFAULT_MRR_BATCH_SIZE = 100;
+const uint RDB_MAX_MRR_BATCH_SIZE = 64 * 1024;
+const uint RDB_DEFAULT_PARALLEL_SCAN_THREADS = 4;
+const uint RDB_MAX_PARALLEL_SCAN_THREADS = 256;
+const uint RDB_PARALLEL_SCAN_RANGES_PER_THREAD = 4;
 const int64 RDB_DEFAULT_BLOCK_CACHE_SIZE = 512 * 1024 * 1024;
 const int64 RDB_MIN_BLOCK_CACHE_SIZE = 1024;
 const int RDB_MAX_CHECKSUMS_PCT = 100;
@@ -698,6 +722,12 @@ static MYSQL_THDVAR_BOOL(skip_bloom_filter_on_read, PLUGIN_VAR_RQCMDARG,
                          "Skip using bloom filter for reads", nullptr, nullptr,
                          FALSE);
 
+static MYSQL_THDVAR_BOOL(
+    skip_write_batch_for_unmodified_indexes, PLUGIN_VAR_RQCMDARG,
+    "Read the indexes which the transaction has not written to without "
+    "merging the transaction's write batch into the iterator",
+    nullptr, nullptr, FALSE);
+
 static MYSQL_THDVAR_ULONG(max_row_locks, PLUGIN_VAR_RQCMDARG,
                           "Maximum number of locks a transaction can have",
                           nullptr, nullptr,
@@ -753,6 +783,32 @@ static MYSQL_THDVAR_ULONGLONG(
     /* min (0ms) */ RDB_MIN_MERGE_TMP_FILE_REMOVAL_DELAY,
     /* max */ SIZE_T_MAX, 1);
 
+static MYSQL_THDVAR_UINT(
+    index_build_threads, PLUGIN_VAR_RQCMDARG,
+    "Maximum number of threads merging and writing the indexes of a table "
+    "to SST files in parallel during inplace index creation and bulk load. "
+    "Each index is written by one thread; 1 writes them one at a time. "
+    "Inplace index creation keeps the merge buffers of that many indexes, "
+    "2 * rocksdb_merge_buf_size + rocksdb_merge_combine_read_size bytes "
+    "each, at once.",
+    nullptr, nullptr, /* default */ RDB_DEFAULT_INDEX_BUILD_THREADS,
+    /* min */ 1, /* max */ RDB_MAX_INDEX_BUILD_THREADS, 0);
+
+static MYSQL_THDVAR_UINT(
+    mrr_batch_size, PLUGIN_VAR_RQCMDARG,
+    "Number of primary keys read with one MultiGet by Multi-Range Read "
+    "scans of secondary indexes.",
+    nullptr, nullptr, /* default */ RDB_DEFAULT_MRR_BATCH_SIZE,
+    /* min */ 1, /* max */ RDB_MAX_MRR_BATCH_SIZE, 0);
+
+static MYSQL_THDVAR_UINT(
+    parallel_scan_threads, PLUGIN_VAR_RQCMDARG,
+    "Number of threads counting the rows of a table for SELECT COUNT(*) "
+    "without a WHERE clause, each one scanning a part of the primary key. "
+    "0 lets the server count the rows one at a time.",
+    nullptr, nullptr, /* default */ RDB_DEFAULT_PARALLEL_SCAN_THREADS,
+    /* min */ 0, /* max */ RDB_MAX_PARALLEL_SCAN_THREADS, 0);
+
 static MYSQL_SYSVAR_BOOL(
     create_if_missing,
     *reinterpret_cast<my_bool *>(&rocksdb_db_options->create_if_missing),
@@ -1305,6 +1361,14 @@ static MYSQL_SYSVAR_BOOL(
     "transactions as they are dropped during compaction. Use with caution.",
     nullptr, nullptr, TRUE);
 
+static MYSQL_SYSVAR_UINT(
+    drop_expired_ttl_files_period_sec,
+    rocksdb_drop_expired_ttl_files_period_sec, PLUGIN_VAR_RQCMDARG,
+    "Number of seconds between the checks for SST files at the bottom of the "
+    "LSM tree where all the rows of the TTL tables have expired, which are "
+    "then deleted without compaction. 0 disables the checks.",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ INT_MAX, 0);
+
 static MYSQL_SYSVAR_INT(
     debug_ttl_rec_ts, rocksdb_debug_ttl_rec_ts, PLUGIN_VAR_RQCMDARG,
     "For debugging purposes only.  Overrides the TTL of records to "
@@ -1429,6 +1493,50 @@ static MYSQL_SYSVAR_BOOL(
     "Counting SingleDelete as rocksdb_compaction_sequential_deletes", nullptr,
     nullptr, rocksdb_compaction_sequential_deletes_count_sd);
 
+static MYSQL_SYSVAR_ULONGLONG(
+    tombstone_compaction_threshold, rocksdb_tombstone_compaction_threshold,
+    PLUGIN_VAR_RQCMDARG,
+    "Number of tombstones the scans of an index must skip before the index "
+    "is checked for compaction. Tombstones are counted when "
+    "rocksdb_perf_context_level is 2 or more. 0 disables the checks.",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ UINT64_MAX, 0);
+
+static MYSQL_SYSVAR_UINT(
+    tombstone_compaction_density, rocksdb_tombstone_compaction_density,
+    PLUGIN_VAR_RQCMDARG,
+    "Percentage of tombstones among the keys visited by the scans of an index "
+    "above which the index is compacted, once "
+    "rocksdb_tombstone_compaction_threshold tombstones have been skipped.",
+    nullptr, nullptr, 50, /* min */ 0, /* max */ 100, 0);
+
+static MYSQL_SYSVAR_BOOL(
+    enable_delete_range_for_truncate, rocksdb_enable_delete_range_for_truncate,
+    PLUGIN_VAR_RQCMDARG,
+    "Remove the rows of a truncated table with one range deletion per index "
+    "instead of one tombstone per row.",
+    nullptr, nullptr, FALSE);
+
+static MYSQL_SYSVAR_ULONGLONG(
+    compaction_controller_read_latency_us,
+    rocksdb_compaction_controller_read_latency_us, PLUGIN_VAR_RQCMDARG,
+    "Target 99th percentile latency of point reads, in microseconds. "
+    "Compactions are slowed down while it is exceeded. 0 disables the target.",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ UINT64_MAX, 0);
+
+static MYSQL_SYSVAR_ULONGLONG(
+    compaction_controller_commit_latency_us,
+    rocksdb_compaction_controller_commit_latency_us, PLUGIN_VAR_RQCMDARG,
+    "Target 99th percentile latency of commits, in microseconds. "
+    "Compactions are slowed down while it is exceeded. 0 disables the target.",
+    nullptr, nullptr, 0, /* min */ 0, /* max */ UINT64_MAX, 0);
+
+static MYSQL_SYSVAR_ULONGLONG(
+    compaction_controller_pending_bytes,
+    rocksdb_compaction_controller_pending_bytes, PLUGIN_VAR_RQCMDARG,
+    "Estimated pending compaction bytes above which compactions are never "
+    "slowed down for the latency targets, to avoid write stalls.",
+    nullptr, nullptr, 32ULL << 30, /* min */ 0, /* max */ UINT64_MAX, 0);
+
 static MYSQL_SYSVAR_BOOL(
     print_snapshot_conflict_queries, rocksdb_print_snapshot_conflict_queries,
     PLUGIN_VAR_RQCMDARG,
@@ -1527,7 +1635,11 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(tmpdir),
     MYSQL_SYSVAR(merge_combine_read_size),
     MYSQL_SYSVAR(merge_tmp_file_removal_delay_ms),
+    MYSQL_SYSVAR(index_build_threads),
+    MYSQL_SYSVAR(mrr_batch_size),
+    MYSQL_SYSVAR(parallel_scan_threads),
     MYSQL_SYSVAR(skip_bloom_filter_on_read),
+    MYSQL_SYSVAR(skip_write_batch_for_unmodified_indexes),
 
     MYSQL_SYSVAR(create_if_missing),
     MYSQL_SYSVAR(two_write_queues),
@@ -1620,6 +1732,7 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(force_flush_memtable_and_lzero_now),
     MYSQL_SYSVAR(enable_ttl),
     MYSQL_SYSVAR(enable_ttl_read_filtering),
+    MYSQL_SYSVAR(drop_expired_ttl_files_period_sec),
     MYSQL_SYSVAR(debug_ttl_rec_ts),
     MYSQL_SYSVAR(debug_ttl_snapshot_ts),
     MYSQL_SYSVAR(debug_ttl_read_filter_ts),
@@ -1632,6 +1745,12 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(compaction_sequential_deletes_window),
     MYSQL_SYSVAR(compaction_sequential_deletes_file_size),
     MYSQL_SYSVAR(compaction_sequential_deletes_count_sd),
+    MYSQL_SYSVAR(tombstone_compaction_threshold),
+    MYSQL_SYSVAR(tombstone_compaction_density),
+    MYSQL_SYSVAR(enable_delete_range_for_truncate),
+    MYSQL_SYSVAR(compaction_controller_read_latency_us),
+    MYSQL_SYSVAR(compaction_controller_commit_latency_us),
+    MYSQL_SYSVAR(compaction_controller_pending_bytes),
     MYSQL_SYSVAR(print_snapshot_conflict_queries),
 
     MYSQL_SYSVAR(datadir),
@@ -1682,6 +1801,10 @@ Rdb_open_tables_map::get_hash_key(Rdb_table_handler *const table_handler,
 
 static Rdb_drop_index_thread rdb_drop_idx_thread;
 
+static Rdb_tombstone_compaction_thread rdb_tombstone_thread;
+
+static Rdb_compaction_controller_thread rdb_controller_thread;
+
 static void rocksdb_drop_index_wakeup_thread(
     my_core::THD *const thd MY_ATTRIBUTE((__unused__)),
     struct st_mysql_sys_var *const var MY_ATTRIBUTE((__unused__)),
@@ -1712,6 +1835,62 @@ static inline uint32_t rocksdb_perf_context_level(THD *const thd) {
   return rocksdb::PerfLevel::kDisable;
 }
 
+/*
+  Returns a filter of the SST files read by an iterator over kd which skips
+  the files where all the rows of kd had expired at snapshot_ts, according
+  to the TTL timestamps collected by Rdb_tbl_prop_coll. Files holding deletes
+  or merges of kd are always read, as they may hide older rows.
+
+  Only implicit TTL is handled: the timestamps are then the write times, so
+  the older versions of the rows in lower levels have expired too. With a TTL
+  column, a row in a lower level may be newer than the one hiding it.
+*/
+static std::function<bool(const rocksdb::TableProperties &)>
+rdb_ttl_table_filter(const Rdb_key_def &kd, const int64_t snapshot_ts) {
+  if (!kd.has_ttl() || !kd.m_ttl_column.empty() || snapshot_ts == 0 ||
+      !rdb_is_ttl_enabled() || !rdb_is_ttl_read_filtering_enabled()) {
+    return nullptr;
+  }
+
+  const GL_INDEX_ID gl_index_id = kd.get_gl_index_id();
+  uint64 ttl_duration = kd.m_ttl_duration;
+#ifndef NDEBUG
+  ttl_duration += rdb_dbug_set_ttl_read_filter_ts();
+#endif
+
+  return [gl_index_id, ttl_duration,
+          snapshot_ts](const rocksdb::TableProperties &props) {
+    std::vector<Rdb_index_ttl_stats> ttl_stats;
+    Rdb_tbl_prop_coll::read_ttl_stats_from_tbl_props(props, &ttl_stats);
+    for (const auto &stats : ttl_stats) {
+      if (stats.m_gl_index_id == gl_index_id) {
+        return stats.m_non_put_entries != 0 ||
+               !stats.all_expired(ttl_duration,
+                                  static_cast<uint64>(snapshot_ts));
+      }
+    }
+    return true;
+  };
+}
+
+/*
+  Returns true if the write batch of a transaction holds any entry of the
+  index kd. An index without entries can be read without merging the write
+  batch into the iterator.
+*/
+static bool rdb_batch_has_index_entries(
+    rocksdb::WriteBatchWithIndex *const batch, const Rdb_key_def &kd) {
+  uchar first_key[Rdb_key_def::INDEX_NUMBER_SIZE];
+  uint first_key_size;
+  kd.get_first_key(first_key, &first_key_size);
+
+  const std::unique_ptr<rocksdb::WBWIIterator> it(
+      batch->NewIterator(kd.get_cf()));
+  it->Seek(rocksdb::Slice(reinterpret_cast<const char *>(first_key),
+                          first_key_size));
+  return it->Valid() && kd.covers_key(it->Entry().key);
+}
+
 /*
   Very short (functor-like) interface to be passed to
   Rdb_transaction::walk_tx_list()
@@ -2032,6 +2211,9 @@ protected:
   virtual void release_snapshot() = 0;
 
   bool has_snapshot() const { return m_read_opts.snapshot != nullptr; }
+  const rocksdb::Snapshot *get_snapshot() const {
+    return m_read_opts.snapshot;
+  }
 
 private:
   // The tables we are currently loading.  In a partitioned table this can
@@ -2141,6 +2323,8 @@ public:
   virtual bool has_modifications() const = 0;
 
   virtual rocksdb::WriteBatchBase *get_indexed_write_batch() = 0;
+  /* Whether the transaction has written any key of the index kd */
+  virtual bool has_index_modifications(const Rdb_key_def &kd) const = 0;
   /*
     Return a WriteBatch that one can write to. The writes will skip any
     transaction locking. The writes will NOT be visible to the transaction.
@@ -2152,6 +2336,14 @@ public:
   virtual rocksdb::Status get(rocksdb::ColumnFamilyHandle *const column_family,
                               const rocksdb::Slice &key,
                               rocksdb::PinnableSlice *const value) const = 0;
+  /*
+    Read several keys of one column family at once. statuses and values get
+    one element per key.
+  */
+  virtual void multi_get(rocksdb::ColumnFamilyHandle *const column_family,
+                         const std::vector<rocksdb::Slice> &keys,
+                         std::vector<std::string> *const values,
+                         std::vector<rocksdb::Status> *const statuses) = 0;
   virtual rocksdb::Status
   get_for_update(rocksdb::ColumnFamilyHandle *const column_family,
                  const rocksdb::Slice &key, rocksdb::PinnableSlice *const value,
@@ -2162,7 +2354,9 @@ public:
                bool skip_bloom_filter, bool fill_cache,
                const rocksdb::Slice &eq_cond_lower_bound,
                const rocksdb::Slice &eq_cond_upper_bound,
-               bool read_current = false, bool create_snapshot = true) {
+               bool read_current = false, bool create_snapshot = true,
+               const Rdb_key_def *const kd = nullptr,
+               bool *const skips_write_batch = nullptr) {
     // Make sure we are not doing both read_current (which implies we don't
     // want a snapshot) and create_snapshot which makes sure we create
     // a snapshot
@@ -2187,6 +2381,27 @@ public:
     options.fill_cache = fill_cache;
     if (read_current) {
       options.snapshot = nullptr;
+    } else if (kd != nullptr) {
+      // Skip the files where all the rows have expired for this snapshot
+      options.table_filter = rdb_ttl_table_filter(*kd, m_snapshot_timestamp);
+
+      /*
+        The write batch of a large transaction makes every iterator slower,
+        as each step compares the keys of the batch and of the database.
+        When the index has no pending writes, read the database directly.
+        The iterator then misses the writes to the index made while it is
+        open, so setup_scan_iterator() re-creates it before reusing it once
+        the index has some.
+      */
+      if (THDVAR(m_thd, skip_write_batch_for_unmodified_indexes) &&
+          has_modifications() && !has_index_modifications(*kd)) {
+        global_stats.queries[QUERIES_RANGE].inc();
+        global_stats.iterators_without_write_batch.inc();
+        if (skips_write_batch != nullptr) {
+          *skips_write_batch = true;
+        }
+        return rdb->NewIterator(options, column_family);
+      }
     }
     return get_iterator(options, column_family);
   }
@@ -2444,6 +2659,10 @@ public:
     return m_rocksdb_tx->GetWriteBatch();
   }
 
+  bool has_index_modifications(const Rdb_key_def &kd) const override {
+    return rdb_batch_has_index_entries(m_rocksdb_tx->GetWriteBatch(), kd);
+  }
+
   rocksdb::Status get(rocksdb::ColumnFamilyHandle *const column_family,
                       const rocksdb::Slice &key,
                       rocksdb::PinnableSlice *const value) const override {
@@ -2455,6 +2674,17 @@ public:
     return m_rocksdb_tx->Get(m_read_opts, column_family, key, value);
   }
 
+  void multi_get(rocksdb::ColumnFamilyHandle *const column_family,
+                 const std::vector<rocksdb::Slice> &keys,
+                 std::vector<std::string> *const values,
+                 std::vector<rocksdb::Status> *const statuses) override {
+    const std::vector<rocksdb::ColumnFamilyHandle *> column_families(
+        keys.size(), column_family);
+    global_stats.queries[QUERIES_POINT].add(keys.size());
+    *statuses =
+        m_rocksdb_tx->MultiGet(m_read_opts, column_families, keys, values);
+  }
+
   rocksdb::Status
   get_for_update(rocksdb::ColumnFamilyHandle *const column_family,
                  const rocksdb::Slice &key, rocksdb::PinnableSlice *const value,
@@ -2694,6 +2924,10 @@ public:
     return m_batch;
   }
 
+  bool has_index_modifications(const Rdb_key_def &kd) const override {
+    return rdb_batch_has_index_entries(m_batch, kd);
+  }
+
   rocksdb::Status get(rocksdb::ColumnFamilyHandle *const column_family,
                       const rocksdb::Slice &key,
                       rocksdb::PinnableSlice *const value) const override {
@@ -2702,6 +2936,18 @@ public:
                                       value);
   }
 
+  void multi_get(rocksdb::ColumnFamilyHandle *const column_family,
+                 const std::vector<rocksdb::Slice> &keys,
+                 std::vector<std::string> *const values,
+                 std::vector<rocksdb::Status> *const statuses) override {
+    values->resize(keys.size());
+    statuses->resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      (*statuses)[i] = m_batch->GetFromBatchAndDB(
+          rdb, m_read_opts, column_family, keys[i], &(*values)[i]);
+    }
+  }
+
   rocksdb::Status
   get_for_update(rocksdb::ColumnFamilyHandle *const column_family,
                  const rocksdb::Slice &key, rocksdb::PinnableSlice *const value,
@@ -2975,7 +3221,9 @@ static int rocksdb_commit_by_xid(handlerton *const hton, XID *const xid) {
   delete trx;
 
   // `Add()` is implemented in a thread-safe manner.
-  commit_latency_stats->Add(timer.ElapsedNanos() / 1000);
+  const uint64_t commit_latency_us = timer.ElapsedNanos() / 1000;
+  commit_latency_stats->Add(commit_latency_us);
+  commit_latency_window->Add(commit_latency_us);
 
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
@@ -3125,7 +3373,9 @@ static int rocksdb_commit(handlerton *const hton, THD *const thd,
   }
 
   // `Add()` is implemented in a thread-safe manner.
-  commit_latency_stats->Add(timer.ElapsedNanos() / 1000);
+  const uint64_t commit_latency_us = timer.ElapsedNanos() / 1000;
+  commit_latency_stats->Add(commit_latency_us);
+  commit_latency_window->Add(commit_latency_us);
 
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
@@ -3958,9 +4208,15 @@ static int rocksdb_init_func(void *const p) {
   rdb_bg_thread.init(rdb_signal_bg_psi_mutex_key, rdb_signal_bg_psi_cond_key);
   rdb_drop_idx_thread.init(rdb_signal_drop_idx_psi_mutex_key,
                            rdb_signal_drop_idx_psi_cond_key);
+  rdb_tombstone_thread.init(rdb_signal_tombstone_psi_mutex_key,
+                            rdb_signal_tombstone_psi_cond_key);
+  rdb_controller_thread.init(rdb_signal_controller_psi_mutex_key,
+                             rdb_signal_controller_psi_cond_key);
 #else
   rdb_bg_thread.init();
   rdb_drop_idx_thread.init();
+  rdb_tombstone_thread.init();
+  rdb_controller_thread.init();
 #endif
   mysql_mutex_init(rdb_collation_data_mutex_key, &rdb_collation_data_mutex,
                    MY_MUTEX_INIT_FAST);
@@ -4296,6 +4552,20 @@ static int rocksdb_init_func(void *const p) {
     DBUG_RETURN(HA_EXIT_FAILURE);
   }
 
+  err = rdb_tombstone_thread.create_thread(TOMBSTONE_THREAD_NAME
+#ifdef HAVE_PSI_INTERFACE
+                                           ,
+                                           rdb_tombstone_psi_thread_key
+#endif
+                                           );
+  if (err != 0) {
+    sql_print_error(
+        "RocksDB: Couldn't start the tombstone compaction thread: (errno=%d)",
+        err);
+    rdb_open_tables.free_hash();
+    DBUG_RETURN(HA_EXIT_FAILURE);
+  }
+
   rdb_set_collation_exception_list(rocksdb_strict_collation_exceptions);
 
   if (rocksdb_pause_background_work) {
@@ -4326,6 +4596,22 @@ static int rocksdb_init_func(void *const p) {
   // Creating an instance of HistogramImpl should only happen after RocksDB
   // has been successfully initialized.
   commit_latency_stats = new rocksdb::HistogramImpl();
+  commit_latency_window = new rocksdb::HistogramImpl();
+  read_latency_window = new rocksdb::HistogramImpl();
+
+  err = rdb_controller_thread.create_thread(CONTROLLER_THREAD_NAME
+#ifdef HAVE_PSI_INTERFACE
+                                            ,
+                                            rdb_controller_psi_thread_key
+#endif
+                                            );
+  if (err != 0) {
+    sql_print_error(
+        "RocksDB: Couldn't start the compaction controller thread: (errno=%d)",
+        err);
+    rdb_open_tables.free_hash();
+    DBUG_RETURN(HA_EXIT_FAILURE);
+  }
 
   // Construct a list of directories which will be monitored by I/O watchdog
   // to make sure that we won't lose write access to them.
@@ -4361,6 +4647,12 @@ static int rocksdb_done_func(void *const p) {
   // signal the drop index thread to stop
   rdb_drop_idx_thread.signal(true);
 
+  // signal the tombstone compaction thread to stop
+  rdb_tombstone_thread.signal(true);
+
+  // signal the compaction controller thread to stop
+  rdb_controller_thread.signal(true);
+
   // Flush all memtables for not losing data, even if WAL is disabled.
   rocksdb_flush_all_memtables();
 
@@ -4391,6 +4683,24 @@ static int rocksdb_done_func(void *const p) {
     sql_print_error("RocksDB: Couldn't stop the index thread: (errno=%d)", err);
   }
 
+  // Wait for the tombstone compaction thread to finish.
+  err = rdb_tombstone_thread.join();
+  if (err != 0) {
+    // NO_LINT_DEBUG
+    sql_print_error(
+        "RocksDB: Couldn't stop the tombstone compaction thread: (errno=%d)",
+        err);
+  }
+
+  // Wait for the compaction controller thread to finish.
+  err = rdb_controller_thread.join();
+  if (err != 0) {
+    // NO_LINT_DEBUG
+    sql_print_error(
+        "RocksDB: Couldn't stop the compaction controller thread: (errno=%d)",
+        err);
+  }
+
   if (rdb_open_tables.m_hash.records) {
     // Looks like we are getting unloaded and yet we have some open tables
     // left behind.
@@ -4423,6 +4733,12 @@ static int rocksdb_done_func(void *const p) {
   delete commit_latency_stats;
   commit_latency_stats = nullptr;
 
+  delete commit_latency_window;
+  commit_latency_window = nullptr;
+
+  delete read_latency_window;
+  read_latency_window = nullptr;
+
   delete io_watchdog;
   io_watchdog = nullptr;
 
@@ -4847,8 +5163,11 @@ static handler *rocksdb_create_handler(my_core::handlerton *const hton,
 ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
                        my_core::TABLE_SHARE *const table_arg)
     : handler(hton, table_arg), m_table_handler(nullptr), m_scan_it(nullptr),
-      m_scan_it_skips_bloom(false), m_scan_it_snapshot(nullptr),
-      m_tbl_def(nullptr), m_pk_descr(nullptr), m_key_descr_arr(nullptr),
+      m_scan_it_skips_bloom(false), m_scan_it_skips_write_batch(false),
+      m_scan_it_snapshot(nullptr),
+      m_scan_it_kd(nullptr), m_scan_it_deletes_skipped(0),
+      m_scan_it_rows_read(0), m_tbl_def(nullptr), m_pk_descr(nullptr),
+      m_key_descr_arr(nullptr),
       m_pk_can_be_decoded(false), m_maybe_unpack_info(false),
       m_pk_tuple(nullptr), m_pk_packed_tuple(nullptr),
       m_sk_packed_tuple(nullptr), m_end_key_packed_tuple(nullptr),
@@ -4856,7 +5175,8 @@ ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
       m_sk_packed_tuple_old(nullptr), m_dup_sk_packed_tuple(nullptr),
       m_dup_sk_packed_tuple_old(nullptr), m_eq_cond_lower_bound(nullptr),
       m_eq_cond_upper_bound(nullptr), m_pack_buffer(nullptr),
-      m_lock_rows(RDB_LOCK_NONE), m_keyread_only(FALSE),
+      m_mrr_rowids(nullptr), m_mrr_n_rowids(0), m_mrr_elem_size(0),
+      m_mrr_batch_start(0), m_lock_rows(RDB_LOCK_NONE), m_keyread_only(FALSE),
       m_bulk_load_tx(nullptr), m_encoder_arr(nullptr),
       m_row_checksums_checked(0), m_in_rpl_delete_rows(false),
       m_in_rpl_update_rows(false), m_force_skip_unique_check(false) {
@@ -5181,6 +5501,11 @@ int ha_rocksdb::convert_record_to_storage_format(
   skip the fields instead of decoding them, but currently we do decoding.)
     - On index merge as bitmap is cleared during that operation
 
+    NOT NULL fixed-width fields which are stored next to each other, and are
+    also next to each other in the record, are merged into runs which are
+    copied with one memcpy. Primary key parts which are not requested are
+    skipped instead of unpacked.
+
   @seealso
     ha_rocksdb::setup_field_converters()
     ha_rocksdb::convert_record_from_storage_format()
@@ -5188,15 +5513,19 @@ int ha_rocksdb::convert_record_to_storage_format(
 void ha_rocksdb::setup_read_decoders() {
   m_decoders_vect.clear();
   m_key_requested = false;
+  m_pk_parts_to_skip = 0;
 
   int last_useful = 0;
   int skip_size = 0;
 
+  // bitmap is cleared on index merge, but it still needs to decode columns
+  const bool all_requested = m_lock_rows == RDB_LOCK_WRITE ||
+                             m_verify_row_debug_checksums ||
+                             bitmap_is_clear_all(table->read_set);
+
   for (uint i = 0; i < table->s->fields; i++) {
-    // bitmap is cleared on index merge, but it still needs to decode columns
     const bool field_requested =
-        m_lock_rows == RDB_LOCK_WRITE || m_verify_row_debug_checksums ||
-        bitmap_is_clear_all(table->read_set) ||
+        all_requested ||
         bitmap_is_set(table->read_set, table->field[i]->field_index);
 
     // We only need the decoder if the whole record is stored.
@@ -5211,14 +5540,31 @@ void ha_rocksdb::setup_read_decoders() {
 
     if (field_requested) {
       // We will need to decode this field
-      m_decoders_vect.push_back({&m_encoder_arr[i], true, skip_size});
+      const uint rec_offset = table->field[i]->ptr - table->record[0];
+      const bool fixed_width = !m_encoder_arr[i].uses_variable_len_encoding() &&
+                               !m_encoder_arr[i].maybe_null();
+
+      // Extend the run of fixed-width fields decoded just before this one
+      if (fixed_width && skip_size == 0 && !m_decoders_vect.empty()) {
+        READ_FIELD &run = m_decoders_vect.back();
+        if (run.m_run_len != 0 &&
+            run.m_rec_offset + run.m_run_len == rec_offset) {
+          run.m_run_len += m_encoder_arr[i].m_pack_length_in_rec;
+          continue;
+        }
+      }
+
+      m_decoders_vect.push_back(
+          {&m_encoder_arr[i], true, skip_size,
+           fixed_width ? m_encoder_arr[i].m_pack_length_in_rec : 0,
+           rec_offset});
       last_useful = m_decoders_vect.size();
       skip_size = 0;
     } else {
       if (m_encoder_arr[i].uses_variable_len_encoding() ||
           m_encoder_arr[i].maybe_null()) {
         // For variable-length field, we need to read the data and skip it
-        m_decoders_vect.push_back({&m_encoder_arr[i], false, skip_size});
+        m_decoders_vect.push_back({&m_encoder_arr[i], false, skip_size, 0, 0});
         skip_size = 0;
       } else {
         // Fixed-width field can be skipped without looking at it.
@@ -5232,6 +5578,16 @@ void ha_rocksdb::setup_read_decoders() {
   // skipping. Remove them.
   m_decoders_vect.erase(m_decoders_vect.begin() + last_useful,
                         m_decoders_vect.end());
+
+  if (m_key_requested && !all_requested && !has_hidden_pk(table)) {
+    for (uint kp = 0; kp < m_pk_descr->get_key_parts(); kp++) {
+      const Field *const field =
+          m_pk_descr->get_table_field_for_part_no(table, kp);
+      if (!bitmap_is_set(table->read_set, field->field_index)) {
+        m_pk_parts_to_skip |= key_part_map(1) << kp;
+      }
+    }
+  }
 }
 
 #ifndef NDEBUG
@@ -5454,7 +5810,8 @@ int ha_rocksdb::convert_record_from_storage_format(
   if (m_key_requested) {
     err = m_pk_descr->unpack_record(table, buf, &rowkey_slice,
                                     unpack_info ? &unpack_slice : nullptr,
-                                    false /* verify_checksum */);
+                                    false /* verify_checksum */,
+                                    m_pk_parts_to_skip);
   }
 
   if (err != HA_EXIT_SUCCESS) {
@@ -5462,6 +5819,17 @@ int ha_rocksdb::convert_record_from_storage_format(
   }
 
   for (auto it = m_decoders_vect.begin(); it != m_decoders_vect.end(); it++) {
+    /* Run of NOT NULL fixed-width fields, stored as in the record */
+    if (it->m_run_len != 0) {
+      const char *data;
+      if ((it->m_skip && !reader.read(it->m_skip)) ||
+          !(data = reader.read(it->m_run_len))) {
+        return HA_ERR_ROCKSDB_CORRUPT_DATA;
+      }
+      memcpy(buf + it->m_rec_offset, data, it->m_run_len);
+      continue;
+    }
+
     const Rdb_field_encoder *const field_dec = it->m_field_enc;
     const bool decode = it->m_decode;
     const bool isNull =
@@ -7904,7 +8272,15 @@ int ha_rocksdb::get_row_by_rowid(uchar *const buf, const char *const rowid,
 
   if (m_lock_rows == RDB_LOCK_NONE) {
     tx->acquire_snapshot(true);
+
+    // Time the reads which don't wait for locks for the compaction controller
+    const bool time_read = rocksdb_compaction_controller_read_latency_us != 0;
+    rocksdb::StopWatchNano timer(rocksdb::Env::Default(), time_read);
     s = tx->get(m_pk_descr->get_cf(), key_slice, &m_retrieved_record);
+    DBUG_EXECUTE_IF("myrocks_slow_point_read", my_sleep(1000););
+    if (time_read) {
+      read_latency_window->Add(timer.ElapsedNanos() / 1000);
+    }
   } else {
     s = get_for_update(tx, m_pk_descr->get_cf(), key_slice,
                        &m_retrieved_record);
@@ -8829,6 +9205,185 @@ int ha_rocksdb::bulk_load_key(Rdb_transaction *const tx, const Rdb_key_def &kd,
   DBUG_RETURN(res);
 }
 
+/*
+  One index being built: run() merges the sorted runs of the index and
+  writes the keys to SST files, checking for duplicates if the index is
+  unique. The jobs of a table are run in parallel by run_index_build_jobs().
+*/
+struct ha_rocksdb::Rdb_index_build_job {
+  Rdb_index_build_job(Rdb_index_merge *const merge,
+                      const std::string &table_name,
+                      const std::string &index_name,
+                      const Rdb_key_def *const unique_index,
+                      const bool &tracing)
+      : m_merge(merge), m_sst_info(rdb, table_name, index_name,
+                                   merge->get_cf(), *rocksdb_db_options,
+                                   tracing),
+        m_unique_index(unique_index), m_res(HA_EXIT_SUCCESS),
+        m_aborted(false) {
+    m_sst_info.defer_error_msg();
+  }
+
+  Rdb_index_merge *const m_merge;
+  Rdb_sst_info m_sst_info;
+
+  // Index checked for duplicate keys, nullptr if it is not unique
+  const Rdb_key_def *const m_unique_index;
+
+  // Result of the job, and the duplicate key found in m_unique_index
+  int m_res;
+  std::string m_dup_key;
+  // Whether the job was stopped because another index failed
+  bool m_aborted;
+
+  void run(const TABLE *const table_arg, std::atomic<bool> *const abort);
+
+  static void thread_fcn(
+      std::vector<std::unique_ptr<Rdb_index_build_job>> *const jobs,
+      const TABLE *const table_arg, std::atomic<size_t> *const next,
+      std::atomic<bool> *const abort);
+};
+
+void ha_rocksdb::Rdb_index_build_job::run(const TABLE *const table_arg,
+                                          std::atomic<bool> *const abort) {
+  rocksdb::Slice merge_key;
+  rocksdb::Slice merge_val;
+
+  std::vector<uchar> dup_sk_buf;
+  std::vector<uchar> dup_sk_buf_old;
+  struct unique_sk_buf_info sk_info;
+  if (m_unique_index != nullptr) {
+    dup_sk_buf.resize(m_unique_index->max_storage_fmt_length());
+    dup_sk_buf_old.resize(m_unique_index->max_storage_fmt_length());
+    sk_info.dup_sk_buf = dup_sk_buf.data();
+    sk_info.dup_sk_buf_old = dup_sk_buf_old.data();
+  }
+
+  int res;
+  while ((res = m_merge->next(&merge_key, &merge_val)) == 0) {
+    // Another index failed, the whole build is rolled back
+    if (abort->load(std::memory_order_relaxed)) {
+      m_aborted = true;
+      res = HA_ERR_ROCKSDB_BULK_LOAD;
+      break;
+    }
+
+    /* Perform uniqueness check if needed */
+    if (m_unique_index != nullptr &&
+        check_duplicate_sk(table_arg, *m_unique_index, &merge_key,
+                           &sk_info)) {
+      m_dup_key.assign(merge_key.data(), merge_key.size());
+      res = ER_DUP_ENTRY;
+      break;
+    }
+
+    if ((res = m_sst_info.put(merge_key, merge_val)) != 0) {
+      break;
+    }
+  }
+
+  // res == -1 => finished ok; res > 0 => error
+  if (res > 0) {
+    // The SST file being written is not added to the index
+    m_sst_info.abort();
+    m_res = res;
+  } else {
+    m_res = m_sst_info.commit();
+  }
+
+  if (m_res != HA_EXIT_SUCCESS) {
+    abort->store(true);
+  }
+}
+
+void ha_rocksdb::Rdb_index_build_job::thread_fcn(
+    std::vector<std::unique_ptr<Rdb_index_build_job>> *const jobs,
+    const TABLE *const table_arg, std::atomic<size_t> *const next,
+    std::atomic<bool> *const abort) {
+  size_t i;
+  while ((i = next->fetch_add(1)) < jobs->size()) {
+    (*jobs)[i]->run(table_arg, abort);
+  }
+}
+
+/**
+  Run the index build jobs of a table on up to rocksdb_index_build_threads
+  threads, the calling thread included, and report the first error to the
+  client.
+
+  @param jobs                One job per index
+  @param table_arg           Table for the duplicate key error messages of
+                             the unique indexes, nullptr if there are none
+  @param print_client_error  Whether the SST errors are sent to the client
+*/
+int ha_rocksdb::run_index_build_jobs(
+    std::vector<std::unique_ptr<Rdb_index_build_job>> *const jobs,
+    TABLE *const table_arg, bool print_client_error) {
+  DBUG_ENTER_FUNC();
+
+  std::atomic<size_t> next(0);
+  std::atomic<bool> abort(false);
+  const size_t n_threads = std::min(
+      static_cast<size_t>(THDVAR(ha_thd(), index_build_threads)),
+      jobs->size());
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < n_threads; i++) {
+    try {
+      threads.emplace_back([&]() {
+        my_thread_init();
+        Rdb_index_build_job::thread_fcn(jobs, table_arg, &next, &abort);
+        my_thread_end();
+      });
+    } catch (const std::system_error &) {
+      // The jobs left over are run by the threads already started
+      break;
+    }
+  }
+
+  Rdb_index_build_job::thread_fcn(jobs, table_arg, &next, &abort);
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // The jobs stopped by the failure of another one do not report an error
+  for (const auto &job : *jobs) {
+    if (job->m_aborted) {
+      continue;
+    }
+
+    if (!job->m_dup_key.empty()) {
+      /*
+        We need to unpack the record into table_arg->record[0] as it is used
+        inside print_keydup_error so that the error message shows the
+        duplicate record.
+      */
+      const rocksdb::Slice dup_key(job->m_dup_key);
+      if (job->m_unique_index->unpack_record(table_arg, table_arg->record[0],
+                                             &dup_key, nullptr,
+                                             m_verify_row_debug_checksums)) {
+        /* Should never reach here */
+        DBUG_ASSERT(0);
+      }
+
+      print_keydup_error(
+          table_arg, &table_arg->key_info[job->m_unique_index->get_keyno()],
+          MYF(0), ha_thd());
+      DBUG_RETURN(ER_DUP_ENTRY);
+    }
+
+    if (job->m_res != HA_EXIT_SUCCESS) {
+      if (print_client_error) {
+        job->m_sst_info.report_error_msg();
+      }
+      DBUG_RETURN(job->m_res);
+    }
+  }
+
+  DBUG_RETURN(abort ? HA_ERR_ROCKSDB_BULK_LOAD : HA_EXIT_SUCCESS);
+}
+
 int ha_rocksdb::finalize_bulk_load(bool print_client_error) {
   DBUG_ENTER_FUNC();
 
@@ -8850,28 +9405,20 @@ int ha_rocksdb::finalize_bulk_load(bool print_client_error) {
   }
 
   if (!m_key_merge.empty()) {
-    rocksdb::Slice merge_key;
-    rocksdb::Slice merge_val;
+    std::vector<std::unique_ptr<Rdb_index_build_job>> jobs;
     for (auto it = m_key_merge.begin(); it != m_key_merge.end(); it++) {
       const std::string &index_name =
           ddl_manager.safe_find(it->first)->get_name();
-      Rdb_index_merge &rdb_merge = it->second;
-      Rdb_sst_info sst_info(rdb, m_table_handler->m_table_name, index_name,
-                            rdb_merge.get_cf(), *rocksdb_db_options,
-                            THDVAR(ha_thd(), trace_sst_api));
+      jobs.emplace_back(new Rdb_index_build_job(
+          &it->second, m_table_handler->m_table_name, index_name, nullptr,
+          THDVAR(ha_thd(), trace_sst_api)));
+    }
 
-      while ((res = rdb_merge.next(&merge_key, &merge_val)) == 0) {
-        if ((res = sst_info.put(merge_key, merge_val)) != 0) {
-          break;
-        }
-      }
-      // res == -1 => finished ok; res > 0 => error
-      if (res <= 0) {
-        if ((res = sst_info.commit(print_client_error)) != 0) {
-          break;
-        }
-      }
+    const int rc = run_index_build_jobs(&jobs, nullptr, print_client_error);
+    if (res == HA_EXIT_SUCCESS) {
+      res = rc;
     }
+
     m_key_merge.clear();
 
     /*
@@ -9225,12 +9772,23 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
     release_scan_iterator();
   }
 
+  /*
+    An iterator which does not merge the write batch misses the writes made
+    since it was created. Re-create it once the transaction has written to
+    the index.
+  */
+  if (m_scan_it != nullptr && m_scan_it_skips_write_batch &&
+      tx->has_index_modifications(kd)) {
+    release_scan_iterator();
+  }
+
   /*
     SQL layer can call rnd_init() multiple times in a row.
     In that case, re-use the iterator, but re-position it at the table start.
   */
   if (!m_scan_it) {
     const bool fill_cache = !THDVAR(ha_thd(), skip_fill_cache);
+    m_scan_it_skips_write_batch = false;
     if (commit_in_the_middle()) {
       DBUG_ASSERT(m_scan_it_snapshot == nullptr);
       m_scan_it_snapshot = rdb->GetSnapshot();
@@ -9242,13 +9800,55 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
     } else {
       m_scan_it = tx->get_iterator(kd.get_cf(), skip_bloom, fill_cache,
                                    m_eq_cond_lower_bound_slice,
-                                   m_eq_cond_upper_bound_slice);
+                                   m_eq_cond_upper_bound_slice,
+                                   /* read_current */ false,
+                                   /* create_snapshot */ true, &kd,
+                                   &m_scan_it_skips_write_batch);
     }
     m_scan_it_skips_bloom = skip_bloom;
+
+    m_scan_it_kd = &kd;
+    m_scan_it_deletes_skipped =
+        rocksdb::get_perf_context()->internal_delete_skipped_count;
+    m_scan_it_rows_read = stats.rows_read;
+  }
+}
+
+/*
+  Add the tombstones skipped and the rows read through m_scan_it to the
+  counts of its index, and queue a compaction of the index when they show
+  that most keys visited by its scans are tombstones. The tombstones are
+  counted by the RocksDB perf context of the session, so nothing is recorded
+  below rocksdb_perf_context_level 2, and a join attributes the tombstones
+  of all its tables to the scan which ends first.
+*/
+void ha_rocksdb::record_scan_tombstones() {
+  const Rdb_key_def *const kd = m_scan_it_kd;
+  m_scan_it_kd = nullptr;
+
+  const ulonglong threshold = rocksdb_tombstone_compaction_threshold;
+  if (kd == nullptr || threshold == 0) {
+    return;
+  }
+
+  // The perf context and the table stats restart with each statement
+  const ulonglong deletes_skipped =
+      rocksdb::get_perf_context()->internal_delete_skipped_count;
+  if (deletes_skipped <= m_scan_it_deletes_skipped ||
+      stats.rows_read < m_scan_it_rows_read) {
+    return;
+  }
+
+  if (kd->record_scan(deletes_skipped - m_scan_it_deletes_skipped,
+                      stats.rows_read - m_scan_it_rows_read, threshold,
+                      rocksdb_tombstone_compaction_density)) {
+    rdb_tombstone_thread.request_compaction(kd->get_gl_index_id());
   }
 }
 
 void ha_rocksdb::release_scan_iterator() {
+  record_scan_tombstones();
+
   delete m_scan_it;
   m_scan_it = nullptr;
 
@@ -9441,6 +10041,7 @@ int ha_rocksdb::rnd_end() {
   DBUG_ENTER_FUNC();
 
   release_scan_iterator();
+  mrr_reset_batch();
 
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
@@ -9485,6 +10086,7 @@ int ha_rocksdb::index_end() {
 
   active_index = MAX_KEY;
   in_range_check_pushed_down = FALSE;
+  m_ds_mrr.dsmrr_close();
 
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
@@ -9794,13 +10396,22 @@ int ha_rocksdb::rnd_pos(uchar *const buf, uchar *const pos) {
 
   ha_statistic_increment(&SSV::ha_read_rnd_count);
   stats.rows_requested++;
-  len = m_pk_descr->key_length(table,
-                               rocksdb::Slice((const char *)pos, ref_length));
-  if (len == size_t(-1)) {
-    DBUG_RETURN(HA_ERR_ROCKSDB_CORRUPT_DATA); /* Data corruption? */
+
+  /* Rows of a DS-MRR scan are read in batches */
+  bool batched = false;
+  if (m_mrr_rowids != nullptr) {
+    rc = mrr_get_row(buf, pos, &batched);
   }
 
-  rc = get_row_by_rowid(buf, pos, len);
+  if (!batched) {
+    len = m_pk_descr->key_length(
+        table, rocksdb::Slice((const char *)pos, ref_length));
+    if (len == size_t(-1)) {
+      DBUG_RETURN(HA_ERR_ROCKSDB_CORRUPT_DATA); /* Data corruption? */
+    }
+
+    rc = get_row_by_rowid(buf, pos, len);
+  }
 
   if (!rc) {
     stats.rows_read++;
@@ -9810,6 +10421,207 @@ int ha_rocksdb::rnd_pos(uchar *const buf, uchar *const pos) {
   DBUG_RETURN(rc);
 }
 
+/*
+  Multi-Range Read
+
+  Secondary index scans that need columns not in the index use DS-MRR: a
+  clone of the handler reads the rowids from the index, DS-MRR sorts them
+  and reads the rows with rnd_pos() in primary key order. The rows are read
+  with one MultiGet per rocksdb_mrr_batch_size rowids instead of one Get per
+  row, see multi_range_read_rowids().
+*/
+
+/*
+  The rowids of DS-MRR are made by position() from an index-only read of the
+  secondary index, so the primary key must be decodable from the index.
+  Reads that lock rows use the default implementation.
+*/
+bool ha_rocksdb::mrr_supported() const {
+  return m_lock_rows == RDB_LOCK_NONE &&
+         (has_hidden_pk(table) || m_pk_can_be_decoded);
+}
+
+int ha_rocksdb::multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
+                                      uint n_ranges, uint mode,
+                                      HANDLER_BUFFER *buf) {
+  mrr_reset_batch();
+
+  if (!mrr_supported()) {
+    mode |= HA_MRR_USE_DEFAULT_IMPL;
+  }
+
+  return m_ds_mrr.dsmrr_init(this, seq, seq_init_param, n_ranges, mode, buf);
+}
+
+int ha_rocksdb::multi_range_read_next(char **range_info) {
+  return m_ds_mrr.dsmrr_next(range_info);
+}
+
+ha_rows ha_rocksdb::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
+                                                void *seq_init_param,
+                                                uint n_ranges, uint *bufsz,
+                                                uint *flags,
+                                                Cost_estimate *cost) {
+  if (!mrr_supported()) {
+    *flags |= HA_MRR_USE_DEFAULT_IMPL;
+  }
+
+  m_ds_mrr.init(this, table);
+  return m_ds_mrr.dsmrr_info_const(keyno, seq, seq_init_param, n_ranges, bufsz,
+                                   flags, cost);
+}
+
+ha_rows ha_rocksdb::multi_range_read_info(uint keyno, uint n_ranges, uint keys,
+                                          uint *bufsz, uint *flags,
+                                          Cost_estimate *cost) {
+  if (!mrr_supported()) {
+    *flags |= HA_MRR_USE_DEFAULT_IMPL;
+  }
+
+  m_ds_mrr.init(this, table);
+  return m_ds_mrr.dsmrr_info(keyno, n_ranges, keys, bufsz, flags, cost);
+}
+
+/*
+  Called by DS-MRR with each buffer of sorted rowids. The rows are read
+  lazily by rnd_pos(), a batch at a time.
+*/
+void ha_rocksdb::multi_range_read_rowids(uchar *rowids, uint n_rowids,
+                                         uint elem_size) {
+  mrr_reset_batch();
+
+  if (mrr_supported()) {
+    m_mrr_rowids = rowids;
+    m_mrr_n_rowids = n_rowids;
+    m_mrr_elem_size = elem_size;
+  }
+}
+
+void ha_rocksdb::mrr_reset_batch() {
+  m_mrr_rowids = nullptr;
+  m_mrr_n_rowids = 0;
+  m_mrr_batch_start = 0;
+  m_mrr_batch_keys.clear();
+  m_mrr_batch_values.clear();
+  m_mrr_batch_status.clear();
+}
+
+/**
+  Read the rows of the rowids of the DS-MRR buffer starting at position
+  first, with one MultiGet.
+
+  @return
+    HA_EXIT_SUCCESS  OK
+    other            HA_ERR error code (can be SE-specific)
+*/
+int ha_rocksdb::mrr_read_batch(const uint first) {
+  DBUG_ASSERT(first < m_mrr_n_rowids);
+
+  const uint n_keys = std::min(THDVAR(table->in_use, mrr_batch_size),
+                               m_mrr_n_rowids - first);
+
+  m_mrr_batch_start = first;
+  m_mrr_batch_keys.clear();
+  m_mrr_batch_values.clear();
+  m_mrr_batch_status.clear();
+
+  for (uint i = 0; i < n_keys; i++) {
+    const char *const rowid = reinterpret_cast<const char *>(
+        m_mrr_rowids + (first + i) * m_mrr_elem_size);
+    const size_t len =
+        m_pk_descr->key_length(table, rocksdb::Slice(rowid, ref_length));
+    if (len == size_t(-1)) {
+      m_mrr_batch_keys.clear();
+      return HA_ERR_ROCKSDB_CORRUPT_DATA; /* Data corruption? */
+    }
+    m_mrr_batch_keys.emplace_back(rowid, len);
+  }
+
+  const std::vector<rocksdb::Slice> keys(m_mrr_batch_keys.begin(),
+                                         m_mrr_batch_keys.end());
+
+  Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+  DBUG_ASSERT(tx != nullptr);
+
+  tx->acquire_snapshot(true);
+  tx->multi_get(m_pk_descr->get_cf(), keys, &m_mrr_batch_values,
+                &m_mrr_batch_status);
+
+  return HA_EXIT_SUCCESS;
+}
+
+/**
+  Read the row of a rowid of the DS-MRR buffer from the batch it belongs to,
+  reading the batch first if needed.
+
+  @param buf      OUT  Record buffer
+  @param pos           Rowid, as passed to rnd_pos()
+  @param batched  OUT  Whether pos is in the DS-MRR buffer; if not, nothing
+                       was read
+
+  @return
+    HA_EXIT_SUCCESS  OK
+    other            HA_ERR error code (can be SE-specific)
+*/
+int ha_rocksdb::mrr_get_row(uchar *const buf, const uchar *const pos,
+                            bool *const batched) {
+  DBUG_ASSERT(m_mrr_rowids != nullptr);
+
+  *batched = false;
+  if (pos < m_mrr_rowids ||
+      pos >= m_mrr_rowids + m_mrr_n_rowids * m_mrr_elem_size ||
+      (pos - m_mrr_rowids) % m_mrr_elem_size != 0) {
+    return HA_EXIT_SUCCESS;
+  }
+
+  *batched = true;
+
+  int rc;
+  const uint n = (pos - m_mrr_rowids) / m_mrr_elem_size;
+  if (n < m_mrr_batch_start ||
+      n >= m_mrr_batch_start + m_mrr_batch_keys.size()) {
+    if ((rc = mrr_read_batch(n))) {
+      return rc;
+    }
+  }
+
+  const uint i = n - m_mrr_batch_start;
+  const rocksdb::Status &s = m_mrr_batch_status[i];
+  const rocksdb::Slice key_slice(m_mrr_batch_keys[i]);
+  DBUG_ASSERT(!memcmp(pos, key_slice.data(), key_slice.size()));
+
+  Rdb_transaction *const tx = get_or_create_tx(table->in_use);
+  if (!s.IsNotFound() && !s.ok()) {
+    return tx->set_status_error(table->in_use, s, *m_pk_descr, m_tbl_def,
+                                m_table_handler);
+  }
+
+  table->status = STATUS_NOT_FOUND;
+  if (s.IsNotFound()) {
+    return HA_ERR_KEY_NOT_FOUND;
+  }
+
+  const rocksdb::Slice value(m_mrr_batch_values[i]);
+
+  /*
+    The batch is read from the primary key directly, so expired rows have not
+    been filtered out by any scan yet. Pretend we didn't find them.
+  */
+  if (m_pk_descr->has_ttl() &&
+      should_hide_ttl_rec(*m_pk_descr, value, tx->m_snapshot_timestamp)) {
+    return HA_ERR_KEY_NOT_FOUND;
+  }
+
+  m_last_rowkey.copy(key_slice.data(), key_slice.size(), &my_charset_bin);
+  rc = convert_record_from_storage_format(&key_slice, &value, buf);
+
+  if (!rc) {
+    table->status = 0;
+  }
+
+  return rc;
+}
+
 /*
   @brief
     Calculate (if needed) the bitmap of indexes that are modified by the
@@ -10251,6 +11063,198 @@ void Rdb_drop_index_thread::run() {
   RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
 }
 
+/*
+  Tombstone compaction thread's main logic
+*/
+
+void Rdb_tombstone_compaction_thread::run() {
+  RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
+
+  for (;;) {
+    while (!m_stop && m_requests.empty()) {
+      mysql_cond_wait(&m_signal_cond, &m_signal_mutex);
+    }
+    if (m_stop) {
+      break;
+    }
+
+    std::unordered_set<GL_INDEX_ID> requests;
+    requests.swap(m_requests);
+    RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
+
+    for (const auto &d : requests) {
+      uint32 cf_flags = 0;
+      rocksdb::ColumnFamilyHandle *const cfh = cf_manager.get_cf(d.cf_id);
+      if (cfh == nullptr || !dict_manager.get_cf_flags(d.cf_id, &cf_flags)) {
+        continue;
+      }
+      const bool is_reverse_cf = cf_flags & Rdb_key_def::REVERSE_CF_FLAG;
+
+      /*
+        Compacting the whole index drops the tombstones along with the rows
+        they delete, so the scans of the index stop skipping them.
+      */
+      uchar buf[Rdb_key_def::INDEX_NUMBER_SIZE * 2];
+      const rocksdb::Range range =
+          get_range(d.index_id, buf, is_reverse_cf ? 1 : 0,
+                    is_reverse_cf ? 0 : 1);
+      const rocksdb::Status status = rdb->CompactRange(
+          getCompactRangeOptions(), cfh, &range.start, &range.limit);
+      if (!status.ok()) {
+        if (status.IsShutdownInProgress()) {
+          break;
+        }
+        /* NO_LINT_DEBUG */
+        sql_print_warning("MyRocks: failed to compact index (%u,%u) to drop "
+                          "its tombstones. Status code = %d, status = %s.",
+                          d.cf_id, d.index_id, status.code(),
+                          status.ToString().c_str());
+        rdb_handle_io_error(status, RDB_IO_ERROR_BG_THREAD);
+        continue;
+      }
+      global_stats.tombstone_compactions.inc();
+    }
+
+    RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
+  }
+
+  RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
+}
+
+/*
+  Compaction controller thread's main logic
+*/
+
+void Rdb_compaction_controller_thread::run() {
+  // How many seconds to wait till adjusting the compactions next time.
+  const int WAKE_UP_INTERVAL = 1;
+
+  RDB_MUTEX_LOCK_CHECK(rdb_sysvars_mutex);
+  m_max_rate_limit = m_rate_limit = rocksdb_rate_limiter_bytes_per_sec;
+  m_max_background_jobs = m_background_jobs =
+      rocksdb_db_options->max_background_jobs;
+  RDB_MUTEX_UNLOCK_CHECK(rdb_sysvars_mutex);
+
+  timespec ts_next_adjust;
+  clock_gettime(CLOCK_REALTIME, &ts_next_adjust);
+  ts_next_adjust.tv_sec += WAKE_UP_INTERVAL;
+
+  for (;;) {
+    RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
+    const auto ret MY_ATTRIBUTE((__unused__)) = mysql_cond_timedwait(
+        &m_signal_cond, &m_signal_mutex, &ts_next_adjust);
+
+    // Check that we receive only the expected error codes.
+    DBUG_ASSERT(ret == 0 || ret == ETIMEDOUT);
+    const bool local_stop = m_stop;
+    RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
+
+    if (local_stop) {
+      break;
+    }
+
+    adjust();
+
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts_next_adjust.tv_sec = ts.tv_sec + WAKE_UP_INTERVAL;
+  }
+}
+
+/*
+  Halve the compaction rate limit and remove one background job when the
+  99th percentile of the reads or of the commits since the last adjustment
+  is above its target, unless the pending compactions are close to stalling
+  the writes. Otherwise give back a tenth of the configured rate limit and
+  one background job, up to rocksdb_rate_limiter_bytes_per_sec and
+  rocksdb_max_background_jobs.
+
+  The configured values are read on every adjustment. When they were
+  changed since the last one, their update functions have applied them,
+  and the controller starts over from them. With both latency targets at 0
+  the controller only gives back what it took away.
+*/
+void Rdb_compaction_controller_thread::adjust() {
+  const ulonglong read_target = rocksdb_compaction_controller_read_latency_us;
+  const ulonglong commit_target =
+      rocksdb_compaction_controller_commit_latency_us;
+  const bool enabled = read_target != 0 || commit_target != 0;
+
+  bool over_target = false;
+  if (read_target != 0 && !read_latency_window->Empty() &&
+      read_latency_window->Percentile(99) > read_target) {
+    over_target = true;
+  }
+  if (commit_target != 0 && !commit_latency_window->Empty() &&
+      commit_latency_window->Percentile(99) > commit_target) {
+    over_target = true;
+  }
+  read_latency_window->Clear();
+  commit_latency_window->Clear();
+
+  if (over_target) {
+    uint64_t pending_bytes = 0;
+    if (rdb->GetAggregatedIntProperty(
+            rocksdb::DB::Properties::kEstimatePendingCompactionBytes,
+            &pending_bytes) &&
+        pending_bytes >= rocksdb_compaction_controller_pending_bytes) {
+      over_target = false;
+    }
+  }
+
+  RDB_MUTEX_LOCK_CHECK(rdb_sysvars_mutex);
+
+  const uint64_t max_rate = rocksdb_rate_limiter_bytes_per_sec;
+  const int max_jobs = rocksdb_db_options->max_background_jobs;
+  if (max_rate != m_max_rate_limit) {
+    m_max_rate_limit = m_rate_limit = max_rate;
+  }
+  if (max_jobs != m_max_background_jobs) {
+    m_max_background_jobs = m_background_jobs = max_jobs;
+  }
+
+  if (!enabled && m_rate_limit == max_rate && m_background_jobs == max_jobs) {
+    RDB_MUTEX_UNLOCK_CHECK(rdb_sysvars_mutex);
+    return;
+  }
+
+  // The rate limiter only exists when it was configured at startup
+  if (rocksdb_rate_limiter != nullptr && max_rate != 0) {
+    const uint64_t min_rate = std::max<uint64_t>(max_rate / 10, 1);
+    const uint64_t old_rate = m_rate_limit;
+    const uint64_t new_rate =
+        !enabled ? max_rate
+                 : over_target ? std::max(old_rate / 2, min_rate)
+                               : std::min(old_rate + min_rate, max_rate);
+    if (new_rate != old_rate) {
+      rocksdb_rate_limiter->SetBytesPerSecond(new_rate);
+      m_rate_limit = new_rate;
+    }
+  }
+
+  // Keep a flush and a compaction running. -1 lets RocksDB pick the jobs.
+  const int min_jobs = std::min(max_jobs, 2);
+  const int old_jobs = m_background_jobs;
+  const int new_jobs = !enabled || max_jobs <= 0
+                           ? max_jobs
+                           : over_target ? std::max(old_jobs - 1, min_jobs)
+                                         : std::min(old_jobs + 1, max_jobs);
+  if (new_jobs != old_jobs) {
+    const rocksdb::Status s =
+        rdb->SetDBOptions({{"max_background_jobs", std::to_string(new_jobs)}});
+    if (s.ok()) {
+      m_background_jobs = new_jobs;
+    } else {
+      /* NO_LINT_DEBUG */
+      sql_print_warning("MyRocks: failed to update max_background_jobs. "
+                        "Status code = %d, status = %s.",
+                        s.code(), s.ToString().c_str());
+    }
+  }
+
+  RDB_MUTEX_UNLOCK_CHECK(rdb_sysvars_mutex);
+}
+
 Rdb_tbl_def *ha_rocksdb::get_table_if_exists(const char *const tablename) {
   DBUG_ASSERT(tablename != nullptr);
 
@@ -10323,8 +11327,26 @@ int ha_rocksdb::remove_rows(Rdb_tbl_def *const tbl) {
   */
   for (uint i = 0; i < tbl->m_key_count; i++) {
     const Rdb_key_def &kd = *tbl->m_key_descr_arr[i];
-    kd.get_infimum_key(reinterpret_cast<uchar *>(key_buf), &key_len);
     rocksdb::ColumnFamilyHandle *cf = kd.get_cf();
+
+    /*
+      One range tombstone covers the whole index, so neither this loop nor
+      the scans which follow have to visit a tombstone per row.
+    */
+    if (rocksdb_enable_delete_range_for_truncate) {
+      uchar buf[Rdb_key_def::INDEX_NUMBER_SIZE * 2];
+      const rocksdb::Range range = myrocks::get_range(kd, buf);
+      const rocksdb::Status s =
+          rdb->GetBaseDB()->DeleteRange(wo, cf, range.start, range.limit);
+      if (!s.ok()) {
+        return tx->set_status_error(table->in_use, s, *m_pk_descr, m_tbl_def,
+                                    m_table_handler);
+      }
+      bytes_written += range.start.size() + range.limit.size();
+      continue;
+    }
+
+    kd.get_infimum_key(reinterpret_cast<uchar *>(key_buf), &key_len);
     const rocksdb::Slice table_key(key_buf, key_len);
     setup_iterator_bounds(kd, table_key);
     opts.iterate_lower_bound = &m_eq_cond_lower_bound_slice;
@@ -10469,6 +11491,77 @@ int ha_rocksdb::extra(enum ha_extra_function operation) {
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
 
+/*
+  Exact number of rows, for SELECT COUNT(*) without a WHERE clause. The
+  primary key is split into ranges which are counted by
+  rocksdb_parallel_scan_threads threads, on the snapshot of the transaction.
+
+  HA_POS_ERROR makes the server count the rows itself. It is returned when
+  the transaction has changes that are not in its snapshot, for locking
+  reads, when an index is forced, and for EXPLAIN, which should not scan
+  the table.
+*/
+ha_rows ha_rocksdb::records() {
+  DBUG_ENTER_FUNC();
+
+  THD *const thd = ha_thd();
+  const uint n_threads = THDVAR(thd, parallel_scan_threads);
+  Rdb_transaction *const tx = get_or_create_tx(thd);
+  DBUG_ASSERT(tx != nullptr);
+
+  if (n_threads == 0 || thd->lex->describe || table->force_index ||
+      m_lock_rows != RDB_LOCK_NONE || tx->has_modifications()) {
+    DBUG_RETURN(HA_POS_ERROR);
+  }
+
+  tx->acquire_snapshot(true);
+
+  const Rdb_key_def &kd = *m_pk_descr;
+  const int64_t snapshot_ts = tx->m_snapshot_timestamp;
+
+  /* Row count of each thread, one cache line apart */
+  struct counter {
+    ha_rows m_rows;
+    char m_pad[CPU_LEVEL1_DCACHE_LINESIZE - sizeof(ha_rows)];
+  };
+  std::vector<counter> counters(n_threads);
+
+  Rdb_parallel_scan scan(rdb, kd, tx->get_snapshot());
+  scan.split(n_threads * RDB_PARALLEL_SCAN_RANGES_PER_THREAD);
+
+  const int rc = scan.scan(
+      n_threads, [&](uint thread_no, const rocksdb::Slice &key,
+                     const rocksdb::Slice &value) {
+        if (my_core::thd_killed(thd)) {
+          return static_cast<int>(HA_ERR_INTERNAL_ERROR);
+        }
+
+        if (!kd.has_ttl() || !should_hide_ttl_rec(kd, value, snapshot_ts)) {
+          counters[thread_no].m_rows++;
+        }
+        return static_cast<int>(HA_EXIT_SUCCESS);
+      });
+
+  /*
+    On a read error or a kill the server scans the table itself, which
+    reports the error.
+  */
+  if (rc != HA_EXIT_SUCCESS) {
+    DBUG_RETURN(HA_POS_ERROR);
+  }
+
+  ha_rows rows = 0;
+  for (const auto &c : counters) {
+    rows += c.m_rows;
+  }
+
+  stats.rows_read += rows;
+  stats.rows_index_next += rows;
+  update_row_stats(ROWS_READ, rows);
+
+  DBUG_RETURN(rows);
+}
+
 /*
   Given a starting key and an ending key, estimate the number of rows that
   will exist between the two keys.
@@ -10542,12 +11635,55 @@ ha_rows ha_rocksdb::records_in_range(uint inx, key_range *const min_key,
     disk_size = ROCKSDB_ASSUMED_KEY_VALUE_DISK_SIZE;
   }
 
+  const auto histogram = ddl_manager.get_histogram(kd);
+  const int64_t hist_rows = histogram ? histogram->total_rows() : 0;
+  /*
+    Files written before the histograms were collected have none, so the
+    histogram may only cover the files written since. Only use it when it
+    covers most of the rows of the index.
+  */
+  if (hist_rows > 0 && hist_rows * 10 >= kd.m_stats.m_rows * 9) {
+    /*
+      Estimate from the keys sampled by the properties collector, without
+      reading the SST files. When both ends of the range have the same values
+      for the first key parts, the range gets no more than the rows per key of
+      that prefix.
+    */
+    const int64_t table_rows =
+        kd.m_stats.m_rows > 0 ? kd.m_stats.m_rows : hist_rows;
+    double est = histogram->rows_in_range(slice1, slice2) * table_rows /
+                 hist_rows;
+    if (min_key && max_key) {
+      const KEY &key_info = table->key_info[inx];
+      uint parts = 0;
+      uint offset = 0;
+      while (parts < key_info.actual_key_parts &&
+             (min_key->keypart_map & max_key->keypart_map & (1 << parts))) {
+        const uint len = key_info.key_part[parts].store_length;
+        if (offset + len > min_key->length || offset + len > max_key->length ||
+            memcmp(min_key->key + offset, max_key->key + offset, len)) {
+          break;
+        }
+        offset += len;
+        parts++;
+      }
+      const auto &distinct = kd.m_stats.m_distinct_keys_per_prefix;
+      if (parts > 0 && parts <= distinct.size() && distinct[parts - 1] > 0) {
+        est = std::min(est, static_cast<double>(table_rows) /
+                                distinct[parts - 1]);
+      }
+    }
+    ret = static_cast<ha_rows>(est);
+  } else {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-  // Getting statistics, including from Memtables
-  uint8_t include_flags = rocksdb::DB::INCLUDE_FILES;
-  rdb->GetApproximateSizes(kd.get_cf(), &r, 1, &sz, include_flags);
-  ret = rows * sz / disk_size;
+    // Getting statistics from the SST files
+    uint8_t include_flags = rocksdb::DB::INCLUDE_FILES;
+    rdb->GetApproximateSizes(kd.get_cf(), &r, 1, &sz, include_flags);
+    ret = rows * sz / disk_size;
+  }
+
+  // Getting statistics from Memtables
   uint64_t memTableCount;
   rdb->GetApproximateMemTableStats(kd.get_cf(), r, &memTableCount, &sz);
   ret += memTableCount;
@@ -11310,16 +12446,37 @@ int ha_rocksdb::inplace_populate_sk(
   const ulonglong rdb_merge_tmp_file_removal_delay =
       THDVAR(ha_thd(), merge_tmp_file_removal_delay_ms);
 
-  for (const auto &index : indexes) {
-    bool is_unique_index =
-        new_table_arg->key_info[index->get_keyno()].flags & HA_NOSAME;
+  /*
+    The primary key is scanned once per pass over the new indexes: each row is
+    added to the sort buffers of every index of the pass, and the indexes are
+    then merged and written to SST files in parallel. A pass builds up to
+    rocksdb_index_build_threads indexes, so that no more than that many sort
+    buffers of rocksdb_merge_buf_size are allocated at once.
+  */
+  const std::vector<std::shared_ptr<Rdb_key_def>> all_index_defs(
+      indexes.begin(), indexes.end());
+  const size_t pass_size = THDVAR(ha_thd(), index_build_threads);
+  for (size_t pass_start = 0; pass_start < all_index_defs.size();
+       pass_start += pass_size) {
+    const std::vector<std::shared_ptr<Rdb_key_def>> index_defs(
+        all_index_defs.begin() + pass_start,
+        all_index_defs.begin() +
+            std::min(pass_start + pass_size, all_index_defs.size()));
+    DBUG_EXECUTE_IF("myrocks_check_index_build_memory",
+                    Rdb_index_merge::reset_peak_buf_bytes(););
+#ifndef DBUG_OFF
+    const ulonglong pass_start_buf_bytes = Rdb_index_merge::s_buf_bytes;
+#endif
 
-    Rdb_index_merge rdb_merge(
-        thd_rocksdb_tmpdir(), rdb_merge_buf_size, rdb_merge_combine_read_size,
-        rdb_merge_tmp_file_removal_delay, index->get_cf());
+    std::vector<std::unique_ptr<Rdb_index_merge>> merges;
+    for (const auto &index : index_defs) {
+      merges.emplace_back(new Rdb_index_merge(
+          thd_rocksdb_tmpdir(), rdb_merge_buf_size, rdb_merge_combine_read_size,
+          rdb_merge_tmp_file_removal_delay, index->get_cf()));
 
-    if ((res = rdb_merge.init())) {
-      DBUG_RETURN(res);
+      if ((res = merges.back()->init())) {
+        DBUG_RETURN(res);
+      }
     }
 
     /*
@@ -11342,25 +12499,27 @@ int ha_rocksdb::inplace_populate_sk(
         DBUG_RETURN(res);
       }
 
-      /* Create new secondary index entry */
-      const int new_packed_size = index->pack_record(
-          new_table_arg, m_pack_buffer, table->record[0], m_sk_packed_tuple,
-          &m_sk_tails, should_store_row_debug_checksums(), hidden_pk_id, 0,
-          nullptr, nullptr, m_ttl_bytes);
+      for (size_t i = 0; i < index_defs.size(); i++) {
+        /* Create new secondary index entry */
+        const int new_packed_size = index_defs[i]->pack_record(
+            new_table_arg, m_pack_buffer, table->record[0], m_sk_packed_tuple,
+            &m_sk_tails, should_store_row_debug_checksums(), hidden_pk_id, 0,
+            nullptr, nullptr, m_ttl_bytes);
 
-      const rocksdb::Slice key = rocksdb::Slice(
-          reinterpret_cast<const char *>(m_sk_packed_tuple), new_packed_size);
-      const rocksdb::Slice val =
-          rocksdb::Slice(reinterpret_cast<const char *>(m_sk_tails.ptr()),
-                         m_sk_tails.get_current_pos());
+        const rocksdb::Slice key = rocksdb::Slice(
+            reinterpret_cast<const char *>(m_sk_packed_tuple), new_packed_size);
+        const rocksdb::Slice val =
+            rocksdb::Slice(reinterpret_cast<const char *>(m_sk_tails.ptr()),
+                           m_sk_tails.get_current_pos());
 
-      /*
-        Add record to offset tree in preparation for writing out to
-        disk in sorted chunks.
-      */
-      if ((res = rdb_merge.add(key, val))) {
-        ha_index_end();
-        DBUG_RETURN(res);
+        /*
+          Add record to offset tree in preparation for writing out to
+          disk in sorted chunks.
+        */
+        if ((res = merges[i]->add(key, val))) {
+          ha_index_end();
+          DBUG_RETURN(res);
+        }
       }
     }
 
@@ -11374,63 +12533,40 @@ int ha_rocksdb::inplace_populate_sk(
     ha_index_end();
 
     /*
-      Perform an n-way merge of n sorted buffers on disk, then writes all
-      results to RocksDB via SSTFileWriter API.
+      Perform an n-way merge of n sorted buffers on disk for every index, then
+      write all results to RocksDB via SSTFileWriter API, one index per thread.
     */
-    rocksdb::Slice merge_key;
-    rocksdb::Slice merge_val;
-
-    struct unique_sk_buf_info sk_info;
-    sk_info.dup_sk_buf = m_dup_sk_packed_tuple;
-    sk_info.dup_sk_buf_old = m_dup_sk_packed_tuple_old;
-
-    while ((res = rdb_merge.next(&merge_key, &merge_val)) == 0) {
-      /* Perform uniqueness check if needed */
-      if (is_unique_index) {
-        if (check_duplicate_sk(new_table_arg, *index, &merge_key, &sk_info)) {
-          /*
-            Duplicate entry found when trying to create unique secondary key.
-            We need to unpack the record into new_table_arg->record[0] as it
-            is used inside print_keydup_error so that the error message shows
-            the duplicate record.
-          */
-          if (index->unpack_record(new_table_arg, new_table_arg->record[0],
-                                   &merge_key, nullptr,
-                                   m_verify_row_debug_checksums)) {
-            /* Should never reach here */
-            DBUG_ASSERT(0);
-          }
+    std::vector<std::unique_ptr<Rdb_index_build_job>> jobs;
+    for (size_t i = 0; i < index_defs.size(); i++) {
+      const bool is_unique_index =
+          new_table_arg->key_info[index_defs[i]->get_keyno()].flags & HA_NOSAME;
 
-          print_keydup_error(new_table_arg,
-                             &new_table_arg->key_info[index->get_keyno()],
-                             MYF(0), ha_thd());
-          DBUG_RETURN(ER_DUP_ENTRY);
-        }
-      }
+      jobs.emplace_back(new Rdb_index_build_job(
+          merges[i].get(), m_table_handler->m_table_name,
+          index_defs[i]->get_name(),
+          is_unique_index ? index_defs[i].get() : nullptr,
+          THDVAR(ha_thd(), trace_sst_api)));
+    }
 
-      /*
-        Insert key and slice to SST via SSTFileWriter API.
-      */
-      if ((res = bulk_load_key(tx, *index, merge_key, merge_val, false))) {
-        break;
+    if ((res = run_index_build_jobs(&jobs, new_table_arg, true))) {
+      if (res != ER_DUP_ENTRY) {
+        // NO_LINT_DEBUG
+        sql_print_error(
+            "Error while bulk loading keys in external merge sort.");
       }
+      DBUG_RETURN(res);
     }
 
     /*
-      Here, res == -1 means that we are finished, while > 0 means an error
-      occurred.
+      Each index of the pass has an unsorted and an output buffer while the
+      primary key is scanned, and reads its sorted runs into up to
+      rocksdb_merge_combine_read_size bytes while it is merged.
     */
-    if (res > 0) {
-      // NO_LINT_DEBUG
-      sql_print_error("Error while bulk loading keys in external merge sort.");
-      DBUG_RETURN(res);
-    }
-
-    if ((res = tx->finish_bulk_load())) {
-      // NO_LINT_DEBUG
-      sql_print_error("Error finishing bulk load.");
-      DBUG_RETURN(res);
-    }
+    DBUG_EXECUTE_IF("myrocks_check_index_build_memory", {
+      DBUG_ASSERT(Rdb_index_merge::s_peak_buf_bytes - pass_start_buf_bytes <=
+                  index_defs.size() * (2 * rdb_merge_buf_size +
+                                       rdb_merge_combine_read_size));
+    });
   }
 
   /*
@@ -11832,6 +12968,13 @@ static void myrocks_update_status() {
 
   export_stats.covered_secondary_key_lookups =
       global_stats.covered_secondary_key_lookups;
+  export_stats.iterators_without_write_batch =
+      global_stats.iterators_without_write_batch;
+  export_stats.tombstone_compactions = global_stats.tombstone_compactions;
+  export_stats.compaction_controller_rate_limit =
+      rdb_controller_thread.get_rate_limit();
+  export_stats.compaction_controller_background_jobs =
+      rdb_controller_thread.get_background_jobs();
 }
 
 static void myrocks_update_memory_status() {
@@ -11878,6 +13021,17 @@ static SHOW_VAR myrocks_status_variables[] = {
     DEF_STATUS_VAR_FUNC("covered_secondary_key_lookups",
                         &export_stats.covered_secondary_key_lookups,
                         SHOW_LONGLONG),
+    DEF_STATUS_VAR_FUNC("iterators_without_write_batch",
+                        &export_stats.iterators_without_write_batch,
+                        SHOW_LONGLONG),
+    DEF_STATUS_VAR_FUNC("tombstone_compactions",
+                        &export_stats.tombstone_compactions, SHOW_LONGLONG),
+    DEF_STATUS_VAR_FUNC("compaction_controller_rate_limit",
+                        &export_stats.compaction_controller_rate_limit,
+                        SHOW_LONGLONG),
+    DEF_STATUS_VAR_FUNC("compaction_controller_background_jobs",
+                        &export_stats.compaction_controller_background_jobs,
+                        SHOW_LONGLONG),
 
     {NullS, NullS, SHOW_LONG}};
 
@@ -12073,6 +13227,118 @@ static SHOW_VAR rocksdb_status_vars[] = {
      SHOW_FUNC},
     {NullS, NullS, SHOW_LONG}};
 
+/*
+  Returns true if all the rows in an SST file, described by its properties,
+  belong to TTL indexes and had expired at ts.
+*/
+static bool rdb_all_ttl_expired(
+    const std::shared_ptr<const rocksdb::TableProperties> &props,
+    const uint64 ts) {
+  std::vector<Rdb_index_ttl_stats> ttl_stats;
+  Rdb_tbl_prop_coll::read_ttl_stats_from_tbl_props(*props, &ttl_stats);
+  if (ttl_stats.empty()) {
+    return false;
+  }
+
+  std::vector<Rdb_index_stats> stats;
+  Rdb_tbl_prop_coll::read_stats_from_tbl_props(props, &stats);
+  if (stats.size() != ttl_stats.size()) {
+    return false;
+  }
+
+  for (const auto &index_ttl_stats : ttl_stats) {
+    Rdb_index_info index_info;
+    if (index_ttl_stats.m_non_put_entries != 0 ||
+        !rdb_get_dict_manager()->get_index_info(index_ttl_stats.m_gl_index_id,
+                                                &index_info) ||
+        index_info.m_ttl_duration == 0) {
+      return false;
+    }
+#ifndef NDEBUG
+    if (rdb_dbug_set_ttl_ignore_pk() &&
+        index_info.m_index_type == Rdb_key_def::INDEX_TYPE_PRIMARY) {
+      return false;
+    }
+#endif
+    if (!index_ttl_stats.all_expired(index_info.m_ttl_duration, ts)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+  Deletes the SST files in the last non-empty level of each column family
+  where all the rows have expired, as compaction would drop all of them
+  anyway. Files in the upper levels are left to compaction, as deleting them
+  could bring back older versions of their rows.
+*/
+static void rdb_drop_expired_ttl_files() {
+  if (!rdb_is_ttl_enabled()) {
+    return;
+  }
+
+  // Same timestamp as Rdb_compact_filter
+  uint64_t ts;
+  if (!rdb->GetIntProperty(rocksdb::DB::Properties::kOldestSnapshotTime,
+                           &ts) ||
+      ts == 0) {
+    ts = static_cast<uint64_t>(std::time(nullptr));
+  }
+#ifndef NDEBUG
+  const int snapshot_ts = rdb_dbug_set_ttl_snapshot_ts();
+  if (snapshot_ts) {
+    ts = static_cast<uint64_t>(std::time(nullptr)) + snapshot_ts;
+  }
+#endif
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rdb->GetLiveFilesMetaData(&files);
+
+  std::map<std::string, int> bottom_levels;
+  for (const auto &file : files) {
+    int &level = bottom_levels[file.column_family_name];
+    level = std::max(level, file.level);
+  }
+
+  for (const auto cf_handle : rdb_get_cf_manager().get_all_cf()) {
+    const auto level_it = bottom_levels.find(cf_handle->GetName());
+    if (level_it == bottom_levels.end()) {
+      continue;
+    }
+
+    rocksdb::TablePropertiesCollection props;
+    if (!rdb->GetPropertiesOfAllTables(cf_handle, &props).ok()) {
+      continue;
+    }
+
+    for (const auto &file : files) {
+      if (file.column_family_name != level_it->first ||
+          file.level != level_it->second) {
+        continue;
+      }
+
+      const auto props_it = props.find(file.db_path + file.name);
+      if (props_it == props.end() ||
+          !rdb_all_ttl_expired(props_it->second, ts)) {
+        continue;
+      }
+
+      /*
+        Fails if the file got compacted in the meantime, or if it is not the
+        oldest one of level 0: it is then left to compaction.
+      */
+      const rocksdb::Status s = rdb->DeleteFile(file.name);
+      if (s.ok()) {
+        // NO_LINT_DEBUG
+        sql_print_information("RocksDB: Deleted SST file %s of column family "
+                              "%s, all its rows have expired",
+                              file.name.c_str(), level_it->first.c_str());
+      }
+    }
+  }
+}
+
 /*
   Background thread's main logic
 */
@@ -12085,6 +13351,9 @@ void Rdb_background_thread::run() {
   clock_gettime(CLOCK_REALTIME, &ts_next_sync);
   ts_next_sync.tv_sec += WAKE_UP_INTERVAL;
 
+  // When expired TTL files were last looked for
+  time_t ts_last_ttl_drop = 0;
+
   for (;;) {
     // Wait until the next timeout or until we receive a signal to stop the
     // thread. Request to stop the thread should only be triggered when the
@@ -12117,6 +13386,13 @@ void Rdb_background_thread::run() {
     timespec ts;
     clock_gettime(CLOCK_REALTIME, &ts);
 
+    const uint32_t drop_ttl_period = rocksdb_drop_expired_ttl_files_period_sec;
+    if (rdb && drop_ttl_period != 0 &&
+        ts.tv_sec - ts_last_ttl_drop >= drop_ttl_period) {
+      rdb_drop_expired_ttl_files();
+      ts_last_ttl_drop = ts.tv_sec;
+    }
+
     // Flush the WAL. Sync it for both background and never modes to copy
     // InnoDB's behavior. For mode never, the wal file isn't even written,
     // whereas background writes to the wal file, but issues the syncs in a
@@ -12412,10 +13688,16 @@ void rocksdb_set_rate_limiter_bytes_per_sec(
                         "be dynamically changed to or from 0.  Do a clean "
                         "shutdown if you want to change it from or to 0.");
   } else if (new_val != rocksdb_rate_limiter_bytes_per_sec) {
-    /* Apply the new value to the rate limiter and store it locally */
+    /*
+      Apply the new value to the rate limiter and store it locally. The
+      mutex orders this with the compaction controller, which also sets
+      the rate.
+    */
     DBUG_ASSERT(rocksdb_rate_limiter != nullptr);
+    RDB_MUTEX_LOCK_CHECK(rdb_sysvars_mutex);
     rocksdb_rate_limiter_bytes_per_sec = new_val;
     rocksdb_rate_limiter->SetBytesPerSecond(new_val);
+    RDB_MUTEX_UNLOCK_CHECK(rdb_sysvars_mutex);
   }
 }
 
@@ -144,6 +144,16 @@ const char *const BG_THREAD_NAME = "myrocks-bg";
 */
 const char *const INDEX_THREAD_NAME = "myrocks-index";
 
+/*
+  Name for the tombstone compaction thread.
+*/
+const char *const TOMBSTONE_THREAD_NAME = "myrocks-tomb";
+
+/*
+  Name for the compaction controller thread.
+*/
+const char *const CONTROLLER_THREAD_NAME = "myrocks-ctl";
+
 /*
   Separator between partition name and the qualifier. Sample usage:
 
@@ -398,6 +408,12 @@ struct st_global_stats {
   ib_counter_t<ulonglong, 64, RDB_INDEXER> queries[QUERIES_MAX];
 
   ib_counter_t<ulonglong, 64, RDB_INDEXER> covered_secondary_key_lookups;
+
+  // Iterators which did not merge the write batch of the transaction
+  ib_counter_t<ulonglong, 64, RDB_INDEXER> iterators_without_write_batch;
+
+  // Compactions of indexes whose scans skipped too many tombstones
+  ib_counter_t<ulonglong, 64, RDB_INDEXER> tombstone_compactions;
 };
 
 /* Struct used for exporting status to MySQL */
@@ -419,6 +435,10 @@ struct st_export_stats {
   ulonglong queries_range;
 
   ulonglong covered_secondary_key_lookups;
+  ulonglong iterators_without_write_batch;
+  ulonglong tombstone_compactions;
+  ulonglong compaction_controller_rate_limit;
+  ulonglong compaction_controller_background_jobs;
 };
 
 /* Struct used for exporting RocksDB memory status */
@@ -481,8 +501,19 @@ class ha_rocksdb : public my_core::handler {
   /* Whether m_scan_it was created with skip_bloom=true */
   bool m_scan_it_skips_bloom;
 
+  /* Whether m_scan_it reads the index without the write batch */
+  bool m_scan_it_skips_write_batch;
+
   const rocksdb::Snapshot *m_scan_it_snapshot;
 
+  /*
+    Index scanned by m_scan_it, and the tombstones skipped and the rows read
+    by the session when the iterator was created
+  */
+  const Rdb_key_def *m_scan_it_kd;
+  ulonglong m_scan_it_deletes_skipped;
+  ulonglong m_scan_it_rows_read;
+
   Rdb_tbl_def *m_tbl_def;
 
   /* Primary Key encoder from KeyTupleFormat to StorageFormat */
@@ -583,6 +614,22 @@ class ha_rocksdb : public my_core::handler {
   */
   rocksdb::PinnableSlice m_retrieved_record;
 
+  /* Multi-Range Read over a secondary index, see multi_range_read_init() */
+  DsMrr_impl m_ds_mrr;
+
+  /*
+    Buffer of sorted rowids that DS-MRR reads with rnd_pos(), and the keys,
+    values and statuses read by the last MultiGet for the rowids starting at
+    m_mrr_batch_start in this buffer.
+  */
+  const uchar *m_mrr_rowids;
+  uint m_mrr_n_rowids;
+  uint m_mrr_elem_size;
+  uint m_mrr_batch_start;
+  std::vector<std::string> m_mrr_batch_keys;
+  std::vector<std::string> m_mrr_batch_values;
+  std::vector<rocksdb::Status> m_mrr_batch_status;
+
   /* Type of locking to apply to rows */
   enum { RDB_LOCK_NONE, RDB_LOCK_READ, RDB_LOCK_WRITE } m_lock_rows;
 
@@ -649,6 +696,7 @@ class ha_rocksdb : public my_core::handler {
                            const bool use_all_keys, const uint eq_cond_len)
       MY_ATTRIBUTE((__nonnull__));
   void release_scan_iterator(void);
+  void record_scan_tombstones(void);
 
   rocksdb::Status
   get_for_update(Rdb_transaction *const tx,
@@ -668,6 +716,13 @@ class ha_rocksdb : public my_core::handler {
                             rowid_size, skip_lookup, skip_ttl_check);
   }
 
+  bool mrr_supported() const;
+  void mrr_reset_batch();
+  int mrr_read_batch(const uint first)
+      MY_ATTRIBUTE((__warn_unused_result__));
+  int mrr_get_row(uchar *const buf, const uchar *const pos, bool *const found)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+
   void load_auto_incr_value();
   ulonglong load_auto_incr_value_from_index();
   void update_auto_incr_val(ulonglong val);
@@ -690,7 +745,7 @@ class ha_rocksdb : public my_core::handler {
   bool has_hidden_pk(const TABLE *const table) const
       MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
 
-  void update_row_stats(const operation_type &type);
+  void update_row_stats(const operation_type &type, const ha_rows n = 1);
 
   void set_last_rowkey(const uchar *const old_data);
 
@@ -709,6 +764,14 @@ class ha_rocksdb : public my_core::handler {
     bool m_decode;
     /* Skip this many bytes before reading (or skipping) this field */
     int m_skip;
+    /*
+      If non-zero, this field and the NOT NULL fixed-width fields after it,
+      which are next to each other both in the record and in the stored row,
+      are decoded as one run of this many bytes with a single memcpy.
+    */
+    uint m_run_len;
+    /* Offset of the field in table->record[0], for runs */
+    uint m_rec_offset;
   };
 
   /*
@@ -724,6 +787,12 @@ class ha_rocksdb : public my_core::handler {
    */
   bool m_key_requested = false;
 
+  /*
+    Primary key parts which do not need to be unpacked because they are not
+    in the read set.
+  */
+  key_part_map m_pk_parts_to_skip = 0;
+
   /* Setup field_decoders based on type of scan and table->read_set */
   void setup_read_decoders();
 
@@ -834,9 +903,12 @@ public:
       HA_REC_NOT_IN_SEQ
         If we don't set it, filesort crashes, because it assumes rowids are
         1..8 byte numbers
+      HA_HAS_RECORDS
+        records() counts the rows with a parallel scan, see its comment for
+        when it declines to do so.
     */
     DBUG_RETURN(HA_BINLOG_ROW_CAPABLE | HA_BINLOG_STMT_CAPABLE |
-                HA_REC_NOT_IN_SEQ | HA_CAN_INDEX_BLOBS |
+                HA_REC_NOT_IN_SEQ | HA_CAN_INDEX_BLOBS | HA_HAS_RECORDS |
                 (m_pk_can_be_decoded ? HA_PRIMARY_KEY_IN_READ_INDEX : 0) |
                 HA_PRIMARY_KEY_REQUIRED_FOR_POSITION | HA_NULL_IN_KEY |
                 HA_PARTIAL_COLUMN_READ);
@@ -1173,9 +1245,10 @@ private:
       MY_ATTRIBUTE((__warn_unused_result__));
   bool over_bulk_load_threshold(int *err)
       MY_ATTRIBUTE((__warn_unused_result__));
-  int check_duplicate_sk(const TABLE *table_arg, const Rdb_key_def &index,
-                         const rocksdb::Slice *key,
-                         struct unique_sk_buf_info *sk_info)
+  static int check_duplicate_sk(const TABLE *table_arg,
+                                const Rdb_key_def &index,
+                                const rocksdb::Slice *key,
+                                struct unique_sk_buf_info *sk_info)
       MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
   int bulk_load_key(Rdb_transaction *const tx, const Rdb_key_def &kd,
                     const rocksdb::Slice &key, const rocksdb::Slice &value,
@@ -1238,6 +1311,16 @@ private:
       const std::unordered_set<std::shared_ptr<Rdb_key_def>> &indexes)
       MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
 
+  /*
+    Merges the sorted runs of one index and writes them to SST files; the
+    indexes of a table are written by several of these in parallel.
+  */
+  struct Rdb_index_build_job;
+  int run_index_build_jobs(
+      std::vector<std::unique_ptr<Rdb_index_build_job>> *const jobs,
+      TABLE *const table_arg, bool print_client_error)
+      MY_ATTRIBUTE((__nonnull__(2), __warn_unused_result__));
+
 public:
   int index_init(uint idx, bool sorted) override
       MY_ATTRIBUTE((__warn_unused_result__));
@@ -1263,6 +1346,22 @@ public:
 
   int rnd_pos(uchar *const buf, uchar *const pos) override
       MY_ATTRIBUTE((__warn_unused_result__));
+
+  int multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
+                            uint n_ranges, uint mode,
+                            HANDLER_BUFFER *buf) override
+      MY_ATTRIBUTE((__warn_unused_result__));
+  int multi_range_read_next(char **range_info) override
+      MY_ATTRIBUTE((__warn_unused_result__));
+  ha_rows multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
+                                      void *seq_init_param, uint n_ranges,
+                                      uint *bufsz, uint *flags,
+                                      Cost_estimate *cost) override;
+  ha_rows multi_range_read_info(uint keyno, uint n_ranges, uint keys,
+                                uint *bufsz, uint *flags,
+                                Cost_estimate *cost) override;
+  void multi_range_read_rowids(uchar *rowids, uint n_rowids,
+                               uint elem_size) override;
   void position(const uchar *const record) override;
   int info(uint) override;
 
@@ -1283,12 +1382,16 @@ public:
     /* Free blob data */
     m_retrieved_record.Reset();
 
+    mrr_reset_batch();
+    m_ds_mrr.reset();
+
     DBUG_RETURN(HA_EXIT_SUCCESS);
   }
 
   int check(THD *const thd, HA_CHECK_OPT *const check_opt) override
       MY_ATTRIBUTE((__warn_unused_result__));
   int remove_rows(Rdb_tbl_def *const tbl);
+  ha_rows records() override;
   ha_rows records_in_range(uint inx, key_range *const min_key,
                            key_range *const max_key) override
       MY_ATTRIBUTE((__warn_unused_result__));
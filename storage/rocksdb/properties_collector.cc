@@ -19,6 +19,7 @@
 
 /* Standard C++ header files */
 #include <algorithm>
+#include <iterator>
 #include <map>
 #include <string>
 #include <vector>
@@ -46,8 +47,9 @@ Rdb_tbl_prop_coll::Rdb_tbl_prop_coll(Rdb_ddl_manager *const ddl_manager,
                                      const uint32_t &cf_id,
                                      const uint8_t &table_stats_sampling_pct)
     : m_cf_id(cf_id), m_ddl_manager(ddl_manager), m_last_stats(nullptr),
-      m_rows(0l), m_window_pos(0l), m_deleted_rows(0l), m_max_deleted_rows(0l),
-      m_file_size(0), m_params(params),
+      m_last_ttl_stats(nullptr), m_rows(0l), m_window_pos(0l),
+      m_deleted_rows(0l), m_max_deleted_rows(0l), m_file_size(0),
+      m_params(params),
       m_cardinality_collector(table_stats_sampling_pct) {
   DBUG_ASSERT(ddl_manager != nullptr);
 
@@ -110,6 +112,10 @@ Rdb_index_stats *Rdb_tbl_prop_coll::AccessStats(const rocksdb::Slice &key) {
 
   if (m_last_stats == nullptr || m_last_stats->m_gl_index_id != gl_index_id) {
     m_keydef = nullptr;
+    m_last_ttl_stats = nullptr;
+    if (m_last_stats != nullptr) {
+      m_histogram_collector.Finish(m_last_stats);
+    }
 
     // starting a new table
     // add the new element into m_stats
@@ -131,6 +137,12 @@ Rdb_index_stats *Rdb_tbl_prop_coll::AccessStats(const rocksdb::Slice &key) {
         m_last_stats->m_distinct_keys_per_prefix.resize(
             m_keydef->get_key_parts());
         m_last_stats->m_name = m_keydef->get_name();
+        m_histogram_collector.Reset(m_keydef->m_is_reverse_cf);
+
+        if (m_keydef->has_ttl()) {
+          m_ttl_stats.emplace_back(gl_index_id);
+          m_last_ttl_stats = &m_ttl_stats.back();
+        }
       }
     }
     m_cardinality_collector.Reset();
@@ -151,6 +163,9 @@ void Rdb_tbl_prop_coll::CollectStatsForRow(const rocksdb::Slice &key,
   switch (type) {
   case rocksdb::kEntryPut:
     stats->m_rows++;
+    if (m_keydef != nullptr) {
+      m_histogram_collector.ProcessKey(key);
+    }
     break;
   case rocksdb::kEntryDelete:
     stats->m_entry_deletes++;
@@ -179,9 +194,23 @@ void Rdb_tbl_prop_coll::CollectStatsForRow(const rocksdb::Slice &key,
   if (m_keydef != nullptr) {
     m_cardinality_collector.ProcessKey(key, m_keydef.get(), stats);
   }
+
+  if (m_last_ttl_stats != nullptr) {
+    Rdb_string_reader reader(&value);
+    uint64 ts;
+    if (type == rocksdb::kEntryPut && reader.read(m_keydef->m_ttl_rec_offset) &&
+        !reader.read_uint64(&ts)) {
+      m_last_ttl_stats->m_min_ts = std::min(m_last_ttl_stats->m_min_ts, ts);
+      m_last_ttl_stats->m_max_ts = std::max(m_last_ttl_stats->m_max_ts, ts);
+    } else {
+      m_last_ttl_stats->m_non_put_entries++;
+    }
+  }
 }
 
 const char *Rdb_tbl_prop_coll::INDEXSTATS_KEY = "__indexstats__";
+const char *Rdb_tbl_prop_coll::INDEXTTL_KEY = "__indexttl__";
+const char *Rdb_tbl_prop_coll::INDEXHIST_KEY = "__indexhist__";
 
 /*
   This function is called by RocksDB to compute properties to store in sst file
@@ -224,10 +253,19 @@ Rdb_tbl_prop_coll::Finish(rocksdb::UserCollectedProperties *const properties) {
     rocksdb_num_sst_entry_other += num_sst_entry_other;
   }
 
+  if (m_last_stats != nullptr) {
+    m_histogram_collector.Finish(m_last_stats);
+  }
   for (Rdb_index_stats &stat : m_stats) {
     m_cardinality_collector.AdjustStats(&stat);
   }
   properties->insert({INDEXSTATS_KEY, Rdb_index_stats::materialize(m_stats)});
+  properties->insert(
+      {INDEXHIST_KEY, Rdb_index_stats::materialize_histograms(m_stats)});
+  if (!m_ttl_stats.empty()) {
+    properties->insert(
+        {INDEXTTL_KEY, Rdb_index_ttl_stats::materialize(m_ttl_stats)});
+  }
   return rocksdb::Status::OK();
 }
 
@@ -307,6 +345,36 @@ void Rdb_tbl_prop_coll::read_stats_from_tbl_props(
         Rdb_index_stats::unmaterialize(it2->second, out_stats_vector);
     DBUG_ASSERT(result == 0);
   }
+
+  /*
+    Files written before the histograms were collected have none, and a
+    histogram which cannot be read is only ignored.
+  */
+  const auto it3 = user_properties.find(std::string(INDEXHIST_KEY));
+  if (it3 != user_properties.end() &&
+      Rdb_index_stats::unmaterialize_histograms(it3->second,
+                                                out_stats_vector)) {
+    for (auto &stats : *out_stats_vector) {
+      stats.m_histogram = nullptr;
+    }
+  }
+}
+
+/*
+  Given the properties of an SST file, reads the TTL timestamps of its TTL
+  indexes. Files written before they were collected have none.
+*/
+
+void Rdb_tbl_prop_coll::read_ttl_stats_from_tbl_props(
+    const rocksdb::TableProperties &table_props,
+    std::vector<Rdb_index_ttl_stats> *const out_stats_vector) {
+  DBUG_ASSERT(out_stats_vector != nullptr);
+  const auto &user_properties = table_props.user_collected_properties;
+  const auto it = user_properties.find(std::string(INDEXTTL_KEY));
+  if (it != user_properties.end() &&
+      Rdb_index_ttl_stats::unmaterialize(it->second, out_stats_vector)) {
+    out_stats_vector->clear();
+  }
 }
 
 /*
@@ -404,6 +472,144 @@ int Rdb_index_stats::unmaterialize(const std::string &s,
   return HA_EXIT_SUCCESS;
 }
 
+/*
+  Serializes the histograms of an array of Rdb_index_stats into a network
+  string. Indexes without a histogram are left out.
+*/
+std::string Rdb_index_stats::materialize_histograms(
+    const std::vector<Rdb_index_stats> &stats) {
+  String ret;
+  rdb_netstr_append_uint16(&ret, INDEX_HISTOGRAM_VERSION_INITIAL);
+  for (const auto &i : stats) {
+    if (i.m_histogram == nullptr) {
+      continue;
+    }
+    rdb_netstr_append_uint32(&ret, i.m_gl_index_id.cf_id);
+    rdb_netstr_append_uint32(&ret, i.m_gl_index_id.index_id);
+    rdb_netstr_append_uint64(&ret, i.m_histogram->m_points.size());
+    for (const auto &point : i.m_histogram->m_points) {
+      rdb_netstr_append_uint16(&ret, point.m_key.size());
+      ret.append(point.m_key.data(), point.m_key.size());
+      rdb_netstr_append_uint64(&ret, point.m_rows);
+    }
+  }
+
+  return std::string((char *)ret.ptr(), ret.length());
+}
+
+/**
+  @brief
+  Reads histograms from a string into the entries of ret with the same index
+  id. Histograms of indexes which are not in ret are skipped. Like the TTL
+  stats, an unknown version is not fatal.
+  @return HA_EXIT_FAILURE if it detects any inconsistency in the input
+  @return HA_EXIT_SUCCESS if completes successfully
+*/
+int Rdb_index_stats::unmaterialize_histograms(
+    const std::string &s, std::vector<Rdb_index_stats> *const ret) {
+  const uchar *p = rdb_std_str_to_uchar_ptr(s);
+  const uchar *const p2 = p + s.size();
+
+  DBUG_ASSERT(ret != nullptr);
+
+  if (p + 2 > p2 ||
+      rdb_netbuf_read_uint16(&p) != INDEX_HISTOGRAM_VERSION_INITIAL) {
+    return HA_EXIT_FAILURE;
+  }
+
+  while (p < p2) {
+    GL_INDEX_ID gl_index_id;
+    if (p + sizeof(gl_index_id.cf_id) + sizeof(gl_index_id.index_id) +
+            sizeof(uint64) >
+        p2) {
+      return HA_EXIT_FAILURE;
+    }
+    rdb_netbuf_read_gl_index(&p, &gl_index_id);
+    const uint64 n_points = rdb_netbuf_read_uint64(&p);
+    const auto histogram = std::make_shared<Rdb_index_histogram>();
+    for (uint64 i = 0; i < n_points; i++) {
+      if (p + sizeof(uint16) > p2) {
+        return HA_EXIT_FAILURE;
+      }
+      const uint16 key_len = rdb_netbuf_read_uint16(&p);
+      if (p + key_len + sizeof(uint64) > p2) {
+        return HA_EXIT_FAILURE;
+      }
+      Rdb_index_histogram::point point;
+      point.m_key.assign(reinterpret_cast<const char *>(p), key_len);
+      p += key_len;
+      point.m_rows = rdb_netbuf_read_uint64(&p);
+      histogram->m_points.push_back(std::move(point));
+    }
+    if (histogram->m_points.empty()) {
+      continue;
+    }
+    for (auto &stats : *ret) {
+      if (stats.m_gl_index_id == gl_index_id) {
+        stats.m_histogram = histogram;
+      }
+    }
+  }
+  return HA_EXIT_SUCCESS;
+}
+
+/*
+  Serializes an array of Rdb_index_ttl_stats into a network string.
+*/
+std::string Rdb_index_ttl_stats::materialize(
+    const std::vector<Rdb_index_ttl_stats> &stats) {
+  String ret;
+  rdb_netstr_append_uint16(&ret, INDEX_TTL_STATS_VERSION_INITIAL);
+  for (const auto &i : stats) {
+    rdb_netstr_append_uint32(&ret, i.m_gl_index_id.cf_id);
+    rdb_netstr_append_uint32(&ret, i.m_gl_index_id.index_id);
+    rdb_netstr_append_uint64(&ret, i.m_min_ts);
+    rdb_netstr_append_uint64(&ret, i.m_max_ts);
+    rdb_netstr_append_uint64(&ret, i.m_non_put_entries);
+  }
+
+  return std::string((char *)ret.ptr(), ret.length());
+}
+
+/**
+  @brief
+  Reads an array of Rdb_index_ttl_stats from a string. Unlike the index
+  stats, an unknown version is not fatal: the files are then only read and
+  compacted like files without TTL timestamps.
+  @return HA_EXIT_FAILURE if it detects any inconsistency in the input
+  @return HA_EXIT_SUCCESS if completes successfully
+*/
+int Rdb_index_ttl_stats::unmaterialize(
+    const std::string &s, std::vector<Rdb_index_ttl_stats> *const ret) {
+  const uchar *p = rdb_std_str_to_uchar_ptr(s);
+  const uchar *const p2 = p + s.size();
+
+  DBUG_ASSERT(ret != nullptr);
+
+  if (p + 2 > p2 ||
+      rdb_netbuf_read_uint16(&p) != INDEX_TTL_STATS_VERSION_INITIAL) {
+    return HA_EXIT_FAILURE;
+  }
+
+  Rdb_index_ttl_stats stats;
+  const size_t needed = sizeof(stats.m_gl_index_id.cf_id) +
+                        sizeof(stats.m_gl_index_id.index_id) +
+                        sizeof(stats.m_min_ts) + sizeof(stats.m_max_ts) +
+                        sizeof(stats.m_non_put_entries);
+
+  while (p < p2) {
+    if (p + needed > p2) {
+      return HA_EXIT_FAILURE;
+    }
+    rdb_netbuf_read_gl_index(&p, &stats.m_gl_index_id);
+    stats.m_min_ts = rdb_netbuf_read_uint64(&p);
+    stats.m_max_ts = rdb_netbuf_read_uint64(&p);
+    stats.m_non_put_entries = rdb_netbuf_read_uint64(&p);
+    ret->push_back(stats);
+  }
+  return HA_EXIT_SUCCESS;
+}
+
 /*
   Merges one Rdb_index_stats into another. Can be used to come up with the stats
   for the index based on stats for each sst
@@ -435,6 +641,9 @@ void Rdb_index_stats::merge(const Rdb_index_stats &s, const bool &increment,
     m_entry_single_deletes += s.m_entry_single_deletes;
     m_entry_merges += s.m_entry_merges;
     m_entry_others += s.m_entry_others;
+    if (s.m_histogram != nullptr) {
+      m_histogram = Rdb_index_histogram::merge(m_histogram, *s.m_histogram);
+    }
     if (s.m_distinct_keys_per_prefix.size() > 0) {
       for (i = 0; i < s.m_distinct_keys_per_prefix.size(); i++) {
         m_distinct_keys_per_prefix[i] += s.m_distinct_keys_per_prefix[i];
@@ -454,6 +663,16 @@ void Rdb_index_stats::merge(const Rdb_index_stats &s, const bool &increment,
     m_entry_single_deletes -= s.m_entry_single_deletes;
     m_entry_merges -= s.m_entry_merges;
     m_entry_others -= s.m_entry_others;
+    /*
+      Where the deleted rows were is not known: scale down the whole
+      histogram instead. After a compaction, the histograms of its output
+      files were merged first, so the shape stays about right.
+    */
+    if (m_histogram != nullptr) {
+      m_histogram = m_rows > 0
+                        ? Rdb_index_histogram::scale(*m_histogram, m_rows)
+                        : nullptr;
+    }
     if (s.m_distinct_keys_per_prefix.size() > 0) {
       for (i = 0; i < s.m_distinct_keys_per_prefix.size(); i++) {
         m_distinct_keys_per_prefix[i] -= s.m_distinct_keys_per_prefix[i];
@@ -467,6 +686,200 @@ void Rdb_index_stats::merge(const Rdb_index_stats &s, const bool &increment,
   }
 }
 
+int64_t Rdb_index_histogram::total_rows() const {
+  int64_t rows = 0;
+  for (const auto &point : m_points) {
+    rows += point.m_rows;
+  }
+  return rows;
+}
+
+/*
+  Position of key between lower and upper, from 0 to 1, reading the bytes after
+  the common prefix of lower and upper as a fraction
+*/
+static double rdb_key_position(const rocksdb::Slice &key,
+                               const rocksdb::Slice &lower,
+                               const rocksdb::Slice &upper) {
+  if (key.compare(lower) <= 0) {
+    return 0;
+  }
+  if (key.compare(upper) >= 0) {
+    return 1;
+  }
+
+  size_t prefix = 0;
+  while (prefix < lower.size() && prefix < upper.size() &&
+         lower[prefix] == upper[prefix]) {
+    prefix++;
+  }
+  const auto fraction = [prefix](const rocksdb::Slice &s) {
+    double ret = 0;
+    double weight = 1;
+    for (size_t i = prefix; i < prefix + sizeof(uint64); i++) {
+      weight /= 256;
+      if (i < s.size()) {
+        ret += static_cast<uchar>(s[i]) * weight;
+      }
+    }
+    return ret;
+  };
+  const double lower_pos = fraction(lower);
+  const double upper_pos = fraction(upper);
+  if (upper_pos <= lower_pos) {
+    return 0;
+  }
+  const double pos = (fraction(key) - lower_pos) / (upper_pos - lower_pos);
+  return std::min(1.0, std::max(0.0, pos));
+}
+
+double Rdb_index_histogram::rows_before(const rocksdb::Slice &key) const {
+  // The point whose rows hold key is the last one with m_key <= key
+  auto it = std::upper_bound(m_points.begin(), m_points.end(), key,
+                             [](const rocksdb::Slice &k, const point &p) {
+                               return k.compare(rocksdb::Slice(p.m_key)) < 0;
+                             });
+  if (it == m_points.begin()) {
+    return 0;
+  }
+  --it;
+
+  double rows = 0;
+  for (auto p = m_points.begin(); p != it; ++p) {
+    rows += p->m_rows;
+  }
+
+  // The rows of the last point go up to the first key of the next index
+  uchar supremum[Rdb_key_def::INDEX_NUMBER_SIZE];
+  rocksdb::Slice next_key;
+  if (std::next(it) != m_points.end()) {
+    next_key = rocksdb::Slice(std::next(it)->m_key);
+  } else if (it->m_key.size() >= Rdb_key_def::INDEX_NUMBER_SIZE) {
+    rdb_netbuf_store_index(
+        supremum,
+        rdb_netbuf_to_uint32(
+            reinterpret_cast<const uchar *>(it->m_key.data())) + 1);
+    next_key = rocksdb::Slice(reinterpret_cast<const char *>(supremum),
+                              sizeof(supremum));
+  } else {
+    return rows + it->m_rows / 2.0;
+  }
+
+  return rows + it->m_rows * rdb_key_position(key, rocksdb::Slice(it->m_key),
+                                              next_key);
+}
+
+double Rdb_index_histogram::rows_in_range(const rocksdb::Slice &lower,
+                                          const rocksdb::Slice &upper) const {
+  return std::max(0.0, rows_before(upper) - rows_before(lower));
+}
+
+void Rdb_index_histogram::compact() {
+  if (m_points.size() <= MAX_POINTS) {
+    return;
+  }
+
+  // Each point but the last gets at least depth rows
+  const int64_t depth = total_rows() / (MAX_POINTS - 1) + 1;
+  std::vector<point> points;
+  points.reserve(MAX_POINTS);
+  for (auto &p : m_points) {
+    if (points.empty() || points.back().m_rows >= depth) {
+      points.push_back(std::move(p));
+    } else {
+      points.back().m_rows += p.m_rows;
+    }
+  }
+  m_points = std::move(points);
+}
+
+std::shared_ptr<const Rdb_index_histogram>
+Rdb_index_histogram::merge(const std::shared_ptr<const Rdb_index_histogram> &a,
+                           const Rdb_index_histogram &b) {
+  const auto ret = std::make_shared<Rdb_index_histogram>();
+  if (a == nullptr) {
+    ret->m_points = b.m_points;
+  } else {
+    ret->m_points.reserve(a->m_points.size() + b.m_points.size());
+    std::merge(a->m_points.begin(), a->m_points.end(), b.m_points.begin(),
+               b.m_points.end(), std::back_inserter(ret->m_points),
+               [](const point &x, const point &y) { return x.m_key < y.m_key; });
+  }
+  ret->compact();
+  return ret;
+}
+
+std::shared_ptr<const Rdb_index_histogram>
+Rdb_index_histogram::scale(const Rdb_index_histogram &h, const int64_t rows) {
+  const int64_t total = h.total_rows();
+  const auto ret = std::make_shared<Rdb_index_histogram>();
+  for (const auto &p : h.m_points) {
+    const int64_t scaled =
+        static_cast<int64_t>(static_cast<double>(p.m_rows) * rows / total);
+    if (scaled > 0) {
+      ret->m_points.push_back({p.m_key, scaled});
+    }
+  }
+  return ret->m_points.empty() ? nullptr : ret;
+}
+
+void Rdb_tbl_hist_coll::ProcessKey(const rocksdb::Slice &key) {
+  /*
+    Points keep the lowest of their keys: the first one, or the last one when
+    the keys come in descending order.
+  */
+  if (m_next_rows == 0 || m_is_reverse_cf) {
+    m_next_key.assign(key.data(),
+                      std::min<size_t>(key.size(),
+                                       Rdb_index_histogram::MAX_POINT_KEY_LENGTH));
+  }
+  if (++m_next_rows < m_depth) {
+    return;
+  }
+
+  m_points.push_back({m_next_key, m_next_rows});
+  m_next_rows = 0;
+
+  // Halve the number of points by merging them by pairs
+  if (m_points.size() == 2 * Rdb_index_histogram::MAX_POINTS) {
+    for (size_t i = 0; i < Rdb_index_histogram::MAX_POINTS; i++) {
+      const size_t lowest = m_is_reverse_cf ? 2 * i + 1 : 2 * i;
+      if (lowest != i) {
+        m_points[i].m_key = std::move(m_points[lowest].m_key);
+      }
+      m_points[i].m_rows = m_points[2 * i].m_rows + m_points[2 * i + 1].m_rows;
+    }
+    m_points.resize(Rdb_index_histogram::MAX_POINTS);
+    m_depth *= 2;
+  }
+}
+
+void Rdb_tbl_hist_coll::Finish(Rdb_index_stats *stats) {
+  if (m_next_rows > 0) {
+    m_points.push_back({m_next_key, m_next_rows});
+  }
+
+  if (!m_points.empty()) {
+    if (m_is_reverse_cf) {
+      std::reverse(m_points.begin(), m_points.end());
+    }
+    const auto histogram = std::make_shared<Rdb_index_histogram>();
+    histogram->m_points = std::move(m_points);
+    histogram->compact();
+    stats->m_histogram = histogram;
+  }
+
+  Reset(m_is_reverse_cf);
+}
+
+void Rdb_tbl_hist_coll::Reset(const bool is_reverse_cf) {
+  m_points.clear();
+  m_is_reverse_cf = is_reverse_cf;
+  m_next_key.clear();
+  m_next_rows = 0;
+  m_depth = 1;
+}
+
 Rdb_tbl_card_coll::Rdb_tbl_card_coll(const uint8_t &table_stats_sampling_pct)
     : m_table_stats_sampling_pct(table_stats_sampling_pct),
       m_seed(time(nullptr)) {}
@@ -44,21 +44,75 @@ struct Rdb_compact_params {
   uint64_t m_deletes, m_window, m_file_size;
 };
 
+/*
+  Equi-depth histogram of the keys of an index, in bytewise order whatever the
+  order of the column family. Each point stands for the m_rows rows from its
+  key, which is truncated to MAX_POINT_KEY_LENGTH bytes, up to the key of the next
+  point, or to the end of the index for the last point.
+
+  A histogram is never changed once shared: merging or scaling it builds a
+  new one.
+*/
+struct Rdb_index_histogram {
+  enum {
+    MAX_POINTS = 64,
+    MAX_POINT_KEY_LENGTH = 64,
+  };
+  struct point {
+    std::string m_key;
+    int64_t m_rows;
+  };
+  std::vector<point> m_points;
+
+  int64_t total_rows() const;
+  /*
+    Number of rows with lower <= key < upper, interpolated inside the points
+    which hold lower or upper
+  */
+  double rows_in_range(const rocksdb::Slice &lower,
+                       const rocksdb::Slice &upper) const;
+  /* Merge adjacent points until there are at most MAX_POINTS of them */
+  void compact();
+
+  static std::shared_ptr<const Rdb_index_histogram>
+  merge(const std::shared_ptr<const Rdb_index_histogram> &a,
+        const Rdb_index_histogram &b);
+  static std::shared_ptr<const Rdb_index_histogram>
+  scale(const Rdb_index_histogram &h, const int64_t rows);
+
+ private:
+  /* Number of rows with keys before key */
+  double rows_before(const rocksdb::Slice &key) const;
+};
+
 struct Rdb_index_stats {
   enum {
     INDEX_STATS_VERSION_INITIAL = 1,
     INDEX_STATS_VERSION_ENTRY_TYPES = 2,
   };
+  /*
+    The histograms are stored apart from the rest of the stats, so that
+    servers which do not know them can still read the stats.
+  */
+  enum {
+    INDEX_HISTOGRAM_VERSION_INITIAL = 1,
+  };
   GL_INDEX_ID m_gl_index_id;
   int64_t m_data_size, m_rows, m_actual_disk_size;
   int64_t m_entry_deletes, m_entry_single_deletes;
   int64_t m_entry_merges, m_entry_others;
   std::vector<int64_t> m_distinct_keys_per_prefix;
+  // Keys of the rows, null if not collected
+  std::shared_ptr<const Rdb_index_histogram> m_histogram;
   std::string m_name; // name is not persisted
 
   static std::string materialize(const std::vector<Rdb_index_stats> &stats);
   static int unmaterialize(const std::string &s,
                            std::vector<Rdb_index_stats> *const ret);
+  static std::string
+  materialize_histograms(const std::vector<Rdb_index_stats> &stats);
+  static int unmaterialize_histograms(const std::string &s,
+                                      std::vector<Rdb_index_stats> *const ret);
 
   Rdb_index_stats() : Rdb_index_stats({0, 0}) {}
   explicit Rdb_index_stats(GL_INDEX_ID gl_index_id)
@@ -70,6 +124,36 @@ struct Rdb_index_stats {
              const int64_t &estimated_data_len = 0);
 };
 
+/*
+  Range of the TTL timestamps of the rows of a TTL index in one SST file, so
+  that files in which all the rows of an index have expired can be skipped by
+  scans and dropped without being compacted.
+*/
+struct Rdb_index_ttl_stats {
+  enum {
+    INDEX_TTL_STATS_VERSION_INITIAL = 1,
+  };
+  GL_INDEX_ID m_gl_index_id;
+  uint64 m_min_ts, m_max_ts;
+  // Deletes, merges and rows without a readable timestamp
+  uint64 m_non_put_entries;
+
+  static std::string
+  materialize(const std::vector<Rdb_index_ttl_stats> &stats);
+  static int unmaterialize(const std::string &s,
+                           std::vector<Rdb_index_ttl_stats> *const ret);
+
+  Rdb_index_ttl_stats() : Rdb_index_ttl_stats({0, 0}) {}
+  explicit Rdb_index_ttl_stats(GL_INDEX_ID gl_index_id)
+      : m_gl_index_id(gl_index_id), m_min_ts(ULLONG_MAX), m_max_ts(0),
+        m_non_put_entries(0) {}
+
+  /* All rows are expired at time ts for the given TTL duration */
+  bool all_expired(const uint64 ttl_duration, const uint64 ts) const {
+    return m_max_ts + ttl_duration <= ts;
+  }
+};
+
 // The helper class to calculate index cardinality
 class Rdb_tbl_card_coll {
  public:
@@ -104,6 +188,30 @@ class Rdb_tbl_card_coll {
   unsigned int m_seed;
 };
 
+// The helper class to build the histogram of the keys of an index
+class Rdb_tbl_hist_coll {
+ public:
+  Rdb_tbl_hist_coll() { Reset(); }
+
+  void ProcessKey(const rocksdb::Slice &key);
+  /*
+   * Stores the histogram of the keys processed since the last Reset() into
+   * stats, and resets the collector for the next index.
+   */
+  void Finish(Rdb_index_stats *stats);
+  void Reset(const bool is_reverse_cf = false);
+
+ private:
+  std::vector<Rdb_index_histogram::point> m_points;
+  // Keys come in descending order from reverse column families
+  bool m_is_reverse_cf;
+  // First key and number of rows of the point being filled
+  std::string m_next_key;
+  int64_t m_next_rows;
+  // Number of rows per point, doubled whenever there are too many points
+  int64_t m_depth;
+};
+
 class Rdb_tbl_prop_coll : public rocksdb::TablePropertiesCollector {
 public:
   Rdb_tbl_prop_coll(Rdb_ddl_manager *const ddl_manager,
@@ -136,6 +244,10 @@ public:
       const std::shared_ptr<const rocksdb::TableProperties> &table_props,
       std::vector<Rdb_index_stats> *out_stats_vector);
 
+  static void read_ttl_stats_from_tbl_props(
+      const rocksdb::TableProperties &table_props,
+      std::vector<Rdb_index_ttl_stats> *out_stats_vector);
+
 private:
   static std::string GetReadableStats(const Rdb_index_stats &it);
 
@@ -155,6 +267,13 @@ private:
   Rdb_index_stats *m_last_stats;
   static const char *INDEXSTATS_KEY;
 
+  // TTL timestamps of the TTL indexes, m_last_ttl_stats is null for the others
+  std::vector<Rdb_index_ttl_stats> m_ttl_stats;
+  Rdb_index_ttl_stats *m_last_ttl_stats;
+  static const char *INDEXTTL_KEY;
+
+  static const char *INDEXHIST_KEY;
+
   // last added key
   std::string m_last_key;
 
@@ -164,6 +283,7 @@ private:
   uint64_t m_file_size;
   Rdb_compact_params m_params;
   Rdb_tbl_card_coll m_cardinality_collector;
+  Rdb_tbl_hist_coll m_histogram_collector;
 };
 
 class Rdb_tbl_prop_coll_factory
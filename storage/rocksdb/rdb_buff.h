@@ -145,6 +145,46 @@ inline uchar rdb_netbuf_to_byte(const uchar *const netbuf) {
   return (uchar)netbuf[0];
 }
 
+#if !defined(WORDS_BIGENDIAN)
+/*
+  Convert the mem-comparable image of an integer column (Big Endian, with the
+  sign bit flipped for signed types) into the Little Endian format of the
+  column in table->record[0]. The common widths are converted with a single
+  byte swap instead of byte by byte.
+*/
+inline void rdb_unpack_integer_image(uchar *const to, const uchar *const from,
+                                     const uint length,
+                                     const bool unsigned_flag) {
+  DBUG_ASSERT(to != nullptr);
+  DBUG_ASSERT(from != nullptr);
+
+  const uchar sign_flip = unsigned_flag ? 0 : 0x80;
+
+  switch (length) {
+  case sizeof(uint64): {
+    const uint64 val = rdb_netbuf_to_uint64(from) ^ (uint64(sign_flip) << 56);
+    memcpy(to, &val, sizeof(val));
+    break;
+  }
+  case sizeof(uint32): {
+    const uint32 val = rdb_netbuf_to_uint32(from) ^ (uint32(sign_flip) << 24);
+    memcpy(to, &val, sizeof(val));
+    break;
+  }
+  case sizeof(uint16): {
+    const uint16 val = rdb_netbuf_to_uint16(from) ^ (uint16(sign_flip) << 8);
+    memcpy(to, &val, sizeof(val));
+    break;
+  }
+  default:
+    // TINYINT and MEDIUMINT
+    to[length - 1] = from[0] ^ sign_flip;
+    for (uint i = 0, j = length - 1; i < length - 1; ++i, --j)
+      to[i] = from[j];
+  }
+}
+#endif
+
 /*
   Basic network buffer ("netbuf") read helper functions.
   Network buffer stores data in Network Byte Order (Big Endian).
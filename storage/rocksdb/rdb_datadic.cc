@@ -609,6 +609,38 @@ int Rdb_key_def::read_memcmp_key_part(const TABLE *table_arg,
   return 0;
 }
 
+/**
+  Add the tombstones skipped and the rows read by a scan of the index to the
+  counts of the index.
+
+  @return
+    true   the scans skipped at least threshold tombstones, which made up at
+           least density_pct percent of the keys they visited: the caller
+           should compact the index
+    false  otherwise
+
+  @note
+    The counts restart each time they reach the threshold, so that the
+    density reflects the recent scans of the index.
+*/
+bool Rdb_key_def::record_scan(const uint64 tombstones, const uint64 rows,
+                              const uint64 threshold,
+                              const uint density_pct) const {
+  const uint64 scan_tombstones = m_scan_tombstones += tombstones;
+  const uint64 scan_rows = m_scan_rows += rows;
+  if (scan_tombstones < threshold) {
+    return false;
+  }
+
+  // Only one of the scans which reach the threshold checks the density
+  if (m_scan_tombstones.exchange(0) < threshold) {
+    return false;
+  }
+  m_scan_rows = 0;
+
+  return scan_tombstones * 100 >= (scan_tombstones + scan_rows) * density_pct;
+}
+
 /**
   Get a mem-comparable form of Primary Key from mem-comparable form of this key
 
@@ -1379,6 +1411,9 @@ int Rdb_key_def::unpack_field(
   @detail
     not all indexes support this
 
+    Key parts in parts_to_skip are skipped over instead of being unpacked,
+    unless they use unpack_info, which has to be read in order.
+
   @return
     HA_EXIT_SUCCESS    OK
     other              HA_ERR error code
@@ -1387,7 +1422,8 @@ int Rdb_key_def::unpack_field(
 int Rdb_key_def::unpack_record(TABLE *const table, uchar *const buf,
                                const rocksdb::Slice *const packed_key,
                                const rocksdb::Slice *const unpack_info,
-                               const bool &verify_row_debug_checksums) const {
+                               const bool &verify_row_debug_checksums,
+                               const key_part_map parts_to_skip) const {
   Rdb_string_reader reader(packed_key);
   Rdb_string_reader unp_reader = Rdb_string_reader::read_or_empty(unpack_info);
 
@@ -1457,7 +1493,9 @@ int Rdb_key_def::unpack_record(TABLE *const table, uchar *const buf,
       covered_column = curr_bitmap_pos < MAX_REF_PARTS &&
                        bitmap_is_set(&covered_bitmap, curr_bitmap_pos++);
     }
-    if (fpi->m_unpack_func && covered_column) {
+    const bool skip_column = (parts_to_skip & (key_part_map(1) << i)) &&
+                             !fpi->uses_unpack_info();
+    if (fpi->m_unpack_func && covered_column && !skip_column) {
       /* It is possible to unpack this column. Do it. */
 
       uint field_offset = field->ptr - table->record[0];
@@ -1486,7 +1524,7 @@ int Rdb_key_def::unpack_record(TABLE *const table, uchar *const buf,
         return HA_ERR_ROCKSDB_CORRUPT_DATA;
       }
     } else {
-      /* It is impossible to unpack the column. Skip it. */
+      /* It is impossible or not needed to unpack the column. Skip it. */
       if (fpi->m_maybe_null) {
         const char *nullp;
         if (!(nullp = reader.read(1)))
@@ -1737,16 +1775,8 @@ int Rdb_key_def::unpack_integer(
     memcpy(to + 1, from + 1, length - 1);
   }
 #else
-  {
-    const int sign_byte = from[0];
-    if (((Field_num *)field)->unsigned_flag)
-      to[length - 1] = sign_byte;
-    else
-      to[length - 1] =
-          static_cast<char>(sign_byte ^ 128); // Reverse the sign bit.
-    for (int i = 0, j = length - 1; i < length - 1; ++i, --j)
-      to[i] = from[j];
-  }
+  rdb_unpack_integer_image(to, from, length,
+                           ((Field_num *)field)->unsigned_flag);
 #endif
   return UNPACK_SUCCESS;
 }
@@ -4103,6 +4133,14 @@ void Rdb_ddl_manager::adjust_stats(
   }
 }
 
+std::shared_ptr<const Rdb_index_histogram>
+Rdb_ddl_manager::get_histogram(const Rdb_key_def &kd) {
+  mysql_rwlock_rdlock(&m_rwlock);
+  const auto histogram = kd.m_stats.m_histogram;
+  mysql_rwlock_unlock(&m_rwlock);
+  return histogram;
+}
+
 void Rdb_ddl_manager::persist_stats(const bool &sync) {
   mysql_rwlock_wrlock(&m_rwlock);
   const auto local_stats2store = std::move(m_stats2store);
@@ -4661,6 +4699,7 @@ void Rdb_dict_manager::delete_index_info(rocksdb::WriteBatch *batch,
   delete_with_prefix(batch, Rdb_key_def::INDEX_INFO, gl_index_id);
   delete_with_prefix(batch, Rdb_key_def::INDEX_STATISTICS, gl_index_id);
   delete_with_prefix(batch, Rdb_key_def::AUTO_INC, gl_index_id);
+  delete_with_prefix(batch, Rdb_key_def::INDEX_HISTOGRAM, gl_index_id);
 }
 
 bool Rdb_dict_manager::get_index_info(
@@ -5142,6 +5181,18 @@ void Rdb_dict_manager::add_stats(
 
     batch->Put(m_system_cfh, rocksdb::Slice((char *)key_buf, sizeof(key_buf)),
                value);
+
+    // The histogram has its own key, so that older versions can still read
+    // the stats
+    dump_index_id(key_buf, Rdb_key_def::INDEX_HISTOGRAM, it.m_gl_index_id);
+    const rocksdb::Slice hist_key((char *)key_buf, sizeof(key_buf));
+    if (it.m_histogram != nullptr) {
+      batch->Put(m_system_cfh, hist_key,
+                 Rdb_index_stats::materialize_histograms(
+                     std::vector<Rdb_index_stats>{it}));
+    } else {
+      batch->Delete(m_system_cfh, hist_key);
+    }
   }
 }
 
@@ -5157,6 +5208,14 @@ Rdb_index_stats Rdb_dict_manager::get_stats(GL_INDEX_ID gl_index_id) const {
     std::vector<Rdb_index_stats> v;
     // unmaterialize checks if the version matches
     if (Rdb_index_stats::unmaterialize(value, &v) == 0 && v.size() == 1) {
+      dump_index_id(key_buf, Rdb_key_def::INDEX_HISTOGRAM, gl_index_id);
+      if (get_value(rocksdb::Slice(reinterpret_cast<char *>(key_buf),
+                                   sizeof(key_buf)),
+                    &value)
+              .ok() &&
+          Rdb_index_stats::unmaterialize_histograms(value, &v)) {
+        v[0].m_histogram = nullptr;
+      }
       return v[0];
     }
   }
@@ -212,7 +212,8 @@ public:
   int unpack_record(TABLE *const table, uchar *const buf,
                     const rocksdb::Slice *const packed_key,
                     const rocksdb::Slice *const unpack_info,
-                    const bool &verify_row_debug_checksums) const;
+                    const bool &verify_row_debug_checksums,
+                    const key_part_map parts_to_skip = 0) const;
 
   static bool unpack_info_has_checksum(const rocksdb::Slice &unpack_info);
   int compare_keys(const rocksdb::Slice *key1, const rocksdb::Slice *key2,
@@ -300,6 +301,9 @@ public:
     return gl_index_id;
   }
 
+  bool record_scan(const uint64 tombstones, const uint64 rows,
+                   const uint64 threshold, const uint density_pct) const;
+
   int read_memcmp_key_part(const TABLE *table_arg, Rdb_string_reader *reader,
                            const uint part_num) const;
 
@@ -390,6 +394,7 @@ public:
     MAX_INDEX_ID = 7,
     DDL_CREATE_INDEX_ONGOING = 8,
     AUTO_INC = 9,
+    INDEX_HISTOGRAM = 10,
     END_DICT_INDEX_ID = 255
   };
 
@@ -689,6 +694,13 @@ public:
   std::string m_name;
   mutable Rdb_index_stats m_stats;
 
+  /*
+    Tombstones skipped and rows read by the scans of the index since the
+    tombstone density was last checked, see record_scan()
+  */
+  mutable std::atomic<uint64> m_scan_tombstones{0};
+  mutable std::atomic<uint64> m_scan_rows{0};
+
   /*
     Bitmap containing information about whether TTL or other special fields
     are enabled for the given index.
@@ -1089,6 +1101,9 @@ public:
                     const std::vector<Rdb_index_stats> &deleted_data =
                         std::vector<Rdb_index_stats>());
   void persist_stats(const bool &sync = false);
+  /* The histogram of the keys of an index, which can change at any time */
+  std::shared_ptr<const Rdb_index_histogram>
+  get_histogram(const Rdb_key_def &kd);
 
   /* Modify the mapping and write it to on-disk storage */
   int put_and_write(Rdb_tbl_def *const key_descr,
@@ -1225,6 +1240,10 @@ private:
   value: version, {max auto_increment so far}
   max auto_increment is 8 bytes
 
+  10. index key histograms
+  key: Rdb_key_def::INDEX_HISTOGRAM(0xa) + cf_id + index_id
+  value: version, {materialized histogram of PropertiesCollector::IndexStats}
+
   Data dictionary operations are atomic inside RocksDB. For example,
   when creating a table with two indexes, it is necessary to call Put
   three times. They have to be atomic. Rdb_dict_manager has a wrapper function
@@ -26,6 +26,11 @@
 
 namespace myrocks {
 
+#ifndef DBUG_OFF
+std::atomic<ulonglong> Rdb_index_merge::s_buf_bytes(0);
+std::atomic<ulonglong> Rdb_index_merge::s_peak_buf_bytes(0);
+#endif
+
 Rdb_index_merge::Rdb_index_merge(const char *const tmpfile_path,
                                  const ulonglong &merge_buf_size,
                                  const ulonglong &merge_combine_read_size,
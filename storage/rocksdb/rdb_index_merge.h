@@ -22,6 +22,7 @@
 #include "./my_global.h" /* ulonglong */
 
 /* C++ standard header files */
+#include <atomic>
 #include <queue>
 #include <set>
 #include <vector>
@@ -95,7 +96,19 @@ class Rdb_index_merge {
 
       /* Initialize entire buffer to 0 to avoid valgrind errors */
       memset(m_block.get(), 0, merge_block_size);
+
+#ifndef DBUG_OFF
+      const ulonglong bytes = s_buf_bytes += merge_block_size;
+      ulonglong peak = s_peak_buf_bytes;
+      while (bytes > peak &&
+             !s_peak_buf_bytes.compare_exchange_weak(peak, bytes)) {
+      }
+#endif
     }
+
+#ifndef DBUG_OFF
+    ~merge_buf_info() { s_buf_bytes -= m_block_len; }
+#endif
   };
 
   /* Represents an entry in the heap during merge phase of external sort */
@@ -219,6 +232,17 @@ class Rdb_index_merge {
   void merge_reset();
 
   rocksdb::ColumnFamilyHandle *get_cf() const { return m_cf_handle; }
+
+#ifndef DBUG_OFF
+  /*
+    Bytes of the merge buffers allocated by all the merges, and the most of
+    them allocated at once since reset_peak_buf_bytes()
+  */
+  static std::atomic<ulonglong> s_buf_bytes;
+  static std::atomic<ulonglong> s_peak_buf_bytes;
+
+  static void reset_peak_buf_bytes() { s_peak_buf_bytes = s_buf_bytes.load(); }
+#endif
 };
 
 }  // namespace myrocks
@@ -0,0 +1,187 @@
+/*
+   Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/* This C++ file's header file */
+#include "./rdb_parallel_scan.h"
+
+/* C++ standard header files */
+#include <algorithm>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+/* MySQL header files */
+#include "./my_pthread.h"
+
+/* MyRocks header files */
+#include "./rdb_datadic.h"
+
+namespace myrocks {
+
+Rdb_parallel_scan::Rdb_parallel_scan(rocksdb::DB *const db,
+                                     const Rdb_key_def &kd,
+                                     const rocksdb::Snapshot *const snapshot)
+    : m_db(db), m_kd(kd), m_snapshot(snapshot), m_next_range(0),
+      m_abort(false), m_res(HA_EXIT_SUCCESS) {
+  DBUG_ASSERT(m_db != nullptr);
+  DBUG_ASSERT(m_snapshot != nullptr);
+
+  split(1);
+}
+
+void Rdb_parallel_scan::split(const uint n_ranges) {
+  uchar first_key[Rdb_key_def::INDEX_NUMBER_SIZE];
+  uint first_key_size;
+  m_kd.get_first_key(first_key, &first_key_size);
+
+  m_starts.clear();
+  m_starts.emplace_back(reinterpret_cast<const char *>(first_key),
+                        first_key_size);
+
+  if (n_ranges <= 1) {
+    return;
+  }
+
+  rocksdb::ColumnFamilyHandle *const cf = m_kd.get_cf();
+  const rocksdb::Comparator *const cmp = cf->GetComparator();
+
+  /*
+    Collect the first key and the size of the SST files which start inside
+    the index. smallestkey is in the order of the column family, so it is
+    the largest key of the file in reverse column families.
+  */
+  std::vector<rocksdb::LiveFileMetaData> files;
+  m_db->GetLiveFilesMetaData(&files);
+
+  std::vector<std::pair<std::string, uint64_t>> file_starts;
+  uint64_t total_size = 0;
+  for (const auto &file : files) {
+    if (file.column_family_name == cf->GetName() &&
+        m_kd.covers_key(file.smallestkey)) {
+      file_starts.emplace_back(file.smallestkey, file.size);
+      total_size += file.size;
+    }
+  }
+
+  std::sort(file_starts.begin(), file_starts.end(),
+            [cmp](const std::pair<std::string, uint64_t> &a,
+                  const std::pair<std::string, uint64_t> &b) {
+              return cmp->Compare(a.first, b.first) < 0;
+            });
+
+  /*
+    Start a new range at the first file past each n_ranges-th of the total
+    size. The first range also holds the data of the files which start
+    before the index, and of the memtables.
+  */
+  uint64_t size = 0;
+  for (const auto &file_start : file_starts) {
+    if (m_starts.size() == n_ranges) {
+      break;
+    }
+
+    if (size * n_ranges >= total_size * m_starts.size() &&
+        cmp->Compare(file_start.first, m_starts.back()) > 0) {
+      m_starts.push_back(file_start.first);
+    }
+    size += file_start.second;
+  }
+}
+
+void Rdb_parallel_scan::set_error(const int res, const rocksdb::Status &s) {
+  const std::lock_guard<std::mutex> lock(m_error_mutex);
+
+  if (m_res == HA_EXIT_SUCCESS) {
+    m_res = res;
+    m_status = s;
+  }
+  m_abort.store(true);
+}
+
+void Rdb_parallel_scan::scan_range(const uint range, const uint thread_no,
+                                   const row_callback &fn) {
+  rocksdb::ReadOptions read_opts;
+  read_opts.snapshot = m_snapshot;
+  read_opts.total_order_seek = true;
+
+  const std::unique_ptr<rocksdb::Iterator> it(
+      m_db->NewIterator(read_opts, m_kd.get_cf()));
+  const rocksdb::Comparator *const cmp = m_kd.get_cf()->GetComparator();
+  const bool is_last = range + 1 == m_starts.size();
+
+  for (it->Seek(m_starts[range]); it->Valid(); it->Next()) {
+    if (m_abort.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    const rocksdb::Slice key = it->key();
+    if (!m_kd.covers_key(key) ||
+        (!is_last && cmp->Compare(key, m_starts[range + 1]) >= 0)) {
+      break;
+    }
+
+    const int res = fn(thread_no, key, it->value());
+    if (res != HA_EXIT_SUCCESS) {
+      set_error(res, rocksdb::Status::OK());
+      return;
+    }
+  }
+
+  if (!it->status().ok()) {
+    set_error(HA_EXIT_FAILURE, it->status());
+  }
+}
+
+void Rdb_parallel_scan::scan_ranges(const uint thread_no,
+                                    const row_callback &fn) {
+  uint range;
+  while (!m_abort.load(std::memory_order_relaxed) &&
+         (range = m_next_range.fetch_add(1)) < m_starts.size()) {
+    scan_range(range, thread_no, fn);
+  }
+}
+
+int Rdb_parallel_scan::scan(const uint n_threads, const row_callback &fn) {
+  m_next_range = 0;
+  m_abort = false;
+  m_res = HA_EXIT_SUCCESS;
+  m_status = rocksdb::Status::OK();
+
+  std::vector<std::thread> threads;
+  for (uint i = 1; i < std::min<uint>(n_threads, m_starts.size()); i++) {
+    try {
+      threads.emplace_back([this, i, &fn]() {
+        my_thread_init();
+        scan_ranges(i, fn);
+        my_thread_end();
+      });
+    } catch (const std::system_error &) {
+      // The ranges left over are scanned by the threads already started
+      break;
+    }
+  }
+
+  scan_ranges(0, fn);
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  return m_res;
+}
+
+} // namespace myrocks
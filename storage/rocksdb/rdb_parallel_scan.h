@@ -0,0 +1,102 @@
+/*
+   Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+#pragma once
+
+/* C++ standard header files */
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* MySQL header files */
+#include "./my_global.h"
+
+/* RocksDB header files */
+#include "rocksdb/db.h"
+
+/* MyRocks header files */
+#include "./rdb_utils.h"
+
+namespace myrocks {
+
+class Rdb_key_def;
+
+/*
+  Full scan of one index by several threads.
+
+  The key space of the index is split into sub-ranges at the start keys of
+  the SST files holding the index, so that the ranges hold about the same
+  amount of data. Each thread then scans one range at a time with its own
+  iterator, all iterators reading the same snapshot.
+*/
+class Rdb_parallel_scan {
+  Rdb_parallel_scan(const Rdb_parallel_scan &p) = delete;
+  Rdb_parallel_scan &operator=(const Rdb_parallel_scan &p) = delete;
+
+ public:
+  /*
+    Called for each entry of the index, by the thread number thread_no
+    (0 is the calling thread). A non-zero return value stops the scan, and
+    is returned by scan().
+  */
+  typedef std::function<int(uint thread_no, const rocksdb::Slice &key,
+                            const rocksdb::Slice &value)>
+      row_callback;
+
+  Rdb_parallel_scan(rocksdb::DB *const db, const Rdb_key_def &kd,
+                    const rocksdb::Snapshot *const snapshot);
+
+  /* Split the index into at most n_ranges sub-ranges */
+  void split(const uint n_ranges);
+  uint get_n_ranges() const { return m_starts.size(); }
+
+  /*
+    Scan the sub-ranges with up to n_threads threads, the calling thread
+    included.
+
+    @return
+      HA_EXIT_SUCCESS  OK
+      HA_EXIT_FAILURE  Reading the index failed, see get_status()
+      other            Error returned by fn
+  */
+  int scan(const uint n_threads, const row_callback &fn);
+  const rocksdb::Status &get_status() const { return m_status; }
+
+ private:
+  void scan_range(const uint range, const uint thread_no,
+                  const row_callback &fn);
+  void scan_ranges(const uint thread_no, const row_callback &fn);
+  void set_error(const int res, const rocksdb::Status &s);
+
+  rocksdb::DB *const m_db;
+  const Rdb_key_def &m_kd;
+  const rocksdb::Snapshot *const m_snapshot;
+
+  /* First key of each range, in the order of the column family */
+  std::vector<std::string> m_starts;
+
+  std::atomic<uint> m_next_range;
+  std::atomic<bool> m_abort;
+
+  /* First error of the scan threads, protected by m_error_mutex */
+  std::mutex m_error_mutex;
+  int m_res;
+  rocksdb::Status m_status;
+};
+
+} // namespace myrocks
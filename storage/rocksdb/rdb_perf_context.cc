@@ -271,6 +271,16 @@ void Rdb_io_perf::end_and_record(const uint32_t perf_context_level) {
       m_stats->delete_skipped +=
           rocksdb::get_perf_context()->internal_delete_skipped_count;
     }
+
+    m_stats->block_cache_hit +=
+        rocksdb::get_perf_context()->block_cache_hit_count;
+    m_stats->bloom_filter_useful +=
+        rocksdb::get_perf_context()->bloom_sst_miss_count;
+    m_stats->key_compared +=
+        rocksdb::get_perf_context()->user_key_comparison_count;
+    m_stats->bytes_read += rocksdb::get_perf_context()->get_read_bytes +
+                           rocksdb::get_perf_context()->multiget_read_bytes +
+                           rocksdb::get_perf_context()->iter_read_bytes;
   }
 }
 
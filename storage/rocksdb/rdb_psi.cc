@@ -38,15 +38,19 @@ my_core::PSI_stage_info stage_waiting_on_row_lock = {0, "Waiting for row lock",
 my_core::PSI_stage_info *all_rocksdb_stages[] = {&stage_waiting_on_row_lock};
 
 my_core::PSI_thread_key rdb_background_psi_thread_key,
-    rdb_drop_idx_psi_thread_key;
+    rdb_drop_idx_psi_thread_key, rdb_tombstone_psi_thread_key,
+    rdb_controller_psi_thread_key;
 
 my_core::PSI_thread_info all_rocksdb_threads[] = {
     {&rdb_background_psi_thread_key, "background", PSI_FLAG_GLOBAL},
     {&rdb_drop_idx_psi_thread_key, "drop index", PSI_FLAG_GLOBAL},
+    {&rdb_tombstone_psi_thread_key, "tombstone compaction", PSI_FLAG_GLOBAL},
+    {&rdb_controller_psi_thread_key, "compaction controller", PSI_FLAG_GLOBAL},
 };
 
 my_core::PSI_mutex_key rdb_psi_open_tbls_mutex_key, rdb_signal_bg_psi_mutex_key,
-    rdb_signal_drop_idx_psi_mutex_key, rdb_collation_data_mutex_key,
+    rdb_signal_drop_idx_psi_mutex_key, rdb_signal_tombstone_psi_mutex_key,
+    rdb_signal_controller_psi_mutex_key, rdb_collation_data_mutex_key,
     rdb_mem_cmp_space_mutex_key, key_mutex_tx_list, rdb_sysvars_psi_mutex_key,
     rdb_cfm_mutex_key;
 
@@ -54,6 +58,10 @@ my_core::PSI_mutex_info all_rocksdb_mutexes[] = {
     {&rdb_psi_open_tbls_mutex_key, "open tables", PSI_FLAG_GLOBAL},
     {&rdb_signal_bg_psi_mutex_key, "stop background", PSI_FLAG_GLOBAL},
     {&rdb_signal_drop_idx_psi_mutex_key, "signal drop index", PSI_FLAG_GLOBAL},
+    {&rdb_signal_tombstone_psi_mutex_key, "signal tombstone compaction",
+     PSI_FLAG_GLOBAL},
+    {&rdb_signal_controller_psi_mutex_key, "signal compaction controller",
+     PSI_FLAG_GLOBAL},
     {&rdb_collation_data_mutex_key, "collation data init", PSI_FLAG_GLOBAL},
     {&rdb_mem_cmp_space_mutex_key, "collation space char data init",
      PSI_FLAG_GLOBAL},
@@ -74,12 +82,17 @@ my_core::PSI_rwlock_info all_rocksdb_rwlocks[] = {
 };
 
 my_core::PSI_cond_key rdb_signal_bg_psi_cond_key,
-    rdb_signal_drop_idx_psi_cond_key;
+    rdb_signal_drop_idx_psi_cond_key, rdb_signal_tombstone_psi_cond_key,
+    rdb_signal_controller_psi_cond_key;
 
 my_core::PSI_cond_info all_rocksdb_conds[] = {
     {&rdb_signal_bg_psi_cond_key, "cond signal background", PSI_FLAG_GLOBAL},
     {&rdb_signal_drop_idx_psi_cond_key, "cond signal drop index",
      PSI_FLAG_GLOBAL},
+    {&rdb_signal_tombstone_psi_cond_key, "cond signal tombstone compaction",
+     PSI_FLAG_GLOBAL},
+    {&rdb_signal_controller_psi_cond_key, "cond signal compaction controller",
+     PSI_FLAG_GLOBAL},
 };
 
 void init_rocksdb_psi_keys() {
@@ -319,7 +319,8 @@ Rdb_sst_info::Rdb_sst_info(rocksdb::DB *const db, const std::string &tablename,
 #if defined(RDB_SST_INFO_USE_THREAD)
       m_queue(), m_mutex(), m_cond(), m_thread(nullptr), m_finished(false),
 #endif
-      m_sst_file(nullptr), m_tracing(tracing), m_print_client_error(true) {
+      m_sst_file(nullptr), m_tracing(tracing), m_print_client_error(true),
+      m_defer_error_msg(false), m_error_code(0) {
   m_prefix = db->GetName() + "/";
 
   std::string normalized_table;
@@ -480,6 +481,37 @@ int Rdb_sst_info::commit(bool print_client_error) {
   return ret;
 }
 
+/*
+  Remove the sst file being written instead of adding it to the database. The
+  files which were already closed out have been added.
+*/
+void Rdb_sst_info::abort() {
+#if defined(RDB_SST_INFO_USE_THREAD)
+  if (m_thread != nullptr) {
+    {
+      // Drop the files the background thread has not added yet
+      const std::lock_guard<std::mutex> guard(m_mutex);
+      while (!m_queue.empty()) {
+        delete m_queue.front();
+        m_queue.pop();
+      }
+      m_finished = true;
+    }
+    m_cond.notify_one();
+
+    m_thread->join();
+    delete m_thread;
+    m_thread = nullptr;
+  }
+#endif
+
+  // The file is removed when it is deleted without being committed
+  delete m_sst_file;
+  m_sst_file = nullptr;
+  m_curr_size = 0;
+  get_and_reset_background_error();
+}
+
 void Rdb_sst_info::set_error_msg(const std::string &sst_file_name,
                                  const rocksdb::Status &s) {
 
@@ -492,21 +524,41 @@ void Rdb_sst_info::set_error_msg(const std::string &sst_file_name,
   // we encounter.
   const std::lock_guard<std::mutex> guard(m_mutex);
 #endif
+  uint code;
+  std::string msg;
   if (s.IsInvalidArgument() &&
       strcmp(s.getState(), "Keys must be added in order") == 0) {
-    my_printf_error(ER_KEYS_OUT_OF_ORDER,
-                    "Rows must be inserted in primary key order "
-                    "during bulk load operation",
-                    MYF(0));
+    code = ER_KEYS_OUT_OF_ORDER;
+    msg = "Rows must be inserted in primary key order "
+          "during bulk load operation";
   } else if (s.IsInvalidArgument() &&
              strcmp(s.getState(), "Global seqno is required, but disabled") ==
                  0) {
-    my_printf_error(ER_OVERLAPPING_KEYS, "Rows inserted during bulk load "
-                                         "must not overlap existing rows",
-                    MYF(0));
+    code = ER_OVERLAPPING_KEYS;
+    msg = "Rows inserted during bulk load must not overlap existing rows";
   } else {
-    my_printf_error(ER_UNKNOWN_ERROR, "[%s] bulk load error: %s", MYF(0),
-                    sst_file_name.c_str(), s.ToString().c_str());
+    code = ER_UNKNOWN_ERROR;
+    msg = "[" + sst_file_name + "] bulk load error: " + s.ToString();
+  }
+
+  if (m_defer_error_msg) {
+    // Not on the client connection's thread: keep the first error for
+    // report_error_msg()
+    if (m_error_code == 0) {
+      m_error_code = code;
+      m_error_msg = msg;
+    }
+    return;
+  }
+
+  my_printf_error(code, "%s", MYF(0), msg.c_str());
+}
+
+void Rdb_sst_info::report_error_msg() {
+  if (m_error_code != 0) {
+    my_printf_error(m_error_code, "%s", MYF(0), m_error_msg.c_str());
+    m_error_code = 0;
+    m_error_msg.clear();
   }
 }
 
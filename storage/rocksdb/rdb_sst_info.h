@@ -138,6 +138,9 @@ class Rdb_sst_info {
   Rdb_sst_file_ordered *m_sst_file;
   const bool m_tracing;
   bool m_print_client_error;
+  bool m_defer_error_msg;
+  uint m_error_code;
+  std::string m_error_msg;
 
   int open_new_sst_file();
   void close_curr_sst_file();
@@ -159,6 +162,16 @@ class Rdb_sst_info {
 
   int put(const rocksdb::Slice &key, const rocksdb::Slice &value);
   int commit(bool print_client_error = true);
+  void abort();
+
+  /*
+    Used when the sst files are written by a thread other than the one of
+    the client connection: the first error message is kept instead of being
+    sent to the client, until report_error_msg() is called by the client
+    connection's thread.
+  */
+  void defer_error_msg() { m_defer_error_msg = true; }
+  void report_error_msg();
 
   bool have_background_error() { return m_background_error != 0; }
 
@@ -18,6 +18,7 @@
 
 /* C++ standard header files */
 #include <string>
+#include <unordered_set>
 
 /* MySQL includes */
 #include "./my_global.h"
@@ -25,6 +26,7 @@
 #include <mysql/thread_pool_priv.h>
 
 /* MyRocks header files */
+#include "./ha_rocksdb.h"
 #include "./rdb_utils.h"
 
 namespace myrocks {
@@ -137,4 +139,53 @@ struct Rdb_drop_index_thread : public Rdb_thread {
   virtual void run() override;
 };
 
+/*
+  Compaction of the indexes whose scans skip too many tombstones
+*/
+
+class Rdb_tombstone_compaction_thread : public Rdb_thread {
+private:
+  /* Indexes to compact, protected by m_signal_mutex */
+  std::unordered_set<GL_INDEX_ID> m_requests;
+
+public:
+  virtual void run() override;
+
+  void request_compaction(const GL_INDEX_ID &gl_index_id) {
+    RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
+
+    m_requests.insert(gl_index_id);
+    mysql_cond_signal(&m_signal_cond);
+
+    RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
+  }
+};
+
+/*
+  Controller which slows the compactions down while the latency of the
+  foreground reads and commits is above target
+*/
+
+class Rdb_compaction_controller_thread : public Rdb_thread {
+private:
+  /* Compaction rate limit and background jobs currently applied */
+  std::atomic<uint64_t> m_rate_limit{0};
+  std::atomic<int> m_background_jobs{0};
+
+  /*
+    rocksdb_rate_limiter_bytes_per_sec and rocksdb_max_background_jobs as
+    of the last adjustment, protected by rdb_sysvars_mutex
+  */
+  uint64_t m_max_rate_limit = 0;
+  int m_max_background_jobs = 0;
+
+  void adjust();
+
+public:
+  virtual void run() override;
+
+  uint64_t get_rate_limit() const { return m_rate_limit; }
+  int get_background_jobs() const { return m_background_jobs; }
+};
+
 } // namespace myrocks
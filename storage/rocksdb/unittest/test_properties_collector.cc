@@ -30,6 +30,84 @@ void putKeys(myrocks::Rdb_tbl_prop_coll *coll, int num, bool is_delete,
   DBUG_ASSERT(coll->GetMaxDeletedRows() == expected_deleted);
 }
 
+// test the histograms of the keys, and their serialization
+void testHistogram() {
+  myrocks::Rdb_tbl_hist_coll hist_coll;
+  myrocks::Rdb_index_stats stats({1, 2});
+  const int num = 1000;
+  char key[4];
+  for (int i = 0; i < num; i++) {
+    myrocks::rdb_netbuf_store_uint32(reinterpret_cast<uchar *>(key), i);
+    hist_coll.ProcessKey(rocksdb::Slice(key, sizeof(key)));
+  }
+  hist_coll.Finish(&stats);
+  DBUG_ASSERT(stats.m_histogram != nullptr);
+  DBUG_ASSERT(stats.m_histogram->m_points.size() <=
+              myrocks::Rdb_index_histogram::MAX_POINTS);
+  DBUG_ASSERT(stats.m_histogram->total_rows() == num);
+
+  // a quarter of the keys, within one point
+  char lower[4], upper[4];
+  myrocks::rdb_netbuf_store_uint32(reinterpret_cast<uchar *>(lower), num / 4);
+  myrocks::rdb_netbuf_store_uint32(reinterpret_cast<uchar *>(upper), num / 2);
+  const double rows MY_ATTRIBUTE((__unused__)) =
+      stats.m_histogram->rows_in_range(rocksdb::Slice(lower, sizeof(lower)),
+                                       rocksdb::Slice(upper, sizeof(upper)));
+  DBUG_ASSERT(rows > num / 4 - num / 32 && rows < num / 4 + num / 32);
+
+  // a single key, interpolated inside its point
+  myrocks::rdb_netbuf_store_uint32(reinterpret_cast<uchar *>(lower), 100);
+  myrocks::rdb_netbuf_store_uint32(reinterpret_cast<uchar *>(upper), 101);
+  const double key_rows MY_ATTRIBUTE((__unused__)) =
+      stats.m_histogram->rows_in_range(rocksdb::Slice(lower, sizeof(lower)),
+                                       rocksdb::Slice(upper, sizeof(upper)));
+  DBUG_ASSERT(key_rows > 0.5 && key_rows < 1.5);
+
+  // keys in descending order, as in reverse column families, give the same
+  // points, keyed by the lowest key of their rows
+  myrocks::Rdb_tbl_hist_coll rev_coll;
+  myrocks::Rdb_index_stats rev_stats({1, 3});
+  rev_coll.Reset(true);
+  for (int i = num - 1; i >= 0; i--) {
+    myrocks::rdb_netbuf_store_uint32(reinterpret_cast<uchar *>(key), i);
+    rev_coll.ProcessKey(rocksdb::Slice(key, sizeof(key)));
+  }
+  rev_coll.Finish(&rev_stats);
+  DBUG_ASSERT(rev_stats.m_histogram != nullptr);
+  DBUG_ASSERT(rev_stats.m_histogram->m_points.size() ==
+              stats.m_histogram->m_points.size());
+  for (size_t i = 0; i < stats.m_histogram->m_points.size(); i++) {
+    DBUG_ASSERT(rev_stats.m_histogram->m_points[i].m_key ==
+                stats.m_histogram->m_points[i].m_key);
+    DBUG_ASSERT(rev_stats.m_histogram->m_points[i].m_rows ==
+                stats.m_histogram->m_points[i].m_rows);
+  }
+
+  // merging doubles the rows, but keeps the number of points
+  const auto merged =
+      myrocks::Rdb_index_histogram::merge(stats.m_histogram, *stats.m_histogram);
+  DBUG_ASSERT(merged->total_rows() == 2 * num);
+  DBUG_ASSERT(merged->m_points.size() <=
+              myrocks::Rdb_index_histogram::MAX_POINTS);
+
+  // the stats keep their old format, the histograms are read apart
+  std::vector<myrocks::Rdb_index_stats> read_stats;
+  int res MY_ATTRIBUTE((__unused__)) =
+      myrocks::Rdb_index_stats::unmaterialize(
+          myrocks::Rdb_index_stats::materialize({stats}), &read_stats);
+  DBUG_ASSERT(res == HA_EXIT_SUCCESS);
+  DBUG_ASSERT(read_stats.size() == 1);
+  DBUG_ASSERT(read_stats[0].m_histogram == nullptr);
+  res = myrocks::Rdb_index_stats::unmaterialize_histograms(
+      myrocks::Rdb_index_stats::materialize_histograms({rev_stats, stats}),
+      &read_stats);
+  DBUG_ASSERT(res == HA_EXIT_SUCCESS);
+  DBUG_ASSERT(read_stats[0].m_histogram != nullptr);
+  DBUG_ASSERT(read_stats[0].m_histogram->m_points.size() ==
+              stats.m_histogram->m_points.size());
+  DBUG_ASSERT(read_stats[0].m_histogram->total_rows() == num);
+}
+
 int main(int argc, char **argv) {
   // test the circular buffer for delete flags
   myrocks::Rdb_compact_params params;
@@ -50,5 +128,7 @@ int main(int argc, char **argv) {
   putKeys(&coll, 100, true, 10); // ....[xxxxxxxxxx]
   putKeys(&coll, 100, true, 10); // ....[oooooooooo]
 
+  testHistogram();
+
   return 0;
 }
@@ -0,0 +1,136 @@
+/*
+   Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/*
+  Microbenchmark of the unpacking of integer key parts, for a few common
+  primary keys. The byte swapping kernel is checked against the byte by byte
+  version it replaces. Pass the number of keys to decode as the first
+  argument.
+*/
+
+/* C++ standard header files */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/* MyRocks header files */
+#include "../ha_rocksdb.h"
+#include "../rdb_buff.h"
+
+namespace {
+
+struct schema {
+  const char *m_name;
+  /* Widths of the columns, in bytes */
+  std::vector<uint> m_widths;
+};
+
+const schema key_schemas[] = {
+    {"sbtest PK (INT)", {4}},
+    {"linktable PK (BIGINT, BIGINT, BIGINT)", {8, 8, 8}},
+    {"mixed PK (TINYINT, SMALLINT, MEDIUMINT, INT, BIGINT)", {1, 2, 3, 4, 8}},
+};
+
+/* The byte by byte unpacking of integers, as done before */
+void unpack_integer_bytes(uchar *const to, const uchar *const from,
+                          const uint length, const bool unsigned_flag) {
+  const int sign_byte = from[0];
+  if (unsigned_flag)
+    to[length - 1] = sign_byte;
+  else
+    to[length - 1] = static_cast<char>(sign_byte ^ 128);
+  for (int i = 0, j = length - 1; i < static_cast<int>(length) - 1; ++i, --j)
+    to[i] = from[j];
+}
+
+uint row_length(const schema &s) {
+  uint len = 0;
+  for (const uint width : s.m_widths) {
+    len += width;
+  }
+  return len;
+}
+
+std::vector<uchar> random_rows(const uint n_rows, const uint len) {
+  std::mt19937 gen(n_rows);
+  std::vector<uchar> rows(n_rows * len);
+  for (auto &b : rows) {
+    b = static_cast<uchar>(gen());
+  }
+  return rows;
+}
+
+template <typename F> double ns_per_row(const uint n_rows, F fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         n_rows;
+}
+
+bool bench_key(const schema &s, const uint n_rows) {
+  const uint len = row_length(s);
+  const std::vector<uchar> keys = random_rows(n_rows, len);
+  std::vector<uchar> out_bytes(keys.size());
+  std::vector<uchar> out_swap(keys.size());
+
+  const double bytes_ns = ns_per_row(n_rows, [&]() {
+    for (uint off = 0; off < keys.size(); off += len) {
+      uint pos = off;
+      for (const uint width : s.m_widths) {
+        unpack_integer_bytes(&out_bytes[pos], &keys[pos], width, pos & 1);
+        pos += width;
+      }
+    }
+  });
+
+  const double swap_ns = ns_per_row(n_rows, [&]() {
+    for (uint off = 0; off < keys.size(); off += len) {
+      uint pos = off;
+      for (const uint width : s.m_widths) {
+        myrocks::rdb_unpack_integer_image(&out_swap[pos], &keys[pos], width,
+                                          pos & 1);
+        pos += width;
+      }
+    }
+  });
+
+  fprintf(stdout, "%-55s byte loop %7.2f ns/row, byte swap %7.2f ns/row\n",
+          s.m_name, bytes_ns, swap_ns);
+  return out_bytes == out_swap;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+#if defined(WORDS_BIGENDIAN)
+  fprintf(stdout, "Skipped: integers are not byte swapped on this platform\n");
+  return 0;
+#else
+  const uint n_rows = argc > 1 ? atoi(argv[1]) : 1000000;
+
+  for (const auto &s : key_schemas) {
+    if (!bench_key(s, n_rows)) {
+      fprintf(stderr, "Integer unpacking mismatch for %s\n", s.m_name);
+      return 1;
+    }
+  }
+
+  return 0;
+#endif
+}
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "filesort_utils.h"
+#include "sql_sort.h"
 #include "table.h"
 
 namespace filesort_buffer_unittest {
@@ -86,4 +87,45 @@ TEST_F(FileSortBufferTest, AssignmentOperator)
 }
 
 
+/*
+  Sorts keys that share a prefix and are padded with spaces, as strings
+  are by make_sortkey(), in one thread and in several. Keys of 100 bytes
+  go through the MSD radix sort, keys of 24 bytes through std::stable_sort.
+*/
+TEST_F(FileSortBufferTest, SortBuffer)
+{
+  const uint num_records= 40000;
+  const uint record_lengths[]= { 24, 100 };
+  Sort_param param;
+  for (uint len= 0; len < array_elements(record_lengths); ++len)
+  {
+    const uint record_length= record_lengths[len];
+    param.sort_length= record_length;
+    for (uint threads= 1; threads <= 4; threads*= 4)
+    {
+      fs_info.alloc_sort_buffer(num_records, record_length);
+      fs_info.init_record_pointers();
+      for (uint ix= 0; ix < num_records; ++ix)
+      {
+        char *ptr= reinterpret_cast<char*>(fs_info.get_record_buffer(ix));
+        memset(ptr, ' ', record_length);
+        memcpy(ptr, "common prefix ", 14);
+        sprintf(ptr + 14, "%08u", (ix * 7919) % num_records);
+        ptr[22]= ' ';
+      }
+      param.sort_threads= threads;
+      fs_info.sort_buffer(&param, num_records);
+
+      uchar **keys= fs_info.get_sort_keys();
+      for (uint ix= 0; ix < num_records; ++ix)
+      {
+        char expected[9];
+        sprintf(expected, "%08u", ix);
+        EXPECT_EQ(0, memcmp(keys[ix] + 14, expected, 8));
+      }
+    }
+  }
+}
+
+
 }  // namespace
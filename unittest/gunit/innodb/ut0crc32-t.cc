@@ -0,0 +1,129 @@
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA */
+
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include "univ.i"
+#include "ut0crc32.h"
+
+#include <vector>
+
+namespace innodb_ut0crc32_unittest {
+
+/** Bytes in each stream of the long and short blocks of ut_crc32_sse42(),
+UT_CRC32_LONG and UT_CRC32_SHORT in ut0crc32.cc */
+const ulint	long_stream = 4096;
+const ulint	short_stream = 256;
+
+/* CRC-32C computed one bit at a time, which ut_crc32() must match. */
+ib_uint32_t
+crc32c_serial(const byte* buf, ulint len)
+{
+	ib_uint32_t	crc = 0xFFFFFFFF;
+
+	while (len--) {
+		crc ^= *buf++;
+		for (int k = 0; k < 8; k++) {
+			crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+		}
+	}
+
+	return(~crc);
+}
+
+class UtCrc32Test : public ::testing::Test
+{
+protected:
+	static void SetUpTestCase()
+	{
+		ut_crc32_init();
+	}
+
+	virtual void SetUp()
+	{
+		/* Room for two long blocks, their tail and a misalignment */
+		m_buf.resize(2 * 3 * long_stream + 3 * short_stream + 64);
+		ib_uint32_t	x = 1;
+		for (ulint i = 0; i < m_buf.size(); i++) {
+			x = x * 1103515245 + 12345;
+			m_buf[i] = static_cast<byte>(x >> 16);
+		}
+	}
+
+	/* Checks ut_crc32() against crc32c_serial() for the lengths
+	around n, at each alignment of the buffer. */
+	void check_around(ulint n)
+	{
+		for (ulint align = 0; align < 8; align++) {
+			const ulint	from = n > 9 ? n - 9 : 0;
+			for (ulint len = from; len <= n + 9; len++) {
+				ASSERT_LE(align + len, m_buf.size());
+				const byte*	p = &m_buf[align];
+				EXPECT_EQ(crc32c_serial(p, len), ut_crc32(p, len))
+					<< "length " << len
+					<< ", alignment " << align;
+			}
+		}
+	}
+
+	std::vector<byte>	m_buf;
+};
+
+TEST_F(UtCrc32Test, KnownValue)
+{
+	const byte*	check = reinterpret_cast<const byte*>("123456789");
+
+	EXPECT_EQ(0xE3069283U, ut_crc32(check, 9));
+}
+
+/* Short buffers, which go through the serial loops only. */
+TEST_F(UtCrc32Test, Short)
+{
+	for (ulint align = 0; align < 8; align++) {
+		for (ulint len = 0; len <= 3 * short_stream; len++) {
+			const byte*	p = &m_buf[align];
+			EXPECT_EQ(crc32c_serial(p, len), ut_crc32(p, len))
+				<< "length " << len << ", alignment " << align;
+		}
+	}
+}
+
+/* Lengths around the multiples of the short and long blocks, so that the
+3-way combine runs with and without a tail that is not a whole block. */
+TEST_F(UtCrc32Test, Blocks)
+{
+	for (ulint n = 3 * short_stream; n <= 3 * long_stream;
+	     n += 3 * short_stream) {
+		check_around(n);
+	}
+
+	check_around(2 * 3 * long_stream);
+	check_around(2 * 3 * long_stream + 3 * short_stream);
+}
+
+/* Page sized buffers, and the page body between the FIL_PAGE_DATA header
+of 38 bytes and the 8-byte trailer, which buf_calc_page_crc32() checksums
+separately from the header. */
+TEST_F(UtCrc32Test, Pages)
+{
+	for (ulint size = 1024; size <= 16384; size *= 2) {
+		check_around(size);
+		check_around(size - 38 - 8);
+	}
+}
+
+}  // namespace innodb_ut0crc32_unittest